@@ -0,0 +1,111 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+/**
+ * @class Clock
+ * @brief Fuente de tiempo inyectable para el ritmo de generación y las marcas de tiempo.
+ *
+ * Permite sustituir el reloj real por uno virtual para simular ejecuciones largas
+ * con la misma lógica de planificación.
+ */
+class Clock {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+    using duration = std::chrono::steady_clock::duration;
+
+    virtual ~Clock() = default;
+
+    /**
+     * @brief Instante actual según el reloj.
+     */
+    virtual time_point now() const = 0;
+
+    /**
+     * @brief Bloquea hasta que el reloj alcance `deadline`.
+     * @param deadline Instante hasta el que se espera.
+     */
+    virtual void sleepUntil(time_point deadline) = 0;
+
+    /**
+     * @brief Bloquea durante `delay` según el reloj.
+     * @param delay Tiempo de espera.
+     */
+    void sleepFor(duration delay) { sleepUntil(now() + delay); }
+
+    /**
+     * @brief Espera a que el sistema procese el trabajo pendiente antes de avanzar el tiempo.
+     *
+     * Lo llama quien marca el ritmo (el generador) antes de dormir. No tiene efecto en
+     * el reloj real.
+     */
+    virtual void settle() {}
+
+    /**
+     * @brief Indica si el reloj es virtual (el tiempo no corresponde al real).
+     */
+    virtual bool isVirtual() const { return false; }
+};
+
+/**
+ * @class SteadyClock
+ * @brief Reloj real basado en `std::chrono::steady_clock`.
+ */
+class SteadyClock : public Clock {
+public:
+    time_point now() const override;
+    void sleepUntil(time_point deadline) override;
+};
+
+/**
+ * @class VirtualClock
+ * @brief Reloj virtual cuyo tiempo solo avanza cuando algún hilo duerme en él.
+ *
+ * `sleepUntil` no bloquea: adelanta el tiempo virtual hasta el instante pedido.
+ * `settle` bloquea (en tiempo real, con un límite) hasta que el sistema esté en
+ * reposo, es decir, hasta que los consumidores hayan terminado de codificar y
+ * escribir todo fotograma aceptado; el generador lo llama antes de dormir, así cada
+ * fotograma se procesa antes de la siguiente llegada virtual. Otros hilos (p. ej. un
+ * limitador de ancho de banda) pueden dormir en el reloj sin esperar al reposo.
+ */
+class VirtualClock : public Clock {
+public:
+    /**
+     * @brief Crea un reloj virtual.
+     * @param origin Instante inicial del tiempo virtual.
+     */
+    explicit VirtualClock(time_point origin = std::chrono::steady_clock::now());
+
+    time_point now() const override;
+    void sleepUntil(time_point deadline) override;
+    void settle() override;
+    bool isVirtual() const override { return true; }
+
+    /**
+     * @brief Adelanta el tiempo virtual.
+     * @param delta Tiempo a avanzar.
+     */
+    void advance(duration delta);
+
+    /**
+     * @brief Define la espera de reposo que se hace antes de avanzar el tiempo.
+     * @param wait Función que bloquea hasta el reposo, como mucho el tiempo real indicado,
+     *        y retorna true si se alcanzó (p. ej. FrameSink::waitIdle).
+     */
+    void setIdleWait(std::function<bool(std::chrono::milliseconds)> wait);
+
+private:
+    time_point origin;                    ///< Instante correspondiente al tiempo virtual cero.
+    std::atomic<int64_t> elapsedNs{0};    ///< Tiempo virtual transcurrido en nanosegundos.
+    std::function<bool(std::chrono::milliseconds)> idleWait; ///< Espera de reposo (opcional).
+};
+
+/**
+ * @brief Reloj real compartido por defecto.
+ */
+Clock& systemClock();
+
+#endif // CLOCK_H
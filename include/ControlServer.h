@@ -0,0 +1,86 @@
+#ifndef CONTROLSERVER_H
+#define CONTROLSERVER_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+
+/**
+ * @class ControlServer
+ * @brief Canal de control local (socket Unix) con protocolo de líneas.
+ *
+ * Cada línea recibida es un comando `nombre [argumentos]` y recibe exactamente una
+ * línea de respuesta que empieza por `OK` o `ERR`. Los comandos se registran con
+ * addCommand() y se ejecutan en el hilo del servidor, sin detener el pipeline.
+ * Los clientes se atienden de uno en uno, p. ej. con `socat - UNIX-CONNECT:ruta`.
+ */
+class ControlServer {
+public:
+    /**
+     * @brief Manejador de un comando.
+     * @param args Texto que sigue al nombre del comando (sin espacios iniciales).
+     * @param reply Mensaje de respuesta (sin el prefijo OK/ERR).
+     * @return true si el comando tuvo éxito.
+     */
+    using Handler = std::function<bool(const std::string& args, std::string& reply)>;
+
+    /**
+     * @param socketPath Ruta del socket Unix a crear.
+     */
+    explicit ControlServer(const std::string& socketPath);
+    ~ControlServer();
+
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    /**
+     * @brief Registra un comando. Debe llamarse antes de start().
+     * @param name Nombre del comando.
+     * @param usage Sintaxis mostrada por `help`.
+     * @param handler Función que ejecuta el comando.
+     */
+    void addCommand(const std::string& name, const std::string& usage, Handler handler);
+
+    /**
+     * @brief Crea el socket y lanza el hilo del servidor.
+     * @return true si el socket se creó correctamente.
+     */
+    bool start();
+
+    /**
+     * @brief Detiene el servidor y elimina el socket.
+     */
+    void stop();
+
+    /**
+     * @brief Ejecuta una línea de comando y devuelve la respuesta completa.
+     * @param line Línea recibida.
+     * @return Respuesta con prefijo OK o ERR.
+     */
+    std::string dispatch(const std::string& line);
+
+private:
+    /**
+     * @brief Comando registrado.
+     */
+    struct Command {
+        std::string usage;
+        Handler handler;
+    };
+
+    void run();
+    void serveClient(int clientFd);
+
+    std::string socketPath;               ///< Ruta del socket Unix.
+    int listenFd = -1;                    ///< Descriptor del socket de escucha.
+    dev_t socketDevice = 0;               ///< Dispositivo del socket creado en start().
+    ino_t socketInode = 0;                ///< Inodo del socket creado en start().
+    std::atomic<bool> running{false};     ///< Indica si el servidor está activo.
+    std::thread thread;                   ///< Hilo del servidor.
+    std::map<std::string, Command> commands; ///< Comandos registrados.
+};
+
+#endif // CONTROLSERVER_H
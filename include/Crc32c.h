@@ -0,0 +1,20 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief CRC32C (Castagnoli) de un bloque, encadenable.
+ *
+ * Usa la instrucción `crc32` de SSE4.2 cuando la CPU la tiene y una tabla en caso
+ * contrario; ambos caminos dan el mismo resultado.
+ *
+ * @param data Bytes a procesar.
+ * @param size Número de bytes.
+ * @param crc CRC de los bloques anteriores (0 para empezar).
+ * @return CRC acumulado.
+ */
+uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+#endif // CRC32C_H
@@ -0,0 +1,185 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Clock.h"
+#include "ImageData.h"
+#include "PipelineStats.h"
+#include "Storage.h"
+
+/**
+ * @class ConsoleCapture
+ * @brief Salidas std::cout y std::cerr del proceso mientras puede haber panel.
+ *
+ * install() cambia los streambuf de std::cout y std::cerr una sola vez, antes de que
+ * arranque ningún hilo, y el destructor los devuelve cuando ya han terminado todos.
+ * Hasta que el panel arranca ambos reenvían a la consola; con el panel activo, std::cout
+ * se descarta y std::cerr se guarda por líneas. El modo es un atómico: cambiarlo no
+ * toca los streams que usan los demás hilos ni añade bloqueos a quien escribe.
+ */
+class ConsoleCapture {
+public:
+    ConsoleCapture() = default;
+    ~ConsoleCapture();
+
+    ConsoleCapture(const ConsoleCapture&) = delete;
+    ConsoleCapture& operator=(const ConsoleCapture&) = delete;
+
+    /**
+     * @brief Pone los streambuf propios en std::cout y std::cerr (reenviando a la consola).
+     */
+    void install();
+
+    /**
+     * @brief Indica si install() se llamó.
+     */
+    bool installed() const { return savedOut != nullptr; }
+
+    /**
+     * @brief Pasa de reenviar a descartar std::cout y guardar std::cerr, o al revés.
+     */
+    void setCapturing(bool capturing);
+
+    /**
+     * @brief Salida real de la terminal (el streambuf original de std::cout).
+     */
+    std::streambuf* screen() const { return savedOut; }
+
+    /**
+     * @brief Añade una línea al registro del panel si está activo, o la imprime en std::cout.
+     */
+    void log(const std::string& line);
+
+    /// Copia de las últimas líneas guardadas.
+    std::vector<std::string> lines() const { return errors.lines(); }
+
+    /// Líneas guardadas en total (incluidas las que ya no se conservan).
+    size_t total() const { return errors.total(); }
+
+private:
+    /**
+     * @brief Streambuf sin búfer propio: reenvía al original o, capturando, descarta o
+     *        guarda las líneas.
+     */
+    class Buffer : public std::streambuf {
+    public:
+        explicit Buffer(bool keepLines) : keepLines(keepLines) {}
+
+        std::streambuf* target = nullptr;    ///< Streambuf original.
+        std::atomic<bool> capturing{false};
+
+        /// Copia de las últimas líneas completas guardadas.
+        std::vector<std::string> lines() const;
+
+        /// Líneas escritas en total (incluidas las que ya no se guardan).
+        size_t total() const;
+
+        /// Guarda el texto (con el mutex de las líneas).
+        void append(const char* text, std::streamsize count);
+
+    protected:
+        int overflow(int c) override;
+        std::streamsize xsputn(const char* text, std::streamsize count) override;
+        int sync() override;
+
+    private:
+        const bool keepLines;                ///< Guarda (std::cerr) o descarta (std::cout).
+        mutable std::mutex mutex;
+        std::string pending;
+        std::deque<std::string> complete;
+        size_t count = 0;
+    };
+
+    Buffer output{false};
+    Buffer errors{true};
+    std::streambuf* savedOut = nullptr;
+    std::streambuf* savedErr = nullptr;
+};
+
+/**
+ * @class Dashboard
+ * @brief Panel ANSI que se redibuja en el sitio varias veces por segundo.
+ *
+ * Un hilo propio lee los contadores de PipelineStats, los histogramas de latencia, la
+ * cola y los volúmenes del destino, y redibuja el panel: throughput por etapa, barra
+ * de ocupación de la cola, descartes, percentiles de latencia, FPS por escritor y
+ * ancho de banda por volumen. Las tasas y percentiles son del último segundo.
+ *
+ * Mientras está activo, ConsoleCapture descarta std::cout y guarda std::cerr: las
+ * últimas líneas se muestran al pie del panel y todas se vuelcan al detenerlo. El
+ * panel ocupa la pantalla alternativa de la terminal, así que al detenerlo reaparece
+ * la consola con la configuración y los resultados finales se imprimen como siempre.
+ */
+class Dashboard {
+public:
+    /**
+     * @param console Consola instalada antes de arrancar los hilos.
+     * @param stats Contadores del pipeline.
+     * @param sink Cola o pipeline (profundidad, capacidad y descartes).
+     * @param storage Destino (volúmenes).
+     * @param clock Reloj del generador.
+     * @param runSeconds Duración de la generación.
+     */
+    Dashboard(ConsoleCapture& console, const PipelineStats& stats, FrameSink& sink, const Storage& storage,
+              Clock& clock, double runSeconds);
+    ~Dashboard();
+
+    /**
+     * @brief Toma la consola y lanza el hilo de refresco.
+     * @return false si la salida estándar no es una terminal o la consola no se instaló
+     *         (no se activa).
+     */
+    bool start();
+
+    /**
+     * @brief Dibuja el último estado, devuelve la consola y vuelca los mensajes guardados.
+     */
+    void stop();
+
+private:
+    /// Contadores acumulados en un instante.
+    struct Snapshot {
+        Clock::time_point time;
+        size_t generated = 0;
+        size_t enqueued = 0;
+        size_t saved = 0;
+        size_t dropped = 0;
+        size_t failures = 0;
+        LatencyHistogram::Counts encode{};
+        LatencyHistogram::Counts write{};
+        std::array<size_t, kMaxWriterStats> byWriter{};
+        std::vector<VolumeUsage> volumes;
+    };
+
+    void run();
+    Snapshot capture() const;
+    std::string render(const Snapshot& now, const Snapshot& before) const;
+
+    ConsoleCapture& console;
+    const PipelineStats& stats;
+    FrameSink& sink;
+    const Storage& storage;
+    Clock& clock;
+    const double runSeconds;
+    Clock::time_point origin;
+
+    std::unique_ptr<std::ostream> screen; ///< Salida real, sobre el streambuf original de std::cout.
+
+    std::deque<Snapshot> window;          ///< Instantáneas del último segundo (solo el hilo de refresco).
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    bool active = false;
+    std::thread refresher;
+};
+
+#endif // DASHBOARD_H
@@ -0,0 +1,180 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Frame.h"
+
+struct PixelKernels;
+
+#ifdef FASTCAP_HAVE_OPENCV
+/// Formato de salida por defecto.
+constexpr const char* kDefaultEncoderFormat = "bmp";
+#else
+constexpr const char* kDefaultEncoderFormat = "raw";
+#endif
+
+/**
+ * @brief Tablas Huffman de los JPEG secuenciales.
+ */
+enum class JpegHuffman : uint8_t {
+    Standard,   ///< Tablas estándar del Anexo K.3 (una pasada, TurboJPEG).
+    PerFrame,   ///< Optimizadas para cada fotograma (dos pasadas, libjpeg).
+    Cached,     ///< Optimizadas para un fotograma de muestra y reutilizadas (libjpeg).
+};
+
+/**
+ * @brief Opciones de compresión JPEG además de la calidad.
+ *
+ * Por defecto: submuestreo de los núcleos del formato (4:2:0 en color, gris en los de
+ * un canal), DCT rápida, JPEG secuencial de 8 bits con pérdida y tablas Huffman
+ * estándar, lo que usaba siempre el codificador.
+ */
+struct JpegOptions {
+    int subsampling = -1;       ///< Submuestreo TurboJPEG (TJSAMP_*); -1 = el de los núcleos.
+    bool accurateDct = false;   ///< DCT exacta en lugar de la rápida.
+    bool progressive = false;   ///< JPEG progresivo (con tablas Huffman optimizadas).
+    JpegHuffman huffman = JpegHuffman::Standard;  ///< Tablas Huffman (solo secuencial).
+    size_t huffmanRefresh = 300;  ///< Fotogramas por recálculo de las tablas en caché.
+    int precision = 8;          ///< Bits por muestra: 8, 12 o 16 (16 solo sin pérdida; TurboJPEG 3).
+    bool lossless = false;      ///< JPEG sin pérdida (TurboJPEG 3).
+};
+
+/**
+ * @brief Interpreta opciones JPEG separadas por comas, p. ej. "444,accurate,progressive".
+ *
+ * Submuestreo: "444", "422", "420" o "gray"; DCT: "fast" o "accurate"; codificación:
+ * "baseline" o "progressive"; tablas Huffman: "optimize" (por fotograma) o "cached"
+ * ("cached:N" las recalcula cada N fotogramas), incompatibles con "progressive", que ya
+ * las optimiza; precisión: "12bit" o "16bit" (este solo con "lossless"); "lossless"
+ * para JPEG sin pérdida, incompatible con "progressive" y las tablas Huffman. Las que
+ * no aparecen quedan por defecto.
+ *
+ * @param text Lista de opciones.
+ * @param options Opciones resultantes.
+ * @return true si todas las opciones son válidas.
+ */
+bool parseJpegOptions(const std::string& text, JpegOptions& options);
+
+/**
+ * @brief Opciones JPEG en la sintaxis de parseJpegOptions (solo las que no son por defecto).
+ * @return Cadena vacía si todas son por defecto.
+ */
+std::string describeJpegOptions(const JpegOptions& options);
+
+/**
+ * @brief Parámetros de configuración de los codificadores.
+ */
+struct EncoderSettings {
+    std::string format = kDefaultEncoderFormat;  ///< Formato de salida: "bmp", "jpg", "raw" o "null".
+    int quality = 90;            ///< Calidad JPEG (0-100).
+    JpegOptions jpeg;            ///< Submuestreo, DCT y codificación JPEG.
+    size_t nullSize = 0;         ///< Tamaño nominal de la salida del codificador nulo (0 = 10% del fotograma).
+    PixelFormat pixelFormat = PixelFormat::Bgr8;  ///< Formato de píxel de los fotogramas.
+    int width = 0;               ///< Ancho de los fotogramas, para elegir los núcleos de resolución fija.
+    int height = 0;              ///< Alto de los fotogramas.
+};
+
+/**
+ * @class Encoder
+ * @brief Codifica una imagen en un buffer de memoria listo para almacenarse.
+ *
+ * Cada hilo escritor usa su propia instancia, por lo que las implementaciones
+ * pueden reutilizar manejadores y buffers internos entre fotogramas.
+ */
+class Encoder {
+public:
+    virtual ~Encoder() = default;
+
+    /**
+     * @brief Codifica una imagen.
+     * @param image Imagen a codificar.
+     * @param out Buffer de salida; se reutiliza entre llamadas.
+     * @return true si la imagen se codificó correctamente.
+     */
+    virtual bool encode(const Frame& image, std::vector<unsigned char>& out) = 0;
+
+    /**
+     * @brief Extensión de archivo del formato (sin punto).
+     */
+    virtual const char* extension() const = 0;
+
+    /**
+     * @brief Cambia la calidad de compresión para los siguientes fotogramas.
+     *
+     * Los formatos sin parámetro de calidad lo ignoran.
+     *
+     * @param quality Calidad entre 1 y 100.
+     */
+    virtual void setQuality(int /*quality*/) {}
+};
+
+#ifdef FASTCAP_HAVE_OPENCV
+/**
+ * @class BmpEncoder
+ * @brief Codificador BMP sin compresión mediante OpenCV.
+ *
+ * Los fotogramas de 16 bits se guardan con sus 8 bits altos, convertidos con los núcleos del formato.
+ */
+class BmpEncoder : public Encoder {
+public:
+    /**
+     * @param kernels Núcleos del formato de los fotogramas.
+     */
+    explicit BmpEncoder(const PixelKernels& kernels);
+    bool encode(const Frame& image, std::vector<unsigned char>& out) override;
+    const char* extension() const override { return "bmp"; }
+
+private:
+    const PixelKernels& kernels;  ///< Núcleos del formato de los fotogramas.
+    Frame scratch;                ///< Entrada de 8 bits reutilizada (formatos de 16 bits).
+};
+#endif
+
+/**
+ * @class RawEncoder
+ * @brief Píxeles sin cabecera ni compresión, fila tras fila sin el relleno del stride.
+ *
+ * No necesita OpenCV; el ancho, el alto y el formato son los de la ejecución.
+ */
+class RawEncoder : public Encoder {
+public:
+    bool encode(const Frame& image, std::vector<unsigned char>& out) override;
+    const char* extension() const override { return "raw"; }
+};
+
+/**
+ * @class NullEncoder
+ * @brief Codificador nulo para simulaciones: no lee los píxeles.
+ *
+ * Entrega un buffer de tamaño nominal fijo sin procesar la imagen, de modo que las
+ * etapas posteriores ven tamaños realistas sin el coste de codificar.
+ */
+class NullEncoder : public Encoder {
+public:
+    /**
+     * @param nominalSize Bytes que ocupará cada fotograma codificado (0 = 10% del fotograma).
+     */
+    explicit NullEncoder(size_t nominalSize);
+    bool encode(const Frame& image, std::vector<unsigned char>& out) override;
+    const char* extension() const override { return "bin"; }
+
+private:
+    size_t nominalSize;  ///< Tamaño fijo de salida en bytes.
+};
+
+/**
+ * @brief Indica si un formato de salida es soportado.
+ * @param format Nombre del formato.
+ */
+bool isValidEncoderFormat(const std::string& format);
+
+/**
+ * @brief Crea un codificador según la configuración.
+ * @param settings Parámetros del codificador.
+ * @return Codificador creado, o nullptr si no pudo inicializarse.
+ */
+std::unique_ptr<Encoder> createEncoder(const EncoderSettings& settings);
+
+#endif // ENCODER_H
@@ -0,0 +1,76 @@
+#ifndef ERASURECODE_H
+#define ERASURECODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ErasureCode
+ * @brief Código Reed-Solomon sistemático K+M sobre GF(2^8) con matriz de Cauchy.
+ *
+ * Los K fragmentos de datos se guardan tal cual y los M de paridad son combinaciones
+ * lineales de ellos; cualquier subconjunto de K fragmentos permite reconstruir el resto.
+ * El cuerpo usa el polinomio 0x11B, el mismo que la instrucción GFNI `gf2p8mulb`, así
+ * que los núcleos escalar, PSHUFB (SSSE3/AVX2) y GFNI producen resultados idénticos.
+ * El núcleo se elige una vez, al primer uso, según la CPU.
+ */
+class ErasureCode {
+public:
+    /**
+     * @param dataShards Fragmentos de datos (K).
+     * @param parityShards Fragmentos de paridad (M).
+     */
+    ErasureCode(int dataShards, int parityShards);
+
+    /**
+     * @brief Interpreta una especificación "K+M", p. ej. "4+2".
+     * @return true si es válida (K, M >= 1 y K + M <= 255).
+     */
+    static bool parseSpec(const std::string& text, int& dataShards, int& parityShards);
+
+    /**
+     * @brief Calcula los fragmentos de paridad.
+     * @param data K punteros a fragmentos de datos de `size` bytes.
+     * @param parity M punteros a fragmentos de paridad de `size` bytes (se sobrescriben).
+     * @param size Bytes por fragmento.
+     */
+    void encode(const unsigned char* const* data, unsigned char* const* parity, size_t size) const;
+
+    /**
+     * @brief Reconstruye los fragmentos que faltan a partir de los presentes.
+     * @param shards K+M punteros; los de fragmentos perdidos deben apuntar a memoria de
+     *        `size` bytes donde se escribirá el resultado.
+     * @param present K+M indicadores de fragmento disponible.
+     * @param size Bytes por fragmento.
+     * @return false si hay menos de K fragmentos disponibles.
+     */
+    bool reconstruct(unsigned char* const* shards, const std::vector<bool>& present, size_t size) const;
+
+    int dataShards() const { return k; }
+    int parityShards() const { return m; }
+
+    /**
+     * @brief Nombre del núcleo vectorial en uso ("gfni", "avx2", "ssse3" o "escalar").
+     */
+    static const char* kernelName();
+
+    /**
+     * @brief Núcleos que admite la CPU, del más rápido al más lento.
+     */
+    static std::vector<std::string> availableKernels();
+
+    /**
+     * @brief Fuerza un núcleo concreto (para comparativas).
+     * @return false si el nombre no existe o la CPU no lo admite.
+     */
+    static bool selectKernel(const std::string& name);
+
+private:
+    int k;                                ///< Fragmentos de datos.
+    int m;                                ///< Fragmentos de paridad.
+    std::vector<uint8_t> matrix;          ///< Matriz de paridad M x K (Cauchy).
+};
+
+#endif // ERASURECODE_H
@@ -0,0 +1,248 @@
+#ifndef ERASURESTORAGE_H
+#define ERASURESTORAGE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ErasureCode.h"
+#include "Storage.h"
+
+/**
+ * @brief Fotograma dentro de una franja.
+ */
+struct StripeEntry {
+    std::string name;   ///< Nombre del fotograma.
+    size_t offset = 0;  ///< Posición en la franja.
+    size_t size = 0;    ///< Tamaño en bytes.
+};
+
+/**
+ * @brief Índice de una franja: geometría del código y fotogramas que contiene.
+ */
+struct StripeIndex {
+    int dataShards = 0;           ///< K.
+    int parityShards = 0;         ///< M.
+    size_t shardSize = 0;         ///< Bytes por fragmento (la franja se rellena con ceros).
+    size_t totalBytes = 0;        ///< Bytes útiles de la franja.
+    std::vector<StripeEntry> entries;
+
+    /**
+     * @brief Guarda el índice en texto con temporal + fsync + rename.
+     *
+     * Un corte a mitad deja el índice anterior (o ninguno), nunca uno a medias.
+     *
+     * @return true si se escribió completo y quedó sincronizado.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Lee un índice guardado con save().
+     * @return false si no existe o está incompleto.
+     */
+    bool load(const std::string& path);
+};
+
+/**
+ * @brief Ruta de un fragmento o del índice de una franja.
+ * @param volume Directorio del volumen.
+ * @param stripe Número de franja.
+ * @param shard Índice del fragmento, o -1 para el índice.
+ */
+std::string stripePath(const std::string& volume, uint64_t stripe, int shard);
+
+/**
+ * @class ErasureStorage
+ * @brief Segmentos con código de borrado repartidos en K volúmenes de datos y M de paridad.
+ *
+ * Los fotogramas se acumulan en una franja (*stripe*) en memoria. Al llenarse (o con
+ * rollover) la franja pasa a la etapa de paridad, que la divide en K fragmentos y
+ * calcula M fragmentos de paridad. Cada volumen tiene un hilo escritor permanente que
+ * recibe de la etapa de paridad su fragmento de cada franja, así que el cálculo de una
+ * franja se solapa con la escritura de la anterior:
+ *
+ * - `stripe_NNNNNNNN.sII`: fragmento II de la franja, sincronizado con fsync.
+ * - `stripe_NNNNNNNN.idx`: índice de la franja (igual en todos los volúmenes) con la
+ *   geometría y la posición de cada fotograma; se escribe cuando todos los fragmentos
+ *   están sincronizados, así que un índice presente garantiza fragmentos completos.
+ *
+ * Con cualquier K volúmenes se recuperan todos los fotogramas (ver fastcap_reconstruct).
+ */
+class ErasureStorage : public Storage {
+public:
+    /**
+     * @param volumes K+M directorios (deben existir), primero los de datos.
+     * @param dataShards Volúmenes de datos (K).
+     * @param parityShards Volúmenes de paridad (M).
+     * @param stripeSize Bytes de fotogramas por franja.
+     */
+    ErasureStorage(const std::vector<std::string>& volumes, int dataShards, int parityShards, size_t stripeSize);
+    ~ErasureStorage() override;
+
+    ErasureStorage(const ErasureStorage&) = delete;
+    ErasureStorage& operator=(const ErasureStorage&) = delete;
+
+    /**
+     * @brief Añade el fotograma a la franja abierta.
+     *
+     * Espera si la etapa de paridad acumula demasiadas franjas cerradas.
+     */
+    bool write(const std::string& name, const std::vector<unsigned char>& data) override;
+    std::string describe() const override;
+
+    /**
+     * @brief Cierra la franja abierta y la envía a la etapa de paridad.
+     */
+    bool rollover() override;
+
+    /**
+     * @brief Continúa tras la mayor secuencia de los índices de franja existentes.
+     *
+     * Las franjas sin índice en ningún volumen quedaron a medio escribir y no cuentan.
+     */
+    bool recover(uint64_t& nextSequence) override;
+
+    /**
+     * @brief Cierra la franja abierta, espera a que se escriba todo y detiene la etapa.
+     */
+    void drain();
+
+    /**
+     * @brief Fija la tasa de fotogramas configurada, con la que report() compara el throughput.
+     * @param framesPerSecond Tasa máxima del perfil de carga.
+     */
+    void setTargetRate(double framesPerSecond);
+
+    /**
+     * @brief Informe de franjas, bytes y throughput del cálculo de paridad.
+     *
+     * Con setTargetRate() avisa si la paridad o la escritura no alcanzan la tasa configurada
+     * por el tamaño medio de fotograma.
+     */
+    std::string report() const;
+
+    /**
+     * @brief Bytes escritos con éxito en cada volumen: un fragmento (datos o paridad) por franja.
+     */
+    std::vector<VolumeUsage> volumeUsage() const override;
+
+private:
+    /**
+     * @brief Franja de fotogramas pendiente de codificar.
+     */
+    struct Stripe {
+        uint64_t number = 0;
+        std::vector<unsigned char> bytes;
+        std::vector<StripeEntry> entries;
+    };
+
+    /**
+     * @brief Franja codificada cuyos fragmentos e índices se están escribiendo.
+     */
+    struct EncodedStripe {
+        uint64_t number = 0;
+        std::vector<unsigned char> bytes;           ///< K+M fragmentos contiguos.
+        StripeIndex index;
+        std::vector<char> shardOk;                  ///< Fragmento escrito y sincronizado, por volumen.
+        std::atomic<int> shardsLeft{0};             ///< Fragmentos pendientes.
+        std::atomic<int> indexesLeft{0};            ///< Índices pendientes.
+        std::atomic<bool> indexFailed{false};       ///< Algún índice no pudo escribirse.
+    };
+
+    /**
+     * @brief Tarea de un escritor de volumen: el fragmento o el índice de una franja.
+     */
+    struct VolumeTask {
+        std::shared_ptr<EncodedStripe> stripe;
+        bool index = false;
+    };
+
+    /**
+     * @brief Hilo escritor permanente de un volumen y su cola de tareas.
+     */
+    struct VolumeWriter {
+        std::mutex mutex;                    ///< Protege la cola.
+        std::condition_variable ready;       ///< Avisa de tareas nuevas.
+        std::deque<VolumeTask> tasks;        ///< Tareas en orden de llegada.
+        bool stopping = false;
+        std::thread thread;
+        std::atomic<size_t> bytes{0};        ///< Bytes de fragmento escritos con éxito.
+    };
+
+    /**
+     * @brief Cierra la franja abierta (con el mutex tomado).
+     */
+    void closeStripeLocked();
+
+    /**
+     * @brief Bucle de la etapa de paridad: codifica y entrega los fragmentos a los volúmenes.
+     */
+    void parityLoop();
+
+    /**
+     * @brief Divide la franja en K fragmentos y calcula los M de paridad.
+     */
+    std::shared_ptr<EncodedStripe> encodeStripe(Stripe& stripe);
+
+    /**
+     * @brief Bucle del escritor del volumen `volume`.
+     */
+    void volumeLoop(int volume);
+
+    /**
+     * @brief Añade una tarea a la cola de un volumen.
+     */
+    void submit(int volume, VolumeTask task);
+
+    /**
+     * @brief Tras el último fragmento: escribe los índices o da la franja por perdida.
+     */
+    void commitStripe(const std::shared_ptr<EncodedStripe>& stripe);
+
+    /**
+     * @brief Cuenta la franja terminada y deja hueco a la etapa de paridad.
+     */
+    void finishStripe(const EncodedStripe& stripe);
+
+    std::vector<std::string> volumes;     ///< Directorios, primero los K de datos.
+    std::vector<std::unique_ptr<VolumeWriter>> writers; ///< Un escritor por volumen.
+    ErasureCode code;                     ///< Código K+M.
+    size_t stripeSize;                    ///< Bytes de fotogramas por franja.
+
+    mutable std::mutex mutex;             ///< Protege la franja abierta y la cola.
+    std::condition_variable stripeReady;  ///< Avisa a la etapa de paridad.
+    std::condition_variable stripeDone;   ///< Avisa a los escritores de que hay hueco.
+    Stripe open;                          ///< Franja en construcción.
+    std::deque<Stripe> closed;            ///< Franjas pendientes de codificar.
+    uint64_t nextStripe = 0;              ///< Número de la siguiente franja.
+    bool stopping = false;
+    std::thread parityThread;             ///< Etapa de paridad.
+    std::condition_variable stripeWritten; ///< Avisa a la etapa de paridad de que una franja terminó.
+    size_t writingStripes = 0;            ///< Franjas entregadas a los volúmenes sin terminar.
+    std::chrono::steady_clock::time_point busySince; ///< Desde cuándo hay franjas escribiéndose.
+
+    std::atomic<size_t> stripesWritten{0};   ///< Franjas escritas completas.
+    std::atomic<size_t> stripeFailures{0};   ///< Franjas con algún volumen fallido.
+    std::atomic<size_t> stripesLost{0};      ///< Franjas con menos de K fragmentos escritos.
+    std::atomic<size_t> dataBytes{0};        ///< Bytes de fotogramas codificados.
+    std::atomic<size_t> parityBytes{0};      ///< Bytes de paridad generados.
+    std::atomic<size_t> frames{0};           ///< Fotogramas codificados.
+    std::atomic<int64_t> parityNs{0};        ///< Tiempo en el cálculo de paridad.
+    std::atomic<int64_t> writeNs{0};         ///< Tiempo con alguna franja escribiéndose en los volúmenes.
+    std::atomic<double> targetRate{0.0};     ///< Tasa configurada en FPS (0 = sin comparar).
+};
+
+/**
+ * @brief Interpreta una lista de directorios separados por comas.
+ * @param text Lista, p. ej. "/mnt/a,/mnt/b".
+ * @return Directorios en orden.
+ */
+std::vector<std::string> splitVolumeList(const std::string& text);
+
+#endif // ERASURESTORAGE_H
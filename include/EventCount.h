@@ -0,0 +1,134 @@
+#ifndef EVENTCOUNT_H
+#define EVENTCOUNT_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Contadores de un EventCount.
+ */
+struct EventCountStats {
+    uint64_t notifies = 0;        ///< Llamadas a notify con algún hilo esperando.
+    uint64_t skippedNotifies = 0; ///< Notificaciones sin nadie esperando (sin syscall ni escritura compartida).
+    uint64_t wakeSyscalls = 0;    ///< Llamadas a FUTEX_WAKE.
+    uint64_t waitSyscalls = 0;    ///< Llamadas a FUTEX_WAIT.
+    uint64_t spinWakeups = 0;     ///< Esperas resueltas durante el giro, sin dormir.
+    uint64_t parkedWakeups = 0;   ///< Esperas que durmieron en el futex.
+    int64_t wakeLatencyNs = 0;    ///< Suma de latencias de despertar (notify → hilo en marcha) de las dormidas.
+    int64_t maxWakeLatencyNs = 0; ///< Mayor latencia de despertar.
+    int64_t spinLatencyNs = 0;    ///< Suma de latencias (notify → hilo en marcha) de las resueltas girando.
+    int64_t spinNs = 0;           ///< Tiempo total girando.
+    int64_t parkedNs = 0;         ///< Tiempo total dormido en el futex.
+
+    EventCountStats& operator+=(const EventCountStats& other);
+};
+
+/**
+ * @brief Giro de un EventCount antes de dormir.
+ *
+ * Con `adaptive`, el giro se ajusta a la espera típica observada: si las esperas
+ * suelen resolverse dentro de `budgetNs` se gira el doble de la espera típica (hasta
+ * `budgetNs`); si suelen ser más largas, girar no sirve y se gira solo lo mínimo.
+ */
+struct SpinPolicy {
+    int64_t budgetNs = 2000;  ///< Giro máximo antes de dormir, en nanosegundos (0 duerme directamente).
+    bool adaptive = false;    ///< Ajusta el giro a la espera típica.
+};
+
+/**
+ * @class EventCount
+ * @brief Primitiva de espera sobre un futex que solo hace syscalls cuando alguien duerme.
+ *
+ * Sustituye a una variable de condición para esperar a que se cumpla una condición
+ * comprobada fuera de la primitiva (p. ej. cola no vacía):
+ *
+ * @code
+ * while (!condicion()) {
+ *     auto key = ec.prepareWait();
+ *     if (condicion()) { ec.cancelWait(); break; }
+ *     ec.wait(key);
+ * }
+ * // Quien hace verdadera la condición llama a ec.notifyOne() o ec.notifyAll().
+ * @endcode
+ *
+ * notify solo escribe en la memoria compartida si hay hilos registrados, y solo hace
+ * FUTEX_WAKE si alguno llegó a dormir; wait gira (con `pause`) según su SpinPolicy antes
+ * de dormir. La condición debe publicarse antes de notify (p. ej. al soltar un mutex).
+ */
+class EventCount {
+public:
+    using Key = uint32_t;
+
+    /**
+     * @brief Registra al hilo como esperando; luego debe volver a comprobar la condición.
+     * @return Clave para wait().
+     */
+    Key prepareWait();
+
+    /**
+     * @brief Anula un prepareWait() porque la condición ya se cumple.
+     */
+    void cancelWait();
+
+    /**
+     * @brief Espera a una notificación posterior a prepareWait().
+     * @param key Clave devuelta por prepareWait().
+     */
+    void wait(Key key);
+
+    /**
+     * @brief Despierta a un hilo en espera, si hay alguno.
+     */
+    void notifyOne();
+
+    /**
+     * @brief Despierta a todos los hilos en espera.
+     */
+    void notifyAll();
+
+    /**
+     * @brief Cambia el giro antes de dormir; se aplica desde la siguiente espera.
+     */
+    void setSpin(const SpinPolicy& policy);
+
+    /**
+     * @brief Giro que se aplicará en la siguiente espera, en nanosegundos.
+     */
+    int64_t spinBudgetNs() const;
+
+    /**
+     * @brief Copia de los contadores.
+     */
+    EventCountStats stats() const;
+
+private:
+    void notify(int count);
+    void recordWait(int64_t waitedNs);
+
+    std::atomic<uint32_t> epoch{0};        ///< Palabra del futex; avanza en cada notificación.
+    std::atomic<uint32_t> waiters{0};      ///< Hilos entre prepareWait y el fin de wait.
+    std::atomic<uint32_t> sleepers{0};     ///< Hilos que van a dormir o duermen en el futex.
+    std::atomic<int64_t> spinBudget{2000}; ///< Giro máximo antes de dormir (ns).
+    std::atomic<bool> adaptiveSpin{false}; ///< Ajuste del giro a la espera típica.
+    std::atomic<int64_t> typicalWaitNs{0}; ///< Media móvil de la duración de las esperas.
+    std::atomic<int64_t> lastNotifyNs{0};  ///< Instante de la última notificación con durmientes.
+
+    std::atomic<uint64_t> notifies{0};
+    std::atomic<uint64_t> skippedNotifies{0};
+    std::atomic<uint64_t> wakeSyscalls{0};
+    std::atomic<uint64_t> waitSyscalls{0};
+    std::atomic<uint64_t> spinWakeups{0};
+    std::atomic<uint64_t> parkedWakeups{0};
+    std::atomic<int64_t> wakeLatencyNs{0};
+    std::atomic<int64_t> maxWakeLatencyNs{0};
+    std::atomic<int64_t> spinLatencyNs{0};
+    std::atomic<int64_t> spinNs{0};
+    std::atomic<int64_t> parkedNs{0};
+};
+
+/**
+ * @brief Pausa breve dentro de un bucle de espera activa (`pause` en x86).
+ */
+void cpuRelax();
+
+#endif // EVENTCOUNT_H
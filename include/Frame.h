@@ -0,0 +1,186 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef FASTCAP_HAVE_OPENCV
+#include <opencv2/core.hpp>
+#endif
+
+/**
+ * @brief Formato de los píxeles de un fotograma.
+ */
+enum class PixelFormat : uint8_t {
+    Bgr8,    ///< BGR de 8 bits por canal (CV_8UC3).
+    Bgra8,   ///< BGRA de 8 bits por canal (CV_8UC4).
+    Gray8,   ///< Gris de 8 bits (CV_8UC1).
+    Gray16,  ///< Gris de 16 bits (CV_16UC1).
+};
+
+/**
+ * @brief Canales por píxel de un formato.
+ */
+int pixelChannels(PixelFormat format);
+
+/**
+ * @brief Bytes por píxel de un formato.
+ */
+int pixelBytes(PixelFormat format);
+
+/**
+ * @brief Interpreta un formato de píxel: "bgr", "bgra", "gray" o "gray16".
+ * @param text Nombre del formato.
+ * @param format Formato resultante.
+ * @return true si el nombre es válido.
+ */
+bool parsePixelFormat(const std::string& text, PixelFormat& format);
+
+/**
+ * @brief Nombre del formato de píxel ("bgr", "bgra", "gray" o "gray16").
+ */
+const char* pixelFormatName(PixelFormat format);
+
+/**
+ * @class Frame
+ * @brief Vista ligera de un fotograma: puntero, stride, dimensiones, formato y dueño de la memoria.
+ *
+ * Es lo que circula por la cola, los escritores y los codificadores. La memoria se
+ * comparte por recuento de referencias como en cv::Mat: copiar un Frame no copia los
+ * píxeles, y el bloque se libera (o vuelve a su FramePool) con la última copia.
+ */
+class Frame {
+public:
+    Frame() = default;
+
+    /**
+     * @brief Reserva un fotograma continuo en el heap, fuera de cualquier pool.
+     */
+    static Frame allocate(int width, int height, PixelFormat format);
+
+    /**
+     * @brief Envuelve memoria externa sin copiarla.
+     * @param owner Mantiene viva la memoria mientras exista alguna copia del Frame.
+     */
+    static Frame wrap(void* data, int width, int height, size_t stride, PixelFormat format,
+                      std::shared_ptr<void> owner);
+
+    /**
+     * @brief Reserva de nuevo solo si cambian las dimensiones o el formato (como cv::Mat::create).
+     */
+    void create(int width, int height, PixelFormat format);
+
+    bool empty() const { return pixels == nullptr; }
+    int width() const { return cols; }
+    int height() const { return rows; }
+    size_t stride() const { return rowBytes; }
+    PixelFormat format() const { return pixelFormat; }
+
+    /**
+     * @brief Bytes de píxeles de una fila (sin el relleno del stride).
+     */
+    size_t rowSize() const { return static_cast<size_t>(cols) * pixelBytes(pixelFormat); }
+
+    /**
+     * @brief Indica si las filas están contiguas en memoria (stride igual al tamaño de fila).
+     */
+    bool isContinuous() const { return rowBytes == rowSize(); }
+
+    uint8_t* data() { return pixels; }
+    const uint8_t* data() const { return pixels; }
+
+    template <typename T = uint8_t>
+    T* row(int y) { return reinterpret_cast<T*>(pixels + rowBytes * y); }
+
+    template <typename T = uint8_t>
+    const T* row(int y) const { return reinterpret_cast<const T*>(pixels + rowBytes * y); }
+
+private:
+    friend class FramePool;
+
+    std::shared_ptr<void> owner;                  ///< Dueño de la memoria (bloque del pool, heap o externo).
+    uint8_t* pixels = nullptr;                    ///< Primer píxel.
+    int cols = 0;                                 ///< Ancho en píxeles.
+    int rows = 0;                                 ///< Alto en píxeles.
+    size_t rowBytes = 0;                          ///< Stride en bytes.
+    PixelFormat pixelFormat = PixelFormat::Bgr8;  ///< Formato de los píxeles.
+};
+
+/**
+ * @class FramePool
+ * @brief Bloques de fotograma reutilizables de un tamaño y formato fijos.
+ *
+ * acquire() entrega un Frame cuyo dueño devuelve el bloque al pool al soltarse la
+ * última copia, desde cualquier hilo. Los bloques liberados se conservan, de modo que
+ * la memoria queda en el máximo de fotogramas en curso y no hay reservas (ni fallos de
+ * página de bloques recién mapeados) por fotograma. Los bloques se alinean a 64 bytes.
+ */
+class FramePool {
+public:
+    FramePool(int width, int height, PixelFormat format);
+
+    /**
+     * @brief Toma un bloque libre o reserva uno nuevo. El contenido no se inicializa.
+     */
+    Frame acquire();
+
+    /**
+     * @brief Reserva un bloque, toca todas sus páginas y lo deja libre.
+     *
+     * Se puede llamar desde otros hilos mientras se entregan fotogramas: así los
+     * primeros acquire() no pagan los fallos de página de un bloque recién mapeado.
+     * @return false si no se pudo reservar.
+     */
+    bool prefault();
+
+    /**
+     * @brief Bloques reservados desde la creación del pool.
+     */
+    size_t allocated() const;
+
+    /**
+     * @brief Entregas servidas con un bloque reutilizado.
+     */
+    size_t reused() const;
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::vector<uint8_t*> free;  ///< Bloques devueltos.
+        size_t allocated = 0;
+        size_t reused = 0;
+        ~State();
+    };
+
+    const int width;
+    const int height;
+    const PixelFormat format;
+    std::shared_ptr<State> state;  ///< Compartido con los dueños de los bloques entregados.
+};
+
+#ifdef FASTCAP_HAVE_OPENCV
+/**
+ * @brief Tipo OpenCV de un formato de píxel.
+ */
+int toCvType(PixelFormat format);
+
+/**
+ * @brief Cabecera cv::Mat sobre los píxeles de `frame`, sin copia ni propiedad.
+ *
+ * Solo para los bordes que necesitan OpenCV (BMP, cv::randu): `frame` debe seguir vivo
+ * mientras se use el resultado.
+ */
+cv::Mat toMat(const Frame& frame);
+
+/**
+ * @brief Frame que comparte la memoria (y el recuento de referencias) de `image`.
+ * @return Frame vacío si el tipo de `image` no tiene PixelFormat.
+ */
+Frame fromMat(const cv::Mat& image);
+#endif
+
+#endif // FRAME_H
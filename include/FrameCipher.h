@@ -0,0 +1,163 @@
+#ifndef FRAMECIPHER_H
+#define FRAMECIPHER_H
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class CipherIndex;
+
+/// Bytes del nonce AEAD: 4 de sal por ejecución + 8 del número de secuencia.
+constexpr size_t kCipherNonceSize = 12;
+/// Bytes de la etiqueta de autenticación que se añade al final de cada fotograma.
+constexpr size_t kCipherTagSize = 16;
+
+using CipherNonce = std::array<unsigned char, kCipherNonceSize>;
+
+/**
+ * @brief Configuración del cifrado en reposo.
+ */
+struct CipherSettings {
+    bool enabled = false;                       ///< Cifrar los fotogramas codificados.
+    std::string algorithm = "aes-256-gcm";      ///< "aes-256-gcm" o "chacha20-poly1305".
+    std::array<unsigned char, 32> key{};        ///< Clave de 256 bits.
+    uint32_t salt = 0;                          ///< Sal aleatoria de la ejecución (prefijo del nonce).
+    CipherIndex* index = nullptr;               ///< Índice de nonces compartido (opcional).
+};
+
+/**
+ * @brief Lee una clave de 32 bytes, en binario o como 64 dígitos hexadecimales.
+ * @param path Archivo de clave.
+ * @param key Clave leída.
+ * @return true si el archivo contiene una clave válida.
+ */
+bool loadCipherKey(const std::string& path, std::array<unsigned char, 32>& key);
+
+/**
+ * @brief Nonce de un fotograma: sal de la ejecución seguida del número de secuencia.
+ */
+CipherNonce makeCipherNonce(uint32_t salt, uint64_t sequence);
+
+/**
+ * @brief Identificador público de una clave: los 8 primeros bytes de su SHA-256 en hexadecimal.
+ *
+ * Permite comprobar con qué clave se grabó un índice sin guardar la clave.
+ * @return Cadena vacía si el programa se compiló sin OpenSSL.
+ */
+std::string cipherKeyId(const std::array<unsigned char, 32>& key);
+
+/**
+ * @brief Representación hexadecimal de un nonce (y su inversa).
+ */
+std::string nonceToHex(const CipherNonce& nonce);
+bool nonceFromHex(const std::string& text, CipherNonce& nonce);
+
+/**
+ * @class FrameCipher
+ * @brief Cifrado autenticado (AEAD) de fotogramas codificados, en el propio buffer.
+ *
+ * El texto cifrado ocupa el lugar del original y la etiqueta de 16 bytes se añade al
+ * final. El nombre del archivo se autentica como dato asociado, de modo que un archivo
+ * renombrado o intercambiado no verifica. Usa OpenSSL EVP, que aprovecha AES-NI/VAES
+ * cuando la CPU lo admite. Cada hilo escritor usa su propia instancia.
+ */
+class FrameCipher {
+public:
+    /**
+     * @param settings Algoritmo y clave.
+     */
+    explicit FrameCipher(const CipherSettings& settings);
+    ~FrameCipher();
+
+    FrameCipher(const FrameCipher&) = delete;
+    FrameCipher& operator=(const FrameCipher&) = delete;
+
+    /**
+     * @brief Indica si el contexto se inicializó correctamente.
+     */
+    bool isValid() const { return context != nullptr; }
+
+    /**
+     * @brief Cifra el buffer en su sitio y añade la etiqueta.
+     * @param buffer Fotograma codificado; al retornar contiene cifrado + etiqueta.
+     * @param nonce Nonce único para esta clave.
+     * @param name Nombre del archivo (dato asociado autenticado).
+     * @return true si se cifró correctamente.
+     */
+    bool encrypt(std::vector<unsigned char>& buffer, const CipherNonce& nonce, const std::string& name);
+
+    /**
+     * @brief Verifica la etiqueta y descifra en su sitio.
+     * @param buffer Cifrado + etiqueta; al retornar contiene el fotograma original.
+     * @param nonce Nonce usado al cifrar.
+     * @param name Nombre del archivo usado al cifrar.
+     * @return false si la etiqueta no verifica (datos o nombre alterados, clave errónea).
+     */
+    bool decrypt(std::vector<unsigned char>& buffer, const CipherNonce& nonce, const std::string& name);
+
+    /**
+     * @brief Indica si el programa se compiló con soporte de cifrado.
+     */
+    static bool available();
+
+    /**
+     * @brief Indica si el algoritmo es conocido.
+     */
+    static bool isValidAlgorithm(const std::string& algorithm);
+
+    /**
+     * @brief Aceleración por hardware detectada para el algoritmo.
+     */
+    static std::string acceleration(const std::string& algorithm);
+
+private:
+    void* context = nullptr;     ///< EVP_CIPHER_CTX (opaco para no exponer OpenSSL).
+    bool decrypting = false;     ///< Dirección con la que se inicializó el contexto.
+    CipherSettings settings;
+};
+
+/**
+ * @class CipherIndex
+ * @brief Índice de nonces: una cabecera por ejecución y una línea por fotograma cifrado.
+ *
+ * Cada ejecución empieza con "run sal idclave algoritmo" y sigue con una línea
+ * "nombre nonce tamaño" por fotograma. Se abre en modo añadir, así que varias
+ * ejecuciones pueden compartir el mismo índice (la sal distingue los nonces de cada
+ * una). La sal solo se guarda aquí, así que cada línea se vuelca al escribirla y la
+ * cabecera se sincroniza con fsync.
+ */
+class CipherIndex {
+public:
+    /**
+     * @brief Abre (o crea) el índice y escribe la cabecera de la ejecución.
+     * @param path Ruta del archivo de índice.
+     * @param settings Sal, clave (solo su identificador) y algoritmo de la ejecución.
+     * @return true si se pudo abrir y la cabecera quedó en disco.
+     */
+    bool open(const std::string& path, const CipherSettings& settings);
+
+    /**
+     * @brief Registra el nonce de un fotograma cifrado y vuelca la línea.
+     */
+    void record(const std::string& name, const CipherNonce& nonce, size_t size);
+
+    /**
+     * @brief Sincroniza, vuelca y cierra el índice.
+     */
+    void close();
+
+    ~CipherIndex() { close(); }
+
+    const std::string& path() const { return filePath; }
+
+private:
+    std::mutex mutex;
+    FILE* file = nullptr;
+    std::string filePath;
+};
+
+#endif // FRAMECIPHER_H
@@ -0,0 +1,119 @@
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Frame.h"
+#include "PixelKernels.h"
+
+/**
+ * @class FrameSource
+ * @brief Origen de los fotogramas que produce el hilo generador.
+ */
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    /**
+     * @brief Obtiene el siguiente fotograma.
+     * @return Imagen a encolar. Puede compartir memoria con fotogramas anteriores.
+     */
+    virtual Frame next() = 0;
+
+    /**
+     * @brief Descripción legible del origen.
+     */
+    virtual std::string describe() const = 0;
+
+    /**
+     * @brief Indica si terminó la preparación en segundo plano (banco completo, bloques pre-cargados).
+     *
+     * next() se puede llamar antes: el generador arranca sin esperar a la preparación.
+     */
+    virtual bool ready() const { return true; }
+};
+
+/**
+ * @class NoiseFrameSource
+ * @brief Genera un fotograma nuevo de ruido aleatorio en cada llamada.
+ *
+ * Los fotogramas salen de un FramePool: cuando los escritores sueltan uno, su bloque se
+ * reutiliza para un fotograma posterior en lugar de reservar (y liberar) uno por fotograma.
+ * Los primeros bloques se reservan y se tocan en segundo plano, repartidos entre varios
+ * hilos, mientras el generador ya entrega fotogramas.
+ */
+class NoiseFrameSource : public FrameSource {
+public:
+    /**
+     * @param width Ancho de las imágenes.
+     * @param height Alto de las imágenes.
+     * @param kernels Núcleos del formato de píxel, con los que se rellena cada fotograma.
+     * @param prefaultBlocks Bloques del pool que se pre-cargan en segundo plano.
+     */
+    NoiseFrameSource(int width, int height, const PixelKernels& kernels, size_t prefaultBlocks = 0);
+    ~NoiseFrameSource() override;
+    Frame next() override;
+    std::string describe() const override;
+    bool ready() const override;
+
+private:
+    const PixelKernels& kernels;            ///< Núcleos del formato de píxel.
+    FramePool pool;                         ///< Bloques de los fotogramas en curso y libres.
+    NoiseState noise;                       ///< Estado del generador de ruido de este origen.
+    const size_t prefaultBlocks;            ///< Bloques a pre-cargar.
+    std::atomic<size_t> prefaultClaimed{0}; ///< Bloques asignados a algún hilo de preparación.
+    std::atomic<size_t> prefaultDone{0};    ///< Bloques ya pre-cargados (o fallidos).
+    std::vector<std::thread> warmup;        ///< Hilos de preparación.
+};
+
+/**
+ * @class FrameBankSource
+ * @brief Banco de fotogramas pregenerados que se entregan de forma cíclica.
+ *
+ * Los fotogramas se generan una sola vez y después se comparten (sin copia) entre todas
+ * las entregas, por lo que el coste de generación es prácticamente nulo. El constructor
+ * solo genera el primero; el resto se reserva y se rellena en segundo plano, repartido
+ * entre varios hilos, y next() recorre los que ya están completos.
+ */
+class FrameBankSource : public FrameSource {
+public:
+    /**
+     * @brief Crea el banco generando `count` imágenes de ruido.
+     * @param width Ancho de las imágenes.
+     * @param height Alto de las imágenes.
+     * @param count Número de fotogramas distintos del banco.
+     * @param kernels Núcleos del formato de píxel.
+     */
+    FrameBankSource(int width, int height, size_t count, const PixelKernels& kernels);
+    ~FrameBankSource() override;
+    Frame next() override;
+    std::string describe() const override;
+    bool ready() const override;
+
+private:
+    std::vector<Frame> frames;                   ///< Fotogramas pregenerados.
+    std::unique_ptr<std::atomic<bool>[]> filled; ///< Fotogramas ya generados.
+    std::atomic<size_t> nextToFill{1};           ///< Siguiente fotograma sin asignar a un hilo.
+    std::atomic<size_t> filledCount{1};          ///< Fotogramas generados.
+    size_t available = 1;                        ///< Prefijo de `frames` completo (solo el generador).
+    size_t cursor = 0;                           ///< Índice del siguiente fotograma a entregar.
+    std::vector<std::thread> warmup;             ///< Hilos de preparación.
+};
+
+/**
+ * @brief Crea el origen de fotogramas adecuado.
+ * @param width Ancho de las imágenes.
+ * @param height Alto de las imágenes.
+ * @param bankSize Tamaño del banco de fotogramas; 0 genera ruido nuevo en cada fotograma.
+ * @param pixelFormat Formato de píxel de los fotogramas.
+ * @param prefaultBlocks Bloques del pool de ruido que se pre-cargan en segundo plano (sin banco).
+ * @return Origen de fotogramas, o nullptr si el formato no está soportado.
+ */
+std::unique_ptr<FrameSource> createFrameSource(int width, int height, size_t bankSize,
+                                               PixelFormat pixelFormat = PixelFormat::Bgr8,
+                                               size_t prefaultBlocks = 0);
+
+#endif // FRAMESOURCE_H
@@ -1,16 +1,62 @@
 #ifndef IMAGEDATA_H
 #define IMAGEDATA_H
 
-#include <opencv2/core.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.h"
 
 /**
- * @brief Estructura para almacenar una imagen y su número de secuencia
+ * @brief Estructura para almacenar una imagen, su número de secuencia y su instante de captura
  */
 struct ImageData {
-    cv::Mat image;
+    Frame image;
     size_t sequenceNumber;
+    int64_t timestampNs;  ///< Instante de captura en ns desde la época (reloj de pared).
     
-    ImageData(cv::Mat img, size_t seq) : image(img), sequenceNumber(seq) {}
+    ImageData(Frame img, size_t seq, int64_t timestamp = 0)
+        : image(img), sequenceNumber(seq), timestampNs(timestamp) {}
+};
+
+/**
+ * @class FrameSink
+ * @brief Destino de los fotogramas del generador: la cola de los escritores o el runtime de tareas.
+ */
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+
+    /**
+     * @brief Entrega un fotograma.
+     * @return true si se aceptó, false si se descartó o el destino está terminado.
+     */
+    virtual bool push(const ImageData& data) = 0;
+
+    /**
+     * @brief Fotogramas aceptados pendientes de procesar.
+     */
+    virtual size_t size() = 0;
+
+    /**
+     * @brief Fotogramas descartados por estar lleno.
+     */
+    virtual size_t dropped() const = 0;
+
+    /**
+     * @brief Fotogramas pendientes como máximo (0 = sin cola intermedia).
+     */
+    virtual size_t capacity() const = 0;
+
+    /**
+     * @brief Espera a que todo fotograma aceptado esté terminado (escrito, fallido o descartado).
+     *
+     * A diferencia de size() == 0, cuenta también los fotogramas que un escritor ya sacó
+     * y aún está codificando o escribiendo. Lo usa el reloj virtual antes de avanzar.
+     *
+     * @param timeout Espera máxima en tiempo real.
+     * @return true si no queda trabajo en curso.
+     */
+    virtual bool waitIdle(std::chrono::milliseconds timeout) = 0;
 };
 
 #endif // IMAGEDATA_H
\ No newline at end of file
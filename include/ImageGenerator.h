@@ -1,35 +1,36 @@
 #ifndef IMAGEGENERATOR_H
 #define IMAGEGENERATOR_H
 
-#include <opencv2/core.hpp>
 #include <chrono>
+#include <cstdint>
 #include <atomic>
 #include "ThreadSafeQueue.h"
-
-/**
- * @brief Genera una imagen con ruido con las dimensiones especificadas.
- * @param width El ancho deseado de la imagen en píxeles.
- * @param height La altura deseada de la imagen en píxeles.
- * @return cv::Mat Una matriz OpenCV que representa la imagen aleatoria generada.
- */
-cv::Mat generateRandomImage(int width, int height);
+#include "LoadProfile.h"
+#include "FrameSource.h"
+#include "Clock.h"
+#include "PipelineStats.h"
 
 /**
  * @brief Hilo generador de imágenes
- * @param queue Cola donde se colocarán las imágenes generadas
- * @param width Ancho de las imágenes a generar
- * @param height Alto de las imágenes a generar
- * @param targetFPS Velocidad objetivo de generación (fotogramas por segundo)
+ * @param queue Destino de las imágenes generadas (cola de escritores o runtime de tareas)
+ * @param source Origen de los fotogramas
+ * @param profile Perfil de carga que define la tasa objetivo en cada instante
+ * @param clock Reloj usado para el ritmo de generación (real o virtual)
  * @param runDuration Duración total de la ejecución en segundos
- * @param statsImageCount Contador atómico de imágenes generadas
+ * @param stats Contadores compartidos del pipeline (imágenes generadas y encoladas)
+ * @param firstSequence Número de secuencia del primer fotograma
+ * @param generatorIndex Índice de este generador cuando varios se reparten el perfil
+ * @param generatorCount Número de generadores que se reparten el perfil
  */
 void imageGeneratorThread(
-    ThreadSafeQueue& queue, 
-    int width, 
-    int height, 
-    int targetFPS,
+    FrameSink& queue, 
+    FrameSource& source, 
+    LoadProfile& profile,
+    Clock& clock,
     std::chrono::seconds runDuration,
-    std::atomic<size_t>& statsImageCount,
-    std::atomic<size_t>& imagesEnqueued);
+    PipelineStats& stats,
+    uint64_t firstSequence = 0,
+    int generatorIndex = 0,
+    int generatorCount = 1);
 
 #endif // IMAGEGENERATOR_H
\ No newline at end of file
@@ -3,20 +3,180 @@
 
 #include <string>
 #include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "ThreadSafeQueue.h"
+#include "Encoder.h"
+#include "Storage.h"
+#include "PipelineStats.h"
+#include "RateLimiter.h"
+#include "FrameCipher.h"
+#include "RetryQueue.h"
+
+/**
+ * @brief Latido de un hilo escritor: etapa, fotograma y archivo en curso.
+ *
+ * El escritor lo actualiza al cambiar de etapa; el watchdog de WriterPool lo lee para
+ * detectar escritores bloqueados. Todas las operaciones son seguras entre hilos.
+ */
+class WriterHeartbeat {
+public:
+    /// Etapa del escritor.
+    enum class Stage : int { Idle, Encode, Cipher, Throttle, Write };
+
+    /**
+     * @brief Entra en una etapa para el fotograma indicado.
+     */
+    void enter(Stage stage, uint64_t sequence);
+
+    /**
+     * @brief Registra el archivo del fotograma en curso.
+     */
+    void setFile(const std::string& name);
+
+    /**
+     * @brief Marca el escritor como inactivo (esperando en la cola).
+     */
+    void idle();
+
+    /**
+     * @brief Etapa actual.
+     */
+    Stage stage() const { return static_cast<Stage>(currentStage.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief Segundos en la etapa actual.
+     */
+    double stageSeconds() const;
+
+    /**
+     * @brief Fotograma en curso.
+     */
+    uint64_t sequence() const { return currentSequence.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Archivo del fotograma en curso.
+     */
+    std::string file() const;
+
+    /**
+     * @brief Nombre de una etapa.
+     */
+    static const char* stageName(Stage stage);
+
+    std::atomic<bool> stalled{false};   ///< El watchdog lo retiró por bloqueo.
+    std::atomic<bool> finished{false};  ///< El hilo terminó.
+
+private:
+    std::atomic<int> currentStage{0};
+    std::atomic<int64_t> stageStartNs{0};
+    std::atomic<uint64_t> currentSequence{0};
+    mutable std::mutex fileMutex;
+    std::string currentFile;
+};
+
+/**
+ * @brief Fotograma codificado (y cifrado) listo para escribir.
+ */
+struct EncodedFrame {
+    std::string name;                                    ///< Nombre del archivo.
+    std::shared_ptr<std::vector<unsigned char>> buffer;  ///< Datos codificados.
+    FrameMeta meta;                                      ///< Secuencia y marca de tiempo.
+    CipherNonce nonce{};                                 ///< Nonce usado si se cifró.
+    bool encrypted = false;                              ///< El buffer está cifrado.
+    int writer = 0;                                      ///< Identificador del hilo que lo codificó.
+};
+
+/**
+ * @class FrameProcessor
+ * @brief Codificador y cifrador de un hilo: convierte un ImageData en un EncodedFrame.
+ *
+ * Cada hilo que codifica tiene el suyo para reutilizar manejadores y buffers; no es
+ * seguro usarlo desde varios hilos a la vez.
+ */
+class FrameProcessor {
+public:
+    /**
+     * @param encoderSettings Formato del codificador.
+     * @param quality Calidad vigente; se aplica al codificador cuando cambia.
+     * @param cipherSettings Cifrado en reposo; si está activo se crea un contexto propio.
+     * @param stats Contadores compartidos (tiempo y bytes de cifrado).
+     * @param threadId Identificador que se incluye en los nombres de archivo.
+     */
+    FrameProcessor(const EncoderSettings& encoderSettings, const std::atomic<int>& quality,
+                   const CipherSettings& cipherSettings, PipelineStats& stats, int threadId);
+
+    /**
+     * @brief Indica si el codificador (y el cifrado, si se pidió) se inicializaron.
+     */
+    bool isValid() const { return valid; }
+
+    /**
+     * @brief Codifica y, si corresponde, cifra un fotograma.
+     *
+     * Reutiliza el buffer del fotograma anterior salvo que algún destino lo conserve.
+     *
+     * @param data Imagen a codificar.
+     * @param frame Resultado.
+     * @param heartbeat Latido a actualizar (opcional).
+     * @return true si el fotograma está listo para escribirse.
+     */
+    bool encode(const ImageData& data, EncodedFrame& frame, WriterHeartbeat* heartbeat = nullptr);
+
+private:
+    const std::atomic<int>& quality;
+    const CipherSettings& cipherSettings;
+    PipelineStats& stats;
+    int threadId;
+    bool valid = false;
+    int currentQuality;
+    std::unique_ptr<Encoder> encoder;
+    std::unique_ptr<FrameCipher> cipher;
+    std::shared_ptr<std::vector<unsigned char>> buffer;
+};
+
+/**
+ * @brief Escribe un fotograma codificado respetando el limitador; los fallos van a la cola de reintentos.
+ * @param frame Fotograma codificado.
+ * @param storage Destino.
+ * @param cipherSettings Cifrado (para registrar el nonce en el índice).
+ * @param stats Contadores compartidos del pipeline.
+ * @param limiter Limitador de ancho de banda compartido (nullptr = sin límite).
+ * @param retries Cola de reintentos (nullptr = los fallos se pierden).
+ * @param heartbeat Latido a actualizar (opcional).
+ * @return true si el fotograma quedó guardado.
+ */
+bool storeFrame(const EncodedFrame& frame, Storage& storage, const CipherSettings& cipherSettings,
+                PipelineStats& stats, BandwidthLimiter* limiter, RetryQueue* retries,
+                WriterHeartbeat* heartbeat = nullptr);
 
 /**
  * @brief Hilo escritor de imágenes
  * @param queue Cola de donde se obtendrán las imágenes a escribir
- * @param outputDir Directorio donde se escribirán las imágenes
- * @param statsBytesWritten Contador atómico de bytes escritos
+ * @param storage Destino donde se guardarán las imágenes codificadas
+ * @param encoderSettings Formato del codificador
+ * @param quality Calidad de compresión vigente (puede cambiar durante la ejecución)
+ * @param cipherSettings Cifrado en reposo de los fotogramas codificados
+ * @param stats Contadores compartidos del pipeline
+ * @param limiter Limitador de ancho de banda compartido (nullptr = sin límite)
  * @param threadId Identificador del hilo escritor
+ * @param retire Indicador para retirar el hilo tras el fotograma en curso
+ * @param heartbeat Latido que actualiza el hilo (nullptr = sin vigilancia)
+ * @param retries Cola de reintentos para las escrituras fallidas (nullptr = se descartan)
  */
 void imageWriterThread(
     ThreadSafeQueue& queue, 
-    const std::string& outputDir,
-    std::atomic<size_t>& statsBytesWritten,
-    std::atomic<size_t>& imagesSaved,
-    int threadId);
+    Storage& storage,
+    const EncoderSettings& encoderSettings,
+    const std::atomic<int>& quality,
+    const CipherSettings& cipherSettings,
+    PipelineStats& stats,
+    BandwidthLimiter* limiter,
+    int threadId,
+    const std::atomic<bool>& retire,
+    WriterHeartbeat* heartbeat = nullptr,
+    RetryQueue* retries = nullptr);
 
 #endif // IMAGEWRITER_H
\ No newline at end of file
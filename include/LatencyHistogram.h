@@ -0,0 +1,58 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class LatencyHistogram
+ * @brief Histograma de latencias sin bloqueo, con cubetas log-lineales en microsegundos.
+ *
+ * record() es un incremento relajado de un contador, apto para el camino de cada
+ * fotograma. Por debajo de 8 µs hay una cubeta por microsegundo; por encima, ocho
+ * cubetas por potencia de dos (error relativo máximo del 12,5%) hasta ~2^40 µs. Un
+ * hilo de muestreo toma instantáneas con counts() y calcula percentiles de cada
+ * intervalo restando dos instantáneas.
+ */
+class LatencyHistogram {
+public:
+    /// Número de cubetas.
+    static constexpr size_t kBuckets = 8 + 38 * 8;
+
+    using Counts = std::array<uint64_t, kBuckets>;
+
+    /**
+     * @brief Registra una muestra.
+     * @param ns Latencia en nanosegundos (las negativas cuentan como 0).
+     */
+    void record(int64_t ns) {
+        buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Instantánea de los contadores acumulados.
+     */
+    Counts counts() const;
+
+    /**
+     * @brief Percentil de unos contadores, en microsegundos (límite superior de la cubeta).
+     * @param counts Contadores, acumulados o diferencia de dos instantáneas.
+     * @param fraction Fracción, p. ej. 0.99.
+     * @return 0 si no hay muestras.
+     */
+    static double percentileUs(const Counts& counts, double fraction);
+
+    /**
+     * @brief Diferencia de dos instantáneas (`now` - `before`).
+     */
+    static Counts difference(const Counts& now, const Counts& before);
+
+private:
+    static size_t bucketFor(int64_t ns);
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,92 @@
+#ifndef LIBJPEGENCODER_H
+#define LIBJPEGENCODER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Encoder.h"
+#include "PixelKernels.h"
+
+/**
+ * @brief Tabla Huffman JPEG en la forma del segmento DHT (como JHUFF_TBL de libjpeg).
+ */
+struct HuffmanTable {
+    std::array<uint8_t, 17> bits{};     ///< bits[L]: códigos de L bits (L de 1 a 16).
+    std::array<uint8_t, 256> values{};  ///< Símbolos en orden de código.
+};
+
+/**
+ * @brief Tabla Huffman óptima para unas frecuencias, con códigos de 16 bits como máximo.
+ *
+ * Procedimiento del Anexo K.2 de la norma JPEG: construcción de Huffman con un símbolo
+ * reservado para que ningún código sea todo unos, ajuste de las longitudes a 16 bits y
+ * orden de los símbolos por longitud.
+ *
+ * @param frequencies Frecuencia de cada símbolo; los de frecuencia 0 no reciben código.
+ */
+HuffmanTable optimalHuffmanTable(const std::array<long, 256>& frequencies);
+
+/**
+ * @class LibjpegEncoder
+ * @brief Codificador JPEG con la API de libjpeg, con tablas Huffman optimizadas.
+ *
+ * La API de TurboJPEG 2.x no deja elegir las tablas Huffman, así que este codificador
+ * usa directamente libjpeg(-turbo), con el objeto de compresión, el destino en memoria
+ * y los punteros de fila reutilizados entre fotogramas. Modos:
+ *
+ * - **Por fotograma**: libjpeg optimiza las tablas de cada fotograma (dos pasadas).
+ * - **En caché**: un fotograma de cada `huffmanRefresh` se comprime optimizado y sus
+ *   tablas, completadas para que todo símbolo válido tenga código, se reutilizan en los
+ *   siguientes con una sola pasada. Cada escritor tiene su propio codificador, así que
+ *   cada uno muestrea su parte del flujo.
+ *
+ * Sin libjpeg al compilar, isValid() devuelve false.
+ */
+class LibjpegEncoder : public Encoder {
+public:
+    /**
+     * @param quality Calidad JPEG entre 0 y 100.
+     * @param kernels Núcleos del formato de los fotogramas.
+     * @param options Submuestreo, DCT y modo Huffman (sin codificación progresiva).
+     */
+    LibjpegEncoder(int quality, const PixelKernels& kernels, const JpegOptions& options);
+    ~LibjpegEncoder() override;
+
+    LibjpegEncoder(const LibjpegEncoder&) = delete;
+    LibjpegEncoder& operator=(const LibjpegEncoder&) = delete;
+
+    bool encode(const Frame& image, std::vector<unsigned char>& out) override;
+    const char* extension() const override { return "jpg"; }
+    void setQuality(int newQuality) override;
+
+    /**
+     * @brief Indica si el objeto de compresión de libjpeg se inicializó correctamente.
+     */
+    bool isValid() const { return compressor != nullptr; }
+
+    /**
+     * @brief Veces que se recalcularon las tablas en caché.
+     */
+    size_t tableRefreshes() const { return refreshes; }
+
+    /**
+     * @brief Indica si se compiló con libjpeg.
+     */
+    static bool available();
+
+private:
+    void* compressor = nullptr;           ///< Estado de libjpeg (opaco para no exponer jpeglib.h).
+    const PixelKernels& kernels;          ///< Núcleos del formato de los fotogramas.
+    const JpegHuffman huffman;            ///< Modo de las tablas Huffman.
+    const size_t refreshInterval;         ///< Fotogramas por recálculo de las tablas en caché.
+    int quality;                          ///< Calidad JPEG aplicada.
+    int pendingQuality;                   ///< Calidad pedida con setQuality.
+    size_t sinceRefresh = 0;              ///< Fotogramas desde el último recálculo.
+    bool tablesReady = false;             ///< Hay tablas en caché.
+    size_t refreshes = 0;                 ///< Recálculos de las tablas.
+    std::array<HuffmanTable, 4> cached;   ///< DC luminancia, DC crominancia, AC luminancia, AC crominancia.
+    Frame scratch;                        ///< Entrada de 8 bits reutilizada (formatos de 16 bits).
+};
+
+#endif // LIBJPEGENCODER_H
@@ -0,0 +1,140 @@
+#ifndef LOADPROFILE_H
+#define LOADPROFILE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @class LoadProfile
+ * @brief Perfil de carga que define la tasa de generación (FPS) en función del tiempo.
+ *
+ * Un perfil es una secuencia de tramos que se recorren en orden. Cada tramo dura
+ * un número de segundos y define cómo varía la tasa dentro de él:
+ *
+ * - `step D F`: tasa constante de `F` FPS durante `D` segundos.
+ * - `ramp D F0 F1`: rampa lineal de `F0` a `F1` FPS.
+ * - `burst D BASE PICO DURPICO PERIODO`: onda cuadrada; `PICO` FPS durante `DURPICO`
+ *   segundos al inicio de cada periodo y `BASE` FPS el resto.
+ * - `poisson D F`: llegadas de Poisson con media `F` FPS (intervalos exponenciales).
+ * - `repeat`: al terminar el último tramo vuelve a empezar desde el primero.
+ *
+ * Sin `repeat`, al agotarse el guion se mantiene el último tramo indefinidamente.
+ * Las llegadas de Poisson usan un generador con semilla fija para que las ejecuciones
+ * sean reproducibles.
+ */
+class LoadProfile {
+public:
+    /**
+     * @brief Tipo de tramo del perfil.
+     */
+    enum class SegmentType { Step, Ramp, Burst, Poisson };
+
+    /**
+     * @brief Tramo del perfil de carga.
+     */
+    struct Segment {
+        SegmentType type = SegmentType::Step;
+        double duration = 0.0;      ///< Duración del tramo en segundos.
+        double fps = 0.0;           ///< Tasa (inicial en rampas, base en ráfagas, media en Poisson).
+        double fpsEnd = 0.0;        ///< Tasa final de una rampa.
+        double peakFPS = 0.0;       ///< Tasa de pico de una ráfaga.
+        double peakDuration = 0.0;  ///< Duración del pico dentro de cada periodo.
+        double period = 0.0;        ///< Periodo de la onda cuadrada.
+    };
+
+    /**
+     * @brief Crea un perfil de tasa constante.
+     * @param fps Tasa objetivo en fotogramas por segundo.
+     */
+    explicit LoadProfile(double fps = 50.0);
+
+    /**
+     * @brief Interpreta un guion de carga.
+     *
+     * Los tramos se separan por saltos de línea o por `;`. El texto tras `#` es comentario.
+     *
+     * @param script Texto del guion.
+     * @param profile Perfil donde se almacenará el resultado.
+     * @return true si el guion es válido, false en caso contrario.
+     */
+    static bool parse(const std::string& script, LoadProfile& profile);
+
+    /**
+     * @brief Carga un perfil desde un archivo o, si no existe, desde el texto recibido.
+     * @param spec Ruta de un archivo de guion o guion en línea.
+     * @param profile Perfil donde se almacenará el resultado.
+     * @return true si el perfil es válido, false en caso contrario.
+     */
+    static bool load(const std::string& spec, LoadProfile& profile);
+
+    /**
+     * @brief Fija la semilla usada para las llegadas de Poisson.
+     * @param seed Semilla del generador pseudoaleatorio.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Tasa objetivo en un instante del perfil.
+     * @param t Segundos transcurridos desde el inicio.
+     * @return FPS objetivo (media en tramos de Poisson).
+     */
+    double rateAt(double t) const;
+
+    /**
+     * @brief Intervalo hasta el siguiente fotograma.
+     * @param t Segundos transcurridos desde el inicio.
+     * @return Tiempo de espera hasta la siguiente llegada.
+     */
+    std::chrono::microseconds nextInterval(double t);
+
+    /**
+     * @brief Tasa máxima del perfil: la fijada con overrideRate() o el mayor FPS del guion.
+     * @return FPS de pico (media en tramos de Poisson).
+     */
+    double peakRate() const;
+
+    /**
+     * @brief Fija una tasa constante que sustituye al guion, o vuelve a él.
+     *
+     * Puede llamarse desde cualquier hilo mientras el generador usa el perfil.
+     *
+     * @param fps Tasa constante en FPS; 0 o negativo vuelve a seguir el guion.
+     */
+    void overrideRate(double fps);
+
+    /**
+     * @brief Duración total del guion (suma de tramos) en segundos.
+     */
+    double duration() const;
+
+    /**
+     * @brief Indica si el perfil es una tasa constante.
+     */
+    bool isConstant() const;
+
+    /**
+     * @brief Descripción legible del perfil.
+     */
+    std::string describe() const;
+
+private:
+    /**
+     * @brief Localiza el tramo activo en un instante.
+     * @param t Segundos transcurridos desde el inicio.
+     * @param local Tiempo relativo al inicio del tramo.
+     * @param remaining Tiempo restante hasta el fin del tramo.
+     * @return Índice del tramo activo.
+     */
+    size_t locate(double t, double& local, double& remaining) const;
+
+    std::vector<Segment> segments;  ///< Tramos del guion en orden.
+    bool repeat = false;            ///< Repite el guion al terminar.
+    std::mt19937_64 rng;            ///< Generador para las llegadas de Poisson.
+    std::atomic<double> overrideFPS{0.0}; ///< Tasa fijada en tiempo de ejecución (0 = seguir el guion).
+};
+
+#endif // LOADPROFILE_H
@@ -0,0 +1,135 @@
+#ifndef MIRRORSTORAGE_H
+#define MIRRORSTORAGE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Storage.h"
+
+/**
+ * @class MirrorStorage
+ * @brief Escribe cada fotograma codificado en dos destinos a la vez, con un solo buffer.
+ *
+ * Cada destino tiene su propio hilo y su cola de pendientes. El buffer se comparte por
+ * referencia (sin copias) y se libera cuando ambos destinos terminaron con él.
+ *
+ * El escritor espera solo al primer destino que complete la escritura; el otro puede
+ * retrasarse hasta `maxBacklog` fotogramas. Si su cola está llena, ese destino omite
+ * el fotograma (se contabiliza) en lugar de frenar al otro, de modo que un disco lento
+ * o averiado no detiene la grabación.
+ */
+class MirrorStorage : public Storage {
+public:
+    /**
+     * @param primary Primer destino.
+     * @param secondary Segundo destino (copia espejo).
+     * @param maxBacklog Fotogramas pendientes máximos por destino.
+     */
+    MirrorStorage(std::unique_ptr<Storage> primary, std::unique_ptr<Storage> secondary, size_t maxBacklog);
+    ~MirrorStorage() override;
+
+    MirrorStorage(const MirrorStorage&) = delete;
+    MirrorStorage& operator=(const MirrorStorage&) = delete;
+
+    /**
+     * @brief Copia el buffer una vez y lo reparte; preferir writeShared().
+     */
+    bool write(const std::string& name, const std::vector<unsigned char>& data) override;
+    bool writeShared(const std::string& name, const SharedBuffer& data) override;
+    bool writeFrame(const std::string& name, const SharedBuffer& data, const FrameMeta& meta) override;
+    std::string describe() const override;
+    bool rollover() override;
+
+    /**
+     * @brief Revisa ambos destinos y continúa tras la mayor secuencia de los dos.
+     */
+    bool recover(uint64_t& nextSequence) override;
+
+    /**
+     * @brief Espera a que ambos destinos terminen lo pendiente y detiene sus hilos.
+     */
+    void drain();
+
+    /**
+     * @brief Informe por destino: archivos, fallos, omisiones y retraso.
+     */
+    std::string report() const;
+
+    /**
+     * @brief Volúmenes de cada destino; un destino de un solo volumen cuenta sus bytes guardados.
+     */
+    std::vector<VolumeUsage> volumeUsage() const override;
+
+    /**
+     * @brief Fotogramas pendientes en el destino más retrasado.
+     */
+    size_t backlog() const;
+
+private:
+    /**
+     * @brief Seguimiento de un fotograma enviado a ambos destinos.
+     */
+    struct Ticket {
+        std::mutex mutex;
+        std::condition_variable done;
+        int finished = 0;    ///< Destinos que terminaron (con o sin éxito).
+        int succeeded = 0;   ///< Destinos que lo guardaron.
+
+        /**
+         * @brief Registra el resultado de un destino y despierta al escritor.
+         */
+        void complete(bool success);
+    };
+
+    /**
+     * @brief Escritura pendiente en un destino.
+     */
+    struct Job {
+        std::string name;
+        SharedBuffer data;
+        FrameMeta meta;
+        std::shared_ptr<Ticket> ticket;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    /**
+     * @brief Destino con su hilo, su cola y sus contadores.
+     */
+    struct Destination {
+        std::unique_ptr<Storage> storage;
+        mutable std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::deque<Job> jobs;
+        bool stopping = false;
+        std::thread thread;
+
+        std::atomic<size_t> files{0};       ///< Fotogramas guardados.
+        std::atomic<size_t> bytes{0};       ///< Bytes guardados.
+        std::atomic<size_t> failures{0};    ///< Escrituras fallidas.
+        std::atomic<size_t> skipped{0};     ///< Fotogramas omitidos por cola llena.
+        std::atomic<int64_t> totalLagNs{0}; ///< Suma de retrasos envío → guardado.
+        std::atomic<int64_t> maxLagNs{0};   ///< Mayor retraso envío → guardado.
+    };
+
+    /**
+     * @brief Bucle del hilo de un destino.
+     */
+    void serve(Destination& destination);
+
+    /**
+     * @brief Encola un trabajo en el destino si hay espacio.
+     * @return false si la cola del destino está llena.
+     */
+    bool submit(Destination& destination, const Job& job);
+
+    size_t maxBacklog;                    ///< Fotogramas pendientes máximos por destino.
+    Destination destinations[2];          ///< Destino primario y espejo.
+};
+
+#endif // MIRRORSTORAGE_H
@@ -0,0 +1,118 @@
+#ifndef PERCORERUNTIME_H
+#define PERCORERUNTIME_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ImageData.h"
+#include "ImageWriter.h"
+#include "ThreadTuning.h"
+
+/**
+ * @class CoreFrameSink
+ * @brief Destino de un generador por núcleo: codifica y escribe cada fotograma en el propio hilo.
+ *
+ * No hay cola ni traspaso entre hilos: el fotograma pasa del generador al codificador y
+ * al destino sin salir de la caché del núcleo. Lleva sus propios contadores para el
+ * reparto por núcleo.
+ */
+class CoreFrameSink : public FrameSink {
+public:
+    /**
+     * @param storage Destino de las imágenes codificadas.
+     * @param encoderSettings Formato del codificador.
+     * @param quality Calidad vigente.
+     * @param cipherSettings Cifrado en reposo.
+     * @param stats Contadores compartidos del pipeline.
+     * @param limiter Limitador de ancho de banda compartido (nullptr = sin límite).
+     * @param retries Cola de reintentos de escritura (nullptr = sin reintentos).
+     * @param core Índice del núcleo; los archivos llevan `_tN` con N = núcleo + 1.
+     */
+    CoreFrameSink(Storage& storage, const EncoderSettings& encoderSettings, const std::atomic<int>& quality,
+                  const CipherSettings& cipherSettings, PipelineStats& stats, BandwidthLimiter* limiter,
+                  RetryQueue* retries, int core);
+
+    bool isValid() const { return processor.isValid(); }
+
+    bool push(const ImageData& data) override;
+    size_t size() override { return 0; }
+    size_t dropped() const override { return 0; }
+    size_t capacity() const override { return 0; }
+    bool waitIdle(std::chrono::milliseconds) override { return true; } ///< push() procesa en el sitio.
+
+    /**
+     * @brief Fotogramas procesados por este núcleo.
+     */
+    size_t frames() const { return processed.load(); }
+
+    /**
+     * @brief Tiempo codificando y escribiendo, en nanosegundos.
+     */
+    int64_t busyNs() const { return busy.load(); }
+
+private:
+    FrameProcessor processor;
+    Storage& storage;
+    const CipherSettings& cipherSettings;
+    PipelineStats& stats;
+    BandwidthLimiter* limiter;
+    RetryQueue* retries;
+    EncodedFrame frame;
+    std::atomic<size_t> processed{0};
+    std::atomic<int64_t> busy{0};
+};
+
+/**
+ * @class PerCoreRuntime
+ * @brief Un hilo fijado a cada núcleo que genera, codifica y escribe sus propios fotogramas (`-runtime percore`).
+ *
+ * Cada núcleo tiene su generador (con 1/N de la tasa), su origen de fotogramas, su
+ * codificador y sus archivos. Solo se comparten el reparto de números de secuencia y
+ * los contadores de PipelineStats (y, según el destino, su estado interno).
+ */
+class PerCoreRuntime {
+public:
+    /**
+     * @brief Cuerpo de cada núcleo: genera fotogramas hacia `sink` hasta el final de la ejecución.
+     */
+    using CoreBody = std::function<void(int core, FrameSink& sink)>;
+
+    /**
+     * @param cores Número de núcleos (hilos).
+     * @param tuning Prioridades de CPU y de E/S que aplica cada hilo (las de los escritores).
+     */
+    PerCoreRuntime(int cores, const ThreadTuning& tuning);
+
+    /**
+     * @brief Crea el destino de cada núcleo.
+     * @return true si todos los codificadores se inicializaron.
+     */
+    bool prepare(Storage& storage, const EncoderSettings& encoderSettings, const std::atomic<int>& quality,
+                 const CipherSettings& cipherSettings, PipelineStats& stats, BandwidthLimiter* limiter,
+                 RetryQueue* retries);
+
+    /**
+     * @brief Lanza un hilo fijado por núcleo con `body` y espera a que terminen todos.
+     */
+    void run(const CoreBody& body);
+
+    /**
+     * @brief Número de núcleos.
+     */
+    int size() const { return cores; }
+
+    /**
+     * @brief Reparto de fotogramas y ocupación por núcleo.
+     * @param seconds Duración de la generación, para la ocupación.
+     */
+    std::string report(double seconds) const;
+
+private:
+    const int cores;
+    const ThreadTuning tuning;
+    std::vector<std::unique_ptr<CoreFrameSink>> sinks;
+};
+
+#endif // PERCORERUNTIME_H
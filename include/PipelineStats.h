@@ -0,0 +1,62 @@
+#ifndef PIPELINESTATS_H
+#define PIPELINESTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "LatencyHistogram.h"
+
+/// Escritores (por identificador, desde 1) con contador propio de fotogramas guardados.
+constexpr int kMaxWriterStats = 64;
+
+/**
+ * @brief Contadores compartidos por las etapas del pipeline.
+ *
+ * Todos los campos son atómicos: los hilos los actualizan sin bloqueo y cualquier
+ * otro hilo (resultados finales, canal de control) puede leerlos en cualquier momento.
+ */
+struct PipelineStats {
+    std::atomic<size_t> imagesGenerated{0};  ///< Imágenes producidas por el generador.
+    std::atomic<size_t> imagesEnqueued{0};   ///< Imágenes aceptadas por la cola.
+    std::atomic<size_t> imagesSaved{0};      ///< Imágenes guardadas por los escritores.
+    std::atomic<size_t> bytesWritten{0};     ///< Bytes guardados por los escritores.
+    std::atomic<size_t> deadlineMisses{0};   ///< Fotogramas terminados después de la llegada siguiente.
+    std::atomic<int64_t> maxWakeupLatencyUs{0}; ///< Mayor retraso del generador respecto a una llegada programada.
+    std::atomic<size_t> throttledWrites{0};  ///< Escrituras retenidas por el limitador de ancho de banda.
+    std::atomic<int64_t> throttleWaitNs{0};  ///< Tiempo total de espera en el limitador (suma de escritores).
+    std::atomic<size_t> cipherBytes{0};      ///< Bytes cifrados por los escritores.
+    std::atomic<int64_t> cipherNs{0};        ///< Tiempo total cifrando (suma de escritores).
+    std::atomic<size_t> writerStalls{0};     ///< Escritores retirados por el watchdog.
+    std::atomic<size_t> writerReplacements{0}; ///< Escritores lanzados para reemplazar a uno bloqueado.
+    std::atomic<size_t> writerRecoveries{0}; ///< Escritores bloqueados que acabaron desbloqueándose.
+    std::atomic<size_t> writeRetries{0};     ///< Reintentos de escritura hechos.
+    std::atomic<size_t> writeRecoveries{0};  ///< Fotogramas guardados tras reintentar.
+    std::atomic<size_t> writeSpills{0};      ///< Fotogramas desviados al destino alternativo.
+    std::atomic<size_t> writeFailures{0};    ///< Fotogramas perdidos por errores de escritura.
+    std::atomic<int64_t> firstSaveNs{0};     ///< Instante (steady_clock, ns) del primer guardado; 0 si aún no hay.
+    LatencyHistogram encodeLatency;          ///< Latencia de cada codificación.
+    LatencyHistogram writeLatency;           ///< Latencia de cada escritura en el destino.
+    std::array<std::atomic<size_t>, kMaxWriterStats> savedByWriter{}; ///< Guardados por escritor (índice = identificador).
+};
+
+/**
+ * @brief Cuenta un fotograma guardado y, si es el primero, anota el instante.
+ * @param writer Escritor que lo guardó (0 = ninguno, p. ej. la cola de reintentos).
+ */
+inline void countSavedFrame(PipelineStats& stats, size_t bytes, int writer = 0) {
+    stats.imagesSaved++;
+    stats.bytesWritten += bytes;
+    if (writer > 0 && writer < kMaxWriterStats) {
+        stats.savedByWriter[writer].fetch_add(1, std::memory_order_relaxed);
+    }
+    if (stats.firstSaveNs.load(std::memory_order_relaxed) == 0) {
+        int64_t none = 0;
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        stats.firstSaveNs.compare_exchange_strong(none, now);
+    }
+}
+
+#endif // PIPELINESTATS_H
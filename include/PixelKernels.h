@@ -0,0 +1,76 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <cstdint>
+#include <string>
+#include "Frame.h"
+
+/**
+ * @brief Estado del generador de ruido de los núcleos (xorshift64 en cuatro carriles).
+ *
+ * Los cuatro carriles son independientes para que el bucle de relleno se vectorice.
+ */
+struct NoiseState {
+    uint64_t lanes[4];
+
+    /**
+     * @param seed Semilla; orígenes distintos deben usar semillas distintas.
+     */
+    explicit NoiseState(uint64_t seed = 1);
+};
+
+/**
+ * @brief Núcleos de píxel de un formato (y opcionalmente una resolución) concretos.
+ *
+ * Cada entrada es una instancia de plantilla con el tipo de canal, el número de canales
+ * y, en las variantes de resolución fija, el ancho y el alto como constantes de
+ * compilación: los límites de los bucles y los tamaños de fila son `constexpr` y no hay
+ * comprobaciones de tipo por fotograma. La tabla se elige una vez al arrancar con
+ * selectPixelKernels(); genericPixelKernels() conserva el camino genérico anterior
+ * (cv::randu, o un bucle por filas sin OpenCV, y comprobaciones en cada llamada) como
+ * referencia para las comparativas.
+ */
+struct PixelKernels {
+    PixelFormat format;     ///< Formato de los fotogramas.
+    int width;              ///< Ancho fijo de la instancia (0 = cualquiera).
+    int height;             ///< Alto fijo de la instancia (0 = cualquiera).
+    const char* variant;    ///< "genérico", "especializado" o "especializado 1920x1080", etc.
+    int tjPixelFormat;      ///< Formato de píxel TurboJPEG de la entrada del codificador.
+    int tjSubsampling;      ///< Submuestreo cromático (TJSAMP_GRAY en los formatos de un canal).
+
+    /**
+     * @brief Rellena `image` (ya reservada con este formato y tamaño) con ruido uniforme.
+     */
+    void (*fillNoise)(Frame& image, NoiseState& state);
+
+    /**
+     * @brief Imagen de 8 bits que recibe el codificador.
+     *
+     * Los formatos de 8 bits se entregan sin copia; Gray16 se reduce a sus 8 bits
+     * altos en `scratch`, que se reutiliza entre fotogramas.
+     */
+    const Frame& (*encoderInput)(const Frame& image, Frame& scratch);
+};
+
+/**
+ * @brief Elige los núcleos especializados de un formato.
+ * @param format Formato de los fotogramas.
+ * @param width Ancho de los fotogramas.
+ * @param height Alto de los fotogramas.
+ * @param fixedResolution Usar la instancia de resolución fija si existe (1920x1080 o 3840x2160).
+ * @return Tabla de núcleos, o nullptr si el formato no está soportado.
+ */
+const PixelKernels* selectPixelKernels(PixelFormat format, int width, int height, bool fixedResolution = true);
+
+/**
+ * @brief Núcleos genéricos de un formato: el camino en tiempo de ejecución, para comparar.
+ * @return Tabla de núcleos, o nullptr si el formato no está soportado.
+ */
+const PixelKernels* genericPixelKernels(PixelFormat format);
+
+/**
+ * @brief Descripción de una tabla de núcleos, p. ej. "bgr, especializado 1920x1080".
+ */
+std::string describePixelKernels(const PixelKernels& kernels);
+
+#endif // PIXELKERNELS_H
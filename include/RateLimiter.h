@@ -0,0 +1,91 @@
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include <mutex>
+#include <string>
+#include "Clock.h"
+
+/**
+ * @class TokenBucket
+ * @brief Cubeta de fichas con tasa de reposición y capacidad de ráfaga.
+ *
+ * No es segura para hilos por sí misma; BandwidthLimiter la protege con su mutex.
+ * Las reservas pueden dejar el saldo en negativo (deuda): la espera necesaria para
+ * saldarla se devuelve al llamante, de modo que peticiones mayores que la ráfaga
+ * también avanzan y el orden de llegada se respeta.
+ */
+class TokenBucket {
+public:
+    /**
+     * @param rate Fichas por segundo (0 = sin límite).
+     * @param burst Capacidad máxima acumulable.
+     */
+    TokenBucket(double rate = 0.0, double burst = 0.0);
+
+    /**
+     * @brief Reserva fichas y calcula cuánto debe esperar el llamante.
+     * @param tokens Fichas a consumir.
+     * @param now Instante actual.
+     * @return Segundos de espera hasta que la reserva quede cubierta.
+     */
+    double reserve(double tokens, Clock::time_point now);
+
+    /**
+     * @brief Indica si la cubeta limita (tasa mayor que 0).
+     */
+    bool enabled() const { return rate > 0.0; }
+
+    double getRate() const { return rate; }
+    double getBurst() const { return burst; }
+
+private:
+    double rate;                  ///< Fichas repuestas por segundo.
+    double burst;                 ///< Capacidad máxima de la cubeta.
+    double tokens;                ///< Saldo actual (puede ser negativo).
+    Clock::time_point lastRefill; ///< Última reposición.
+    bool started = false;         ///< Indica si ya se fijó el instante inicial.
+};
+
+/**
+ * @class BandwidthLimiter
+ * @brief Limitador compartido de bytes/s y operaciones/s para todos los escritores.
+ *
+ * Cada escritura consume sus bytes de una cubeta y una ficha de la otra; el
+ * escritor espera lo que indique la más restrictiva. Usa el reloj del pipeline, por
+ * lo que también funciona con el reloj virtual.
+ */
+class BandwidthLimiter {
+public:
+    /**
+     * @param clock Reloj usado para reponer fichas y esperar.
+     * @param bytesPerSecond Límite de ancho de banda (0 = sin límite).
+     * @param operationsPerSecond Límite de IOPS (0 = sin límite).
+     * @param burstSeconds Ráfaga permitida, en segundos de tasa acumulada.
+     */
+    BandwidthLimiter(Clock& clock, double bytesPerSecond, double operationsPerSecond, double burstSeconds);
+
+    /**
+     * @brief Espera hasta que se pueda escribir `bytes` en una operación.
+     * @param bytes Tamaño de la escritura.
+     * @return Tiempo esperado por el limitador.
+     */
+    Clock::duration acquire(size_t bytes);
+
+    /**
+     * @brief Indica si hay algún límite activo.
+     */
+    bool enabled() const { return bytes.enabled() || operations.enabled(); }
+
+    /**
+     * @brief Descripción legible de los límites.
+     */
+    std::string describe() const;
+
+private:
+    Clock& clock;
+    std::mutex mutex;          ///< Protege ambas cubetas.
+    TokenBucket bytes;         ///< Cubeta de bytes.
+    TokenBucket operations;    ///< Cubeta de operaciones.
+};
+
+#endif // RATELIMITER_H
@@ -0,0 +1,135 @@
+#ifndef RETRYQUEUE_H
+#define RETRYQUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include "FrameCipher.h"
+#include "PipelineStats.h"
+#include "RateLimiter.h"
+#include "Storage.h"
+
+/**
+ * @brief Política de reintento de las escrituras fallidas.
+ */
+struct RetryPolicy {
+    int maxAttempts = 5;         ///< Reintentos por fotograma (0 = sin cola de reintentos).
+    double baseDelay = 0.05;     ///< Espera antes del primer reintento, en segundos.
+    double maxDelay = 5.0;       ///< Espera máxima entre reintentos, en segundos.
+    size_t capacity = 256;       ///< Fotogramas pendientes como máximo.
+};
+
+/**
+ * @class RetryQueue
+ * @brief Cola de reintentos con espera exponencial, fuera del camino de los escritores.
+ *
+ * Un escritor cuya escritura falla entrega el fotograma (el mismo buffer compartido)
+ * y sigue con la cola principal. Un hilo propio reintenta cada fotograma cuando vence
+ * su espera, que se duplica en cada intento (con variación aleatoria para no
+ * sincronizar reintentos) hasta `maxDelay`. Los errores permanentes o los fotogramas
+ * que agotan los intentos se desvían al destino alternativo si existe; si no, se pierden.
+ * El nonce de un fotograma cifrado se registra en el índice solo cuando un reintento o
+ * el desvío lo guardan, así que el índice no nombra fotogramas perdidos. Cada reintento
+ * y cada desvío pasan por el limitador de escritura compartido con los escritores.
+ */
+class RetryQueue {
+public:
+    /**
+     * @param storage Destino donde se reintenta.
+     * @param policy Política de reintento.
+     * @param spill Destino alternativo para los fotogramas que no se pueden guardar (nullptr = ninguno).
+     * @param stats Contadores compartidos del pipeline.
+     * @param cipherIndex Índice de nonces de los fotogramas cifrados (nullptr = sin cifrado).
+     * @param limiter Limitador de bytes/s e IOPS compartido con los escritores (nullptr = sin límite).
+     */
+    RetryQueue(Storage& storage, const RetryPolicy& policy, Storage* spill, PipelineStats& stats,
+               CipherIndex* cipherIndex = nullptr, BandwidthLimiter* limiter = nullptr);
+    ~RetryQueue();
+
+    RetryQueue(const RetryQueue&) = delete;
+    RetryQueue& operator=(const RetryQueue&) = delete;
+
+    /**
+     * @brief Entrega un fotograma cuya escritura falló.
+     * @param name Nombre del archivo.
+     * @param data Contenido codificado compartido.
+     * @param meta Metadatos del fotograma.
+     * @param error errno del fallo (0 si no se conoce).
+     * @param nonce Nonce del fotograma si está cifrado (nullptr si no).
+     * @return false si la cola está llena; el fotograma no se aceptó.
+     */
+    bool submit(const std::string& name, const Storage::SharedBuffer& data, const FrameMeta& meta, int error,
+                const CipherNonce* nonce = nullptr);
+
+    /**
+     * @brief Espera a que se resuelvan todos los fotogramas pendientes y detiene el hilo.
+     */
+    void drain();
+
+    /**
+     * @brief Fotogramas pendientes de reintento.
+     */
+    size_t pending() const;
+
+private:
+    /**
+     * @brief Fotograma pendiente.
+     */
+    struct Item {
+        std::string name;
+        Storage::SharedBuffer data;
+        FrameMeta meta;
+        int attempts = 0;     ///< Reintentos hechos.
+        int lastError = 0;    ///< errno del último fallo.
+        bool encrypted = false;
+        CipherNonce nonce{};  ///< Nonce con el que se cifró (si encrypted).
+    };
+
+    /**
+     * @brief Bucle del hilo de reintentos.
+     */
+    void loop();
+
+    /**
+     * @brief Espera antes del siguiente intento de un fotograma (con el mutex tomado).
+     */
+    std::chrono::steady_clock::duration backoffLocked(int attempts);
+
+    /**
+     * @brief Desvía o descarta un fotograma que no se pudo guardar.
+     */
+    void giveUp(const Item& item);
+
+    /**
+     * @brief Cuenta un fotograma guardado y registra su nonce si está cifrado.
+     */
+    void saved(const Item& item);
+
+    /**
+     * @brief Espera en el limitador antes de escribir un fotograma.
+     */
+    void throttle(const Item& item);
+
+    Storage& storage;
+    RetryPolicy policy;
+    Storage* spill;
+    PipelineStats& stats;
+    CipherIndex* cipherIndex;
+    BandwidthLimiter* limiter;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;      ///< Nuevo fotograma o parada.
+    std::condition_variable idle;      ///< La cola quedó vacía.
+    std::multimap<std::chrono::steady_clock::time_point, Item> items;  ///< Pendientes por vencimiento.
+    size_t inFlight = 0;               ///< Fotogramas que el hilo está intentando.
+    bool stopping = false;
+    std::mt19937 rng{12345};           ///< Variación de las esperas.
+    std::thread worker;
+};
+
+#endif // RETRYQUEUE_H
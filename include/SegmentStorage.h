@@ -0,0 +1,190 @@
+#ifndef SEGMENTSTORAGE_H
+#define SEGMENTSTORAGE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Storage.h"
+#include "TimeIndex.h"
+
+/**
+ * @brief Cabecera de cada registro de un segmento (40 bytes, little-endian).
+ *
+ * Le siguen el nombre del fotograma (`nameSize` bytes) y el contenido codificado
+ * (`payloadSize` bytes). `headerCrc` cubre la cabecera (con ese campo a cero) y el
+ * nombre; `payloadCrc` cubre el contenido. Ambos son CRC32C.
+ */
+struct SegmentRecordHeader {
+    uint32_t magic;        ///< kSegmentRecordMagic.
+    uint32_t headerCrc;    ///< CRC32C de cabecera + nombre.
+    uint32_t payloadCrc;   ///< CRC32C del contenido.
+    uint32_t payloadSize;  ///< Bytes de contenido.
+    uint64_t sequence;     ///< Número de secuencia del fotograma.
+    uint16_t nameSize;     ///< Bytes del nombre.
+    uint16_t flags;        ///< Reservado (0).
+    uint32_t reserved;     ///< Reservado (0).
+    int64_t timestampNs;   ///< Instante de captura (ns desde la época).
+};
+
+static_assert(sizeof(SegmentRecordHeader) == 40, "la cabecera de registro debe ocupar 40 bytes");
+
+/// Marca de inicio de registro ("FCSR").
+constexpr uint32_t kSegmentRecordMagic = 0x52534346u;
+
+/**
+ * @class SegmentStorage
+ * @brief Grabación en segmentos de registros con suma de comprobación, consistente ante cortes.
+ *
+ * Los fotogramas se añaden a `seg_NNNNNNNN.dat` con una cabecera CRC32C por registro;
+ * al alcanzar el tamaño máximo (o con rollover) se abre el segmento siguiente. Un hilo
+ * de checkpoint sincroniza periódicamente los datos (`fdatasync`) y guarda en
+ * `segments.ckpt` (temporal + rename) la longitud durable, registros y mayor secuencia
+ * de cada segmento.
+ *
+ * Al arrancar, recover() confía en los segmentos que coinciden con el checkpoint y
+ * verifica en paralelo solo lo escrito después: trunca la cola rota de cada segmento
+ * y continúa la numeración tras la mayor secuencia válida. El hilo de checkpoint no
+ * arranca hasta que la tabla de segmentos es válida (al terminar recover() o con el
+ * primer registro), así nunca sustituye el checkpoint anterior por una tabla a medias.
+ *
+ * Con índice temporal, `time.idx` guarda una entrada por bloque contiguo de registros
+ * (segmento, posición, longitud y marcas de tiempo) para buscar por instante sin
+ * recorrer los segmentos.
+ */
+class SegmentStorage : public Storage {
+public:
+    /**
+     * @param directory Directorio de los segmentos (debe existir).
+     * @param segmentSize Tamaño máximo de cada segmento en bytes.
+     * @param checkpointInterval Segundos entre checkpoints.
+     * @param timeIndexInterval Segundos cubiertos por cada entrada del índice temporal (0 = sin índice).
+     */
+    SegmentStorage(const std::string& directory, size_t segmentSize, double checkpointInterval,
+                   double timeIndexInterval = 1.0);
+    ~SegmentStorage() override;
+
+    SegmentStorage(const SegmentStorage&) = delete;
+    SegmentStorage& operator=(const SegmentStorage&) = delete;
+
+    bool write(const std::string& name, const std::vector<unsigned char>& data) override;
+    bool writeFrame(const std::string& name, const SharedBuffer& data, const FrameMeta& meta) override;
+    std::string describe() const override;
+    bool rollover() override;
+    bool recover(uint64_t& nextSequence) override;
+
+    /**
+     * @brief Hace un último checkpoint y cierra los segmentos.
+     */
+    void close();
+
+    /**
+     * @brief Informe de segmentos, checkpoints y recuperación.
+     */
+    std::string report() const;
+
+private:
+    /**
+     * @brief Estado de un segmento para el checkpoint.
+     */
+    struct SegmentInfo {
+        uint64_t length = 0;      ///< Bytes válidos (durables en el checkpoint).
+        uint64_t records = 0;     ///< Registros válidos.
+        uint64_t maxSequence = 0; ///< Mayor secuencia (válida si records > 0).
+    };
+
+    /**
+     * @brief Resultado de verificar un segmento.
+     */
+    struct ScanResult {
+        SegmentInfo info;
+        uint64_t truncatedBytes = 0;
+        bool scanned = false;
+        bool ok = true;
+    };
+
+    /**
+     * @brief Añade un registro (con el mutex tomado).
+     */
+    bool appendLocked(const std::string& name, const unsigned char* data, size_t size, uint64_t sequence,
+                      int64_t timestampNs);
+
+    /**
+     * @brief Cuerpo de recover(), con los checkpoints serializados.
+     */
+    bool recoverSegments(uint64_t& nextSequence);
+
+    /**
+     * @brief Indexa los registros recuperados que no tienen entrada en el índice temporal.
+     * @return Registros indexados.
+     */
+    size_t reindexTail();
+
+    /**
+     * @brief Abre el siguiente segmento (con el mutex tomado).
+     */
+    bool openNextLocked();
+
+    /**
+     * @brief Lanza el hilo de checkpoint si aún no está en marcha y no se ha cerrado.
+     */
+    void startCheckpoints();
+
+    /**
+     * @brief Bucle del hilo de checkpoint.
+     */
+    void checkpointLoop();
+
+    /**
+     * @brief Sincroniza los datos y guarda el checkpoint.
+     */
+    bool checkpoint();
+
+    /**
+     * @brief Lee el checkpoint si existe y su CRC es válido.
+     */
+    bool loadCheckpoint(std::map<uint64_t, SegmentInfo>& segments, uint64_t& nextSequence) const;
+
+    /**
+     * @brief Escribe el checkpoint con temporal + fsync + rename.
+     */
+    bool saveCheckpoint(const std::map<uint64_t, SegmentInfo>& segments, uint64_t nextSequence) const;
+
+    /**
+     * @brief Verifica los registros de un segmento tras la parte confirmada y trunca la cola rota.
+     */
+    ScanResult scanSegment(uint64_t number, const SegmentInfo& trusted) const;
+
+    std::string segmentPath(uint64_t number) const;
+
+    std::string directory;              ///< Directorio de los segmentos.
+    size_t segmentSize;                 ///< Tamaño máximo de cada segmento.
+    double checkpointInterval;          ///< Segundos entre checkpoints.
+
+    mutable std::mutex mutex;           ///< Protege el segmento activo y la tabla.
+    int activeFd = -1;                  ///< Descriptor del segmento activo.
+    uint64_t activeNumber = 0;          ///< Número del segmento activo.
+    uint64_t nextSegment = 0;           ///< Número del siguiente segmento.
+    std::map<uint64_t, SegmentInfo> segments;  ///< Estado de todos los segmentos.
+    std::vector<int> closing;           ///< Segmentos cerrados pendientes de fdatasync.
+    uint64_t nextSequence = 0;          ///< Siguiente secuencia libre conocida.
+    bool tableReady = false;            ///< La tabla refleja el disco (recuperada o con registros nuevos).
+    TimeIndexWriter timeIndex;          ///< Índice temporal (si está activo).
+
+    std::mutex checkpointMutex;         ///< Protege `stopping` para el hilo de checkpoint.
+    std::mutex checkpointSerial;        ///< Serializa los checkpoints.
+    std::condition_variable wake;       ///< Despierta al hilo de checkpoint.
+    bool stopping = false;
+    std::thread checkpointThread;
+
+    std::atomic<size_t> recordsWritten{0};   ///< Registros escritos en esta ejecución.
+    std::atomic<size_t> checkpoints{0};      ///< Checkpoints completados.
+    std::atomic<int64_t> maxCheckpointNs{0}; ///< Checkpoint más lento.
+    std::string recoverySummary;             ///< Resumen de la última recuperación.
+};
+
+#endif // SEGMENTSTORAGE_H
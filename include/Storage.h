@@ -0,0 +1,208 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Metadatos del fotograma que acompañan a su escritura.
+ */
+struct FrameMeta {
+    uint64_t sequence = 0;   ///< Número de secuencia del fotograma.
+    int64_t timestampNs = 0; ///< Instante de captura en ns desde la época.
+};
+
+/**
+ * @brief Extrae el número de secuencia de un nombre `img_NNNNNNNN_...`.
+ * @param name Nombre del archivo.
+ * @param sequence Número de secuencia.
+ * @return false si el nombre no sigue el formato de los fotogramas.
+ */
+bool parseFrameSequence(const std::string& name, uint64_t& sequence);
+
+/**
+ * @brief Código errno de la última escritura fallida del hilo actual (0 si no se conoce).
+ *
+ * Los destinos lo registran con setStorageError() al fallar, antes de retornar false.
+ */
+int lastStorageError();
+
+/**
+ * @brief Registra el errno de una escritura del hilo actual (0 lo borra).
+ */
+void setStorageError(int error);
+
+/**
+ * @brief Indica si un error de escritura puede resolverse reintentando.
+ *
+ * Son transitorios EAGAIN, EINTR, ENOSPC (otro proceso puede liberar espacio), EIO,
+ * ETIMEDOUT, EBUSY y ESTALE (almacenamiento en red); también un error desconocido (0).
+ */
+bool isTransientStorageError(int error);
+
+/**
+ * @brief Bytes escritos en un volumen (directorio o destino) de un Storage.
+ */
+struct VolumeUsage {
+    std::string name;  ///< Directorio o descripción del volumen.
+    size_t bytes = 0;  ///< Bytes escritos desde el arranque.
+};
+
+/**
+ * @class Storage
+ * @brief Destino donde los hilos escritores guardan los fotogramas codificados.
+ *
+ * Las implementaciones deben ser seguras para su uso concurrente desde varios hilos.
+ */
+class Storage {
+public:
+    /// Fotograma codificado que puede compartirse entre destinos sin copiarlo.
+    using SharedBuffer = std::shared_ptr<const std::vector<unsigned char>>;
+
+    virtual ~Storage() = default;
+
+    /**
+     * @brief Guarda un fotograma codificado.
+     * @param name Nombre del archivo relativo al destino.
+     * @param data Contenido codificado.
+     * @return true si se guardó correctamente.
+     */
+    virtual bool write(const std::string& name, const std::vector<unsigned char>& data) = 0;
+
+    /**
+     * @brief Guarda un fotograma cuyo buffer puede seguir en uso tras retornar.
+     *
+     * Los destinos asíncronos conservan la referencia hasta terminar; quien escribe no
+     * debe reutilizar el buffer mientras tenga otras referencias. Por defecto equivale
+     * a write().
+     *
+     * @param name Nombre del archivo relativo al destino.
+     * @param data Contenido codificado compartido.
+     * @return true si se guardó correctamente.
+     */
+    virtual bool writeShared(const std::string& name, const SharedBuffer& data) { return write(name, *data); }
+
+    /**
+     * @brief Guarda un fotograma con sus metadatos.
+     *
+     * Los destinos que registran metadatos (segmentos) lo sobrescriben; por defecto
+     * equivale a writeShared().
+     *
+     * @param name Nombre del archivo relativo al destino.
+     * @param data Contenido codificado compartido.
+     * @param meta Metadatos del fotograma.
+     * @return true si se guardó correctamente.
+     */
+    virtual bool writeFrame(const std::string& name, const SharedBuffer& data, const FrameMeta& /*meta*/) {
+        return writeShared(name, data);
+    }
+
+    /**
+     * @brief Revisa lo grabado por ejecuciones anteriores antes de empezar a escribir.
+     *
+     * Descarta escrituras incompletas y calcula el siguiente número de secuencia, para
+     * que una nueva ejecución no sobrescriba fotogramas existentes.
+     *
+     * @param nextSequence Primer número de secuencia libre (no se modifica si no hay nada).
+     * @return true si se encontraron grabaciones anteriores.
+     */
+    virtual bool recover(uint64_t& /*nextSequence*/) { return false; }
+
+    /**
+     * @brief Descripción legible del destino.
+     */
+    virtual std::string describe() const = 0;
+
+    /**
+     * @brief Cambia el directorio de salida para las siguientes escrituras.
+     * @param directory Nuevo directorio (debe existir).
+     * @return false si el destino no admite el cambio.
+     */
+    virtual bool setDirectory(const std::string& /*directory*/) { return false; }
+
+    /**
+     * @brief Cierra el segmento activo y comienza uno nuevo.
+     *
+     * Los destinos que escriben un archivo por fotograma no tienen segmentos abiertos.
+     *
+     * @return false si el destino no usa segmentos.
+     */
+    virtual bool rollover() { return false; }
+
+    /**
+     * @brief Bytes escritos por volumen desde el arranque (panel de -dashboard).
+     *
+     * Los destinos de un solo volumen devuelven una lista vacía: sus bytes son los
+     * del pipeline.
+     */
+    virtual std::vector<VolumeUsage> volumeUsage() const { return {}; }
+};
+
+/**
+ * @class FileStorage
+ * @brief Guarda cada fotograma como un archivo en un directorio.
+ *
+ * Cada archivo se escribe con un nombre temporal (`.tmp`) y se renombra al terminar,
+ * así un corte a mitad de escritura nunca deja un fotograma truncado con nombre final.
+ */
+class FileStorage : public Storage {
+public:
+    /**
+     * @param directory Directorio de salida (debe existir).
+     */
+    explicit FileStorage(const std::string& directory);
+    bool write(const std::string& name, const std::vector<unsigned char>& data) override;
+    std::string describe() const override;
+    bool setDirectory(const std::string& directory) override;
+
+    /**
+     * @brief Borra los temporales huérfanos y continúa tras la mayor secuencia del directorio.
+     */
+    bool recover(uint64_t& nextSequence) override;
+
+private:
+    std::string directory;          ///< Directorio de salida.
+    mutable std::mutex mutex;       ///< Protege `directory` ante cambios en ejecución.
+};
+
+/**
+ * @class MemoryStorage
+ * @brief Sistema de archivos en memoria para simulaciones.
+ *
+ * No conserva el contenido: solo contabiliza archivos y bytes, y rechaza escrituras
+ * cuando se supera la capacidad configurada, simulando un disco lleno.
+ */
+class MemoryStorage : public Storage {
+public:
+    /**
+     * @param capacity Capacidad en bytes (0 = ilimitada).
+     */
+    explicit MemoryStorage(size_t capacity = 0);
+    bool write(const std::string& name, const std::vector<unsigned char>& data) override;
+    std::string describe() const override;
+
+    /**
+     * @brief Bytes almacenados hasta el momento.
+     */
+    size_t usedBytes() const { return used.load(); }
+
+private:
+    size_t capacity;                 ///< Capacidad en bytes (0 = ilimitada).
+    std::atomic<size_t> used{0};     ///< Bytes almacenados.
+    std::atomic<size_t> files{0};    ///< Archivos almacenados.
+    std::atomic<bool> fullReported{false}; ///< Evita repetir el aviso de disco lleno.
+};
+
+/**
+ * @brief Revisa un directorio de fotogramas: borra temporales `.tmp` y busca la mayor secuencia.
+ * @param directory Directorio a revisar.
+ * @param nextSequence Se eleva a la mayor secuencia encontrada + 1.
+ * @return true si había fotogramas.
+ */
+bool recoverFrameDirectory(const std::string& directory, uint64_t& nextSequence);
+
+#endif // STORAGE_H
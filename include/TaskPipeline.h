@@ -0,0 +1,105 @@
+#ifndef TASKPIPELINE_H
+#define TASKPIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ImageData.h"
+#include "ImageWriter.h"
+#include "TaskScheduler.h"
+#include "ThreadSafeQueue.h"
+
+/**
+ * @class TaskPipeline
+ * @brief Procesa los fotogramas del generador como tareas del TaskScheduler (`-runtime tasks`).
+ *
+ * Cada fotograma entregado se convierte en una tarea de codificación (y cifrado) cuya
+ * continuación es la tarea de escritura. La continuación se apila en el deque del
+ * trabajador que codificó, que normalmente la ejecuta a continuación con el buffer aún
+ * en caché; si otro trabajador está libre puede robarla y solapar la escritura con la
+ * siguiente codificación. Cada trabajador tiene su FrameProcessor.
+ *
+ * Como la cola de los escritores, admite un máximo de fotogramas en curso. Con
+ * `drop-oldest` y `drop-newest` se descarta el fotograma nuevo (un fotograma ya
+ * convertido en tarea no se puede retirar); con `block` el generador espera.
+ */
+class TaskPipeline : public FrameSink {
+public:
+    /**
+     * @param scheduler Pool de trabajadores.
+     * @param storage Destino de las imágenes codificadas.
+     * @param encoderSettings Formato del codificador.
+     * @param quality Calidad vigente.
+     * @param cipherSettings Cifrado en reposo.
+     * @param stats Contadores compartidos del pipeline.
+     * @param limiter Limitador de ancho de banda compartido (nullptr = sin límite).
+     * @param retries Cola de reintentos de escritura (nullptr = sin reintentos).
+     * @param maxInFlight Fotogramas en curso como máximo.
+     */
+    TaskPipeline(TaskScheduler& scheduler, Storage& storage, const EncoderSettings& encoderSettings,
+                 const std::atomic<int>& quality, const CipherSettings& cipherSettings, PipelineStats& stats,
+                 BandwidthLimiter* limiter = nullptr, RetryQueue* retries = nullptr, size_t maxInFlight = 100);
+
+    /**
+     * @brief Indica si los codificadores de todos los trabajadores se inicializaron.
+     */
+    bool isValid() const;
+
+    bool push(const ImageData& data) override;
+    size_t size() override { return inFlight.load(std::memory_order_acquire); }
+    size_t dropped() const override { return droppedCount.load(); }
+    size_t capacity() const override { return maxInFlight; }
+    bool waitIdle(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Cambia la política aplicada con el máximo de fotogramas en curso.
+     */
+    void setPolicy(QueuePolicy policy);
+
+    /**
+     * @brief Política actual.
+     */
+    QueuePolicy policy() const { return fullPolicy.load(); }
+
+    /**
+     * @brief Deja de aceptar fotogramas y espera a que terminen los que están en curso.
+     */
+    void finish();
+
+private:
+    /**
+     * @brief Tarea de codificación; envía la escritura como continuación.
+     */
+    void encodeTask(const ImageData& data);
+
+    /**
+     * @brief Tarea de escritura.
+     */
+    void writeTask(const EncodedFrame& frame);
+
+    /**
+     * @brief Fin de un fotograma (escrito, fallido o descartado).
+     */
+    void release();
+
+    TaskScheduler& scheduler;
+    Storage& storage;
+    const CipherSettings& cipherSettings;
+    PipelineStats& stats;
+    BandwidthLimiter* limiter;
+    RetryQueue* retries;
+    const size_t maxInFlight;
+
+    std::vector<std::unique_ptr<FrameProcessor>> processors; ///< Uno por trabajador.
+    std::atomic<size_t> inFlight{0};        ///< Fotogramas aceptados y no terminados.
+    std::atomic<size_t> droppedCount{0};    ///< Fotogramas descartados por el máximo en curso.
+    std::atomic<QueuePolicy> fullPolicy{QueuePolicy::DropOldest};
+    std::atomic<bool> done{false};
+    EventCount slots;                       ///< Generador esperando hueco con la política de bloqueo.
+    std::mutex idleMutex;
+    std::condition_variable idle;           ///< Aviso de que `inFlight` llegó a 0 (waitIdle).
+};
+
+#endif // TASKPIPELINE_H
@@ -0,0 +1,142 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EventCount.h"
+#include "ThreadTuning.h"
+#include "WorkStealingDeque.h"
+
+/**
+ * @class TaskScheduler
+ * @brief Pool de hilos con un deque de Chase-Lev por trabajador y robo de tareas.
+ *
+ * Una tarea enviada desde un trabajador (p. ej. la continuación de otra) se apila en su
+ * propio deque y ese trabajador la ejecuta a continuación, con los datos aún en caché;
+ * los trabajadores sin trabajo la roban por el otro extremo. Las tareas enviadas desde
+ * fuera del pool entran por una cola de inyección común. Un trabajador sin tareas gira
+ * brevemente y duerme en un EventCount.
+ */
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Contadores de un trabajador.
+     */
+    struct WorkerStats {
+        uint64_t tasks = 0;   ///< Tareas ejecutadas.
+        uint64_t steals = 0;  ///< Tareas robadas a otros trabajadores.
+        int64_t busyNs = 0;   ///< Tiempo ejecutando tareas.
+    };
+
+    /**
+     * @param workers Número de trabajadores; 0 usa uno por núcleo.
+     * @param tuning Prioridades que aplica cada trabajador al iniciar (las de los escritores).
+     */
+    explicit TaskScheduler(int workers = 0, const ThreadTuning& tuning = ThreadTuning());
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief Envía una tarea; desde un trabajador va a su deque, desde fuera a la cola de inyección.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Espera a que no queden tareas pendientes ni en ejecución.
+     */
+    void waitIdle();
+
+    /**
+     * @brief Termina los trabajadores tras las tareas pendientes.
+     */
+    void shutdown();
+
+    /**
+     * @brief Giro de los trabajadores sin tareas antes de dormir.
+     */
+    void setSpin(const SpinPolicy& policy) { work.setSpin(policy); }
+
+    /**
+     * @brief Número de trabajadores.
+     */
+    int size() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief Índice del trabajador que ejecuta el hilo actual, o -1 fuera del pool.
+     */
+    static int currentWorker();
+
+    /**
+     * @brief Tareas enviadas que aún no han terminado.
+     */
+    size_t pending() const { return pendingTasks.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Contadores de cada trabajador.
+     */
+    std::vector<WorkerStats> workerStats() const;
+
+    /**
+     * @brief Resumen: tareas, robos y ocupación de los trabajadores desde el arranque.
+     */
+    std::string report() const;
+
+private:
+    /**
+     * @brief Tarea en el heap; los deques guardan punteros.
+     */
+    struct TaskNode {
+        Task fn;
+    };
+
+    /**
+     * @brief Trabajador: su deque, contadores y hilo.
+     */
+    struct Worker {
+        WorkStealingDeque<TaskNode*> deque;
+        std::atomic<uint64_t> tasks{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<int64_t> busyNs{0};
+        uint64_t rng = 0;  ///< Estado xorshift para elegir víctimas (solo el dueño).
+        std::thread thread;
+    };
+
+    /**
+     * @brief Bucle de un trabajador.
+     */
+    void run(int index);
+
+    /**
+     * @brief Busca trabajo: deque propio, cola de inyección y robo a otros trabajadores.
+     */
+    TaskNode* findTask(Worker& self);
+
+    /**
+     * @brief Ejecuta una tarea y actualiza los contadores.
+     */
+    void execute(Worker& self, TaskNode* node);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    const ThreadTuning tuning;
+    std::mutex injectMutex;                 ///< Protege la cola de inyección.
+    std::deque<TaskNode*> injected;         ///< Tareas enviadas desde fuera del pool.
+    std::atomic<size_t> injectedCount{0};   ///< Tamaño de `injected` para comprobarlo sin el mutex.
+    std::atomic<size_t> pendingTasks{0};    ///< Tareas enviadas y no terminadas.
+    EventCount work;                        ///< Trabajadores dormidos esperando tareas.
+    EventCount idle;                        ///< Esperas de waitIdle().
+    std::atomic<bool> stopping{false};      ///< Pide a los trabajadores terminar.
+    const int64_t startNs;                  ///< Arranque, para la ocupación.
+};
+
+#endif // TASKSCHEDULER_H
@@ -3,10 +3,58 @@
 
 #include <queue>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
+#include <condition_variable>
+#include <string>
+#include "EventCount.h"
 #include "ImageData.h"
 
+/**
+ * @brief Política de la cola cuando está llena.
+ */
+enum class QueuePolicy {
+    DropOldest,  ///< Descarta el elemento más antiguo para encolar el nuevo.
+    DropNewest,  ///< Rechaza el elemento nuevo.
+    Block        ///< Bloquea al productor hasta que haya espacio.
+};
+
+/**
+ * @brief Interpreta el nombre de una política ("drop-oldest", "drop-newest", "block").
+ * @param name Nombre de la política.
+ * @param policy Resultado.
+ * @return true si el nombre es válido.
+ */
+bool parseQueuePolicy(const std::string& name, QueuePolicy& policy);
+
+/**
+ * @brief Nombre de una política de cola.
+ */
+const char* queuePolicyName(QueuePolicy policy);
+
+/**
+ * @brief Giro antes de dormir de cada etapa que espera en la cola.
+ */
+struct QueueSpin {
+    SpinPolicy writers;    ///< Consumidores (escritores) esperando fotogramas.
+    SpinPolicy generator;  ///< Productor esperando espacio con la política de bloqueo.
+};
+
+/**
+ * @brief Interpreta un giro por etapa: "writers=US,generator=US" o "US" (escritores).
+ *
+ * Los valores son microsegundos; solo cambia los presupuestos de las etapas indicadas.
+ *
+ * @param spec Texto de la opción.
+ * @param spin Resultado.
+ * @return true si el texto es válido.
+ */
+bool parseQueueSpin(const std::string& spec, QueueSpin& spin);
+
+/**
+ * @brief Descripción legible del giro de las etapas.
+ */
+std::string describeQueueSpin(const QueueSpin& spin);
+
 /**
  * @class ThreadSafeQueue
  * @brief Cola de imágenes segura para múltiples hilos (thread-safe).
@@ -14,17 +62,27 @@
  * Esta clase permite que múltiples hilos productores y consumidores accedan
  * concurrentemente a una cola de objetos `ImageData` sin condiciones de carrera.
  * 
- * Utiliza `std::mutex` para garantizar la exclusión mutua, y `std::condition_variable`
- * para la sincronización entre productores y consumidores.
+ * Utiliza `std::mutex` para garantizar la exclusión mutua, y dos EventCount sobre futex
+ * para la sincronización entre productores y consumidores: push y pop solo hacen una
+ * syscall de despertar cuando hay un hilo dormido esperando (ver EventCount).
  */
-class ThreadSafeQueue {
+class ThreadSafeQueue : public FrameSink {
 private:
     std::queue<ImageData> queue;                    ///< Cola interna de imágenes.
     std::mutex mutex;                               ///< Mutex para proteger el acceso concurrente a la cola.
-    std::condition_variable cv;                     ///< Variable de condición para notificar cuando la cola no está vacía.
-    std::condition_variable cv_full;                ///< Variable de condición para notificar cuando hay espacio disponible.
+    EventCount notEmpty;                            ///< Espera de los consumidores a que haya elementos.
+    EventCount notFull;                             ///< Espera del productor a que haya espacio (política de bloqueo).
     std::atomic<bool> done{false};                  ///< Indica si se ha terminado de generar imágenes.
     size_t max_size;                                ///< Tamaño máximo permitido para la cola.
+    std::atomic<QueuePolicy> fullPolicy{QueuePolicy::DropOldest}; ///< Política cuando la cola está llena.
+    std::atomic<size_t> droppedCount{0};            ///< Elementos descartados por la política.
+    size_t unfinished = 0;                          ///< Encolados y sin taskDone() (en la cola o en proceso).
+    std::condition_variable idle;                   ///< Aviso de que `unfinished` llegó a 0.
+
+    /**
+     * @brief Extrae el frente si lo hay; requiere tener el mutex.
+     */
+    bool tryPopLocked(ImageData& result);
 
 public:
     /**
@@ -37,11 +95,13 @@ public:
     /**
      * @brief Inserta un nuevo dato en la cola.
      * 
-     * Bloquea si la cola está llena hasta que haya espacio disponible o se haya terminado.
+     * Si la cola está llena aplica la política configurada: descarta el elemento más
+     * antiguo, rechaza el nuevo o bloquea hasta que haya espacio o se haya terminado.
      * 
      * @param data Imagen a insertar.
+     * @return true si el dato quedó encolado.
      */
-    bool push(const ImageData& data);
+    bool push(const ImageData& data) override;
 
     /**
      * @brief Extrae un dato de la cola.
@@ -53,6 +113,53 @@ public:
      */
     bool pop(ImageData& result);
 
+    /**
+     * @brief Extrae un dato de la cola, abandonando la espera si se activa `cancel`.
+     * 
+     * @param result Referencia donde se almacenará el dato extraído.
+     * @param cancel Indicador de cancelación; se comprueba al despertar (ver wakeAll()).
+     * @return true si se extrajo un dato, false si se canceló o la cola está terminada y vacía.
+     */
+    bool pop(ImageData& result, const std::atomic<bool>& cancel);
+
+    /**
+     * @brief Marca como terminado un dato extraído con pop().
+     *
+     * Cada consumidor lo llama después de procesar (escribir o descartar) el dato; así
+     * waitIdle() no da la cola por ociosa mientras un fotograma se codifica o se escribe.
+     */
+    void taskDone();
+
+    /**
+     * @brief Espera a que todos los datos encolados estén terminados (ver taskDone()).
+     *
+     * @param timeout Espera máxima en tiempo real.
+     * @return true si no queda ningún dato en la cola ni en proceso.
+     */
+    bool waitIdle(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Despierta a todos los consumidores bloqueados para que revisen su cancelación.
+     */
+    void wakeAll();
+
+    /**
+     * @brief Cambia la política aplicada cuando la cola está llena.
+     * 
+     * @param policy Nueva política; se aplica desde la siguiente inserción.
+     */
+    void setPolicy(QueuePolicy policy);
+
+    /**
+     * @brief Política actual de la cola.
+     */
+    QueuePolicy policy() const;
+
+    /**
+     * @brief Número de elementos descartados por la política de cola llena.
+     */
+    size_t dropped() const override;
+
     /**
      * @brief Marca la cola como terminada, notificando a todos los hilos bloqueados.
      */
@@ -70,7 +177,32 @@ public:
      * 
      * @return Número de elementos en la cola.
      */
-    size_t size();
+    size_t size() override;
+
+    /**
+     * @brief Tamaño máximo de la cola.
+     */
+    size_t capacity() const override;
+
+    /**
+     * @brief Contadores de espera de productores y consumidores (syscalls y latencia de despertar).
+     */
+    EventCountStats waitStats() const;
+
+    /**
+     * @brief Contadores de espera de los consumidores.
+     */
+    EventCountStats consumerWaitStats() const;
+
+    /**
+     * @brief Contadores de espera del productor.
+     */
+    EventCountStats producerWaitStats() const;
+
+    /**
+     * @brief Giro antes de dormir de consumidores y productor.
+     */
+    void setSpin(const QueueSpin& spin);
 };
 
 #endif // THREADSAFEQUEUE_H
@@ -0,0 +1,78 @@
+#ifndef THREADTUNING_H
+#define THREADTUNING_H
+
+#include <string>
+
+/**
+ * @brief Opciones de planificación y prioridad de E/S para los hilos del pipeline.
+ *
+ * El hilo generador (sustituto del hilo de ingesta de la cámara) puede usar una
+ * política de tiempo real; los escritores, que codifican y escriben, pueden bajar su
+ * prioridad de CPU (nice / SCHED_BATCH) y recibir una clase de prioridad de E/S.
+ * Las políticas de tiempo real y la clase de E/S "rt" requieren CAP_SYS_NICE.
+ */
+struct ThreadTuning {
+    int realtimePolicy = 0;     ///< 0 (sin cambio), SCHED_FIFO o SCHED_RR para el generador.
+    int realtimePriority = 0;   ///< Prioridad de tiempo real (1-99).
+    int writerNice = 0;         ///< Valor nice de los escritores (0 = sin cambio).
+    bool writerBatch = false;   ///< Usa SCHED_BATCH en los escritores.
+    int ioClass = 0;            ///< Clase de E/S de los escritores: 0 (sin cambio), 1 rt, 2 be, 3 idle.
+    int ioLevel = 4;            ///< Nivel dentro de la clase de E/S (0 = más prioritario, 7 = menos).
+    bool lockMemory = false;    ///< Bloquea en RAM toda la memoria del proceso (mlockall).
+};
+
+/**
+ * @brief Interpreta una política de tiempo real, p. ej. "fifo:80" o "rr:50".
+ * @param spec Texto a interpretar.
+ * @param tuning Opciones donde se guarda el resultado.
+ * @return true si el texto es válido.
+ */
+bool parseRealtimeSpec(const std::string& spec, ThreadTuning& tuning);
+
+/**
+ * @brief Interpreta una clase de prioridad de E/S, p. ej. "rt:2", "be:7" o "idle".
+ * @param spec Texto a interpretar.
+ * @param tuning Opciones donde se guarda el resultado.
+ * @return true si el texto es válido.
+ */
+bool parseIoPrioritySpec(const std::string& spec, ThreadTuning& tuning);
+
+/**
+ * @brief Aplica al hilo actual la política de tiempo real configurada.
+ * @param tuning Opciones de planificación.
+ * @return true si se aplicó o no había nada que aplicar.
+ */
+bool applyGeneratorTuning(const ThreadTuning& tuning);
+
+/**
+ * @brief Aplica al hilo actual las prioridades de CPU y de E/S de los escritores.
+ * @param tuning Opciones de planificación.
+ * @return true si se aplicaron o no había nada que aplicar.
+ */
+bool applyWriterTuning(const ThreadTuning& tuning);
+
+/**
+ * @brief Fija el hilo actual a un núcleo de los permitidos al proceso.
+ * @param index Índice dentro de la máscara de afinidad del proceso (se toma módulo su tamaño).
+ * @return true si se fijó.
+ */
+bool pinCurrentThread(int index);
+
+/**
+ * @brief Núcleos permitidos al proceso (máscara de afinidad).
+ */
+int availableCores();
+
+/**
+ * @brief Bloquea en RAM la memoria actual y futura del proceso si se pidió.
+ * @param tuning Opciones de planificación.
+ * @return true si se aplicó o no había nada que aplicar.
+ */
+bool applyMemoryLock(const ThreadTuning& tuning);
+
+/**
+ * @brief Descripción legible de las opciones configuradas.
+ */
+std::string describeThreadTuning(const ThreadTuning& tuning);
+
+#endif // THREADTUNING_H
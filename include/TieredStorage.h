@@ -0,0 +1,125 @@
+#ifndef TIEREDSTORAGE_H
+#define TIEREDSTORAGE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Storage.h"
+
+/**
+ * @class TieredStorage
+ * @brief Almacenamiento en dos niveles: aterrizaje rápido y migración en segundo plano.
+ *
+ * Los escritores guardan cada fotograma en un volumen rápido (NVMe o tmpfs). Un hilo
+ * migrador mueve los archivos ya cerrados al volumen masivo con copias secuenciales
+ * grandes (`copy_file_range` cuando el núcleo lo admite) y los borra del aterrizaje.
+ *
+ * Si el aterrizaje supera la marca de agua, los escritores esperan a que el migrador
+ * libere espacio; la presión se propaga a la cola y actúa su política habitual.
+ */
+class TieredStorage : public Storage {
+public:
+    /**
+     * @param landingDirectory Directorio del nivel rápido (debe existir).
+     * @param bulkDirectory Directorio del nivel masivo (debe existir).
+     * @param watermark Bytes máximos pendientes en el aterrizaje (0 = sin límite).
+     */
+    TieredStorage(const std::string& landingDirectory, const std::string& bulkDirectory, size_t watermark);
+    ~TieredStorage() override;
+
+    TieredStorage(const TieredStorage&) = delete;
+    TieredStorage& operator=(const TieredStorage&) = delete;
+
+    bool write(const std::string& name, const std::vector<unsigned char>& data) override;
+    std::string describe() const override;
+
+    /**
+     * @brief Cambia el directorio masivo de las siguientes escrituras.
+     *
+     * Los archivos ya aterrizados se migran al directorio vigente cuando se escribieron.
+     */
+    bool setDirectory(const std::string& directory) override;
+
+    /**
+     * @brief Continúa la numeración tras la mayor secuencia del aterrizaje y del volumen masivo.
+     */
+    bool recover(uint64_t& nextSequence) override;
+
+    /**
+     * @brief Espera a que el migrador vacíe el aterrizaje y lo detiene.
+     */
+    void drain();
+
+    /**
+     * @brief Bytes pendientes de migrar en el aterrizaje.
+     */
+    size_t landingBytes() const { return pendingBytes.load(); }
+
+    /**
+     * @brief Informe de la migración: archivos, bytes, retraso y throughput.
+     */
+    std::string report() const;
+
+    /**
+     * @brief Bytes aterrizados (incluidos los ya migrados) y bytes migrados al volumen masivo.
+     */
+    std::vector<VolumeUsage> volumeUsage() const override;
+
+private:
+    /**
+     * @brief Archivo aterrizado pendiente de migrar.
+     */
+    struct Pending {
+        std::string name;                              ///< Nombre del archivo.
+        std::string bulkDirectory;                     ///< Destino vigente al escribirlo.
+        size_t size = 0;                               ///< Tamaño en bytes.
+        int attempts = 0;                              ///< Intentos de migración fallidos.
+        std::chrono::steady_clock::time_point landed;  ///< Instante en que quedó cerrado.
+    };
+
+    /**
+     * @brief Bucle del hilo migrador.
+     */
+    void migrateLoop();
+
+    /**
+     * @brief Mueve un archivo del aterrizaje al volumen masivo.
+     * @param item Archivo a mover.
+     * @return true si quedó completo en el destino y se borró del aterrizaje.
+     */
+    bool migrate(const Pending& item);
+
+    /**
+     * @brief Encola los archivos que quedaron en el aterrizaje de una ejecución anterior.
+     */
+    void adoptLeftovers();
+
+    std::string landingDirectory;   ///< Directorio del nivel rápido.
+    std::string bulkDirectory;      ///< Directorio masivo vigente.
+    size_t watermark;               ///< Bytes máximos en el aterrizaje (0 = sin límite).
+
+    mutable std::mutex mutex;       ///< Protege la cola de migración y `bulkDirectory`.
+    std::condition_variable workAvailable;   ///< Avisa al migrador de archivos nuevos.
+    std::condition_variable spaceAvailable;  ///< Avisa a los escritores de espacio liberado.
+    std::deque<Pending> pending;    ///< Archivos cerrados pendientes de migrar.
+    bool stopping = false;          ///< Indica al migrador que termine al vaciar la cola.
+    std::thread migrator;           ///< Hilo migrador.
+
+    std::atomic<size_t> pendingBytes{0};      ///< Bytes aterrizados sin migrar.
+    std::atomic<size_t> peakLandingBytes{0};  ///< Máximo de bytes en el aterrizaje.
+    std::atomic<size_t> migratedFiles{0};     ///< Archivos migrados.
+    std::atomic<size_t> migratedBytes{0};     ///< Bytes migrados.
+    std::atomic<size_t> failedFiles{0};       ///< Archivos que quedaron sin migrar al terminar.
+    std::atomic<size_t> migrateRetries{0};    ///< Migraciones fallidas que se reintentaron.
+    std::atomic<size_t> watermarkWaits{0};    ///< Escrituras que esperaron por la marca de agua.
+    std::atomic<int64_t> busyNs{0};           ///< Tiempo del migrador copiando.
+    std::atomic<int64_t> totalLagNs{0};       ///< Suma de retrasos aterrizaje → masivo.
+    std::atomic<int64_t> maxLagNs{0};         ///< Mayor retraso aterrizaje → masivo.
+};
+
+#endif // TIEREDSTORAGE_H
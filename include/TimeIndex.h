@@ -0,0 +1,162 @@
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Cabecera del archivo de índice temporal (32 bytes, little-endian).
+ */
+struct TimeIndexHeader {
+    uint32_t magic;       ///< kTimeIndexMagic.
+    uint32_t version;     ///< Versión del formato (1).
+    uint32_t entrySize;   ///< sizeof(TimeIndexEntry).
+    uint32_t reserved;    ///< Reservado (0).
+    int64_t intervalNs;   ///< Intervalo de tiempo máximo cubierto por una entrada.
+    int64_t slackNs;      ///< Desorden máximo admitido entre marcas de tiempo.
+};
+
+/**
+ * @brief Entrada del índice: un bloque contiguo de registros de un segmento.
+ *
+ * `upToTs` es la mayor marca de tiempo de este bloque y de todos los anteriores, por
+ * lo que crece de forma monótona y permite la búsqueda binaria aunque los escritores
+ * terminen los fotogramas fuera de orden.
+ */
+struct TimeIndexEntry {
+    uint64_t segment;  ///< Número de segmento.
+    uint64_t offset;   ///< Posición del primer registro del bloque.
+    uint64_t length;   ///< Bytes del bloque.
+    int64_t minTs;     ///< Menor marca de tiempo del bloque (ns desde la época).
+    int64_t maxTs;     ///< Mayor marca de tiempo del bloque.
+    int64_t upToTs;    ///< Mayor marca de tiempo hasta este bloque inclusive.
+};
+
+static_assert(sizeof(TimeIndexHeader) == 32, "la cabecera del índice temporal debe ocupar 32 bytes");
+static_assert(sizeof(TimeIndexEntry) == 48, "las entradas del índice temporal deben ocupar 48 bytes");
+
+/// Marca del archivo de índice temporal ("FCTI").
+constexpr uint32_t kTimeIndexMagic = 0x49544346u;
+
+/**
+ * @class TimeIndexWriter
+ * @brief Construye el índice temporal disperso de una grabación en segmentos.
+ *
+ * Agrupa los registros consecutivos de un segmento en bloques que cubren como mucho
+ * `intervalNs` y añade una entrada de tamaño fijo por bloque, así el índice crece con
+ * la duración y no con el número de fotogramas. No es seguro para uso concurrente;
+ * SegmentStorage lo usa con su mutex tomado.
+ */
+class TimeIndexWriter {
+public:
+    TimeIndexWriter() = default;
+    ~TimeIndexWriter();
+
+    TimeIndexWriter(const TimeIndexWriter&) = delete;
+    TimeIndexWriter& operator=(const TimeIndexWriter&) = delete;
+
+    /**
+     * @brief Abre (o crea) el índice para añadir entradas.
+     *
+     * Un índice existente conserva su cabecera; una entrada incompleta al final se descarta.
+     *
+     * @param path Ruta del archivo.
+     * @param intervalNs Intervalo máximo por entrada.
+     * @param slackNs Desorden máximo admitido entre marcas de tiempo.
+     * @return false si no se pudo abrir o la cabecera no es válida.
+     */
+    bool open(const std::string& path, int64_t intervalNs, int64_t slackNs);
+
+    /**
+     * @brief Descarta las entradas que apuntan más allá de los datos recuperados.
+     * @param segmentLength Longitud válida de cada segmento.
+     * @param segment Segmento donde termina la última entrada conservada.
+     * @param offset Posición donde termina la última entrada conservada.
+     * @return false si no queda ninguna entrada.
+     */
+    bool trim(const std::function<uint64_t(uint64_t)>& segmentLength, uint64_t& segment, uint64_t& offset);
+
+    /**
+     * @brief Añade un registro al bloque abierto, cerrándolo si no es contiguo o excede el intervalo.
+     * @return false si falló la escritura de una entrada.
+     */
+    bool add(uint64_t segment, uint64_t offset, uint64_t size, int64_t timestampNs);
+
+    /**
+     * @brief Escribe la entrada del bloque abierto.
+     */
+    bool flush();
+
+    /**
+     * @brief Sincroniza el archivo con el disco.
+     */
+    bool sync();
+
+    /**
+     * @brief Escribe el bloque abierto y cierra el archivo.
+     */
+    void close();
+
+    /**
+     * @brief Indica si el índice está abierto.
+     */
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * @brief Número de entradas escritas en el archivo.
+     */
+    size_t entries() const { return count; }
+
+private:
+    bool append(const TimeIndexEntry& entry);
+
+    int fd = -1;                   ///< Descriptor del archivo.
+    int64_t intervalNs = 0;        ///< Intervalo máximo por entrada.
+    size_t count = 0;              ///< Entradas en el archivo.
+    bool blockOpen = false;        ///< Hay un bloque en construcción.
+    TimeIndexEntry block{};        ///< Bloque en construcción.
+    int64_t upTo = INT64_MIN;      ///< Mayor marca de tiempo ya indexada.
+};
+
+/**
+ * @class TimeIndexReader
+ * @brief Acceso de solo lectura al índice temporal mediante mmap.
+ *
+ * La búsqueda es binaria sobre `upToTs`, así que su coste no depende de la duración
+ * de la grabación.
+ */
+class TimeIndexReader {
+public:
+    TimeIndexReader() = default;
+    ~TimeIndexReader();
+
+    TimeIndexReader(const TimeIndexReader&) = delete;
+    TimeIndexReader& operator=(const TimeIndexReader&) = delete;
+
+    /**
+     * @brief Proyecta el índice en memoria.
+     * @return false si no existe o la cabecera no es válida.
+     */
+    bool open(const std::string& path);
+
+    size_t size() const { return count; }
+    const TimeIndexEntry& operator[](size_t i) const { return entries[i]; }
+    int64_t slackNs() const { return header ? header->slackNs : 0; }
+
+    /**
+     * @brief Primera entrada que puede contener marcas de tiempo >= `timestampNs`.
+     * @return Índice de la entrada, o size() si ninguna.
+     */
+    size_t lowerBound(int64_t timestampNs) const;
+
+private:
+    void* mapping = nullptr;                 ///< Región proyectada.
+    size_t mappingSize = 0;                  ///< Tamaño de la región.
+    const TimeIndexHeader* header = nullptr; ///< Cabecera dentro de la región.
+    const TimeIndexEntry* entries = nullptr; ///< Entradas dentro de la región.
+    size_t count = 0;                        ///< Número de entradas completas.
+};
+
+#endif // TIMEINDEX_H
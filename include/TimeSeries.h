@@ -0,0 +1,98 @@
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include <array>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Clock.h"
+#include "ImageData.h"
+#include "PipelineStats.h"
+
+/**
+ * @class TimeSeriesRecorder
+ * @brief Serie temporal de la ejecución: una fila CSV por intervalo, escrita por un hilo aparte.
+ *
+ * El hilo de muestreo solo lee los contadores atómicos de PipelineStats, los
+ * histogramas de latencia y el tamaño de la cola; los escritores no hacen nada
+ * adicional por él. Cada fila lleva lo ocurrido desde la anterior:
+ *
+ *     t_s,generadas,encoladas,descartadas,guardadas,bytes,cola,p99_codificacion_us,p99_escritura_us,fps_por_escritor
+ *
+ * `t_s` es el final del intervalo en segundos desde el arranque del registro (en el
+ * reloj configurado: virtual con -sim), `cola` la profundidad en ese instante y
+ * `fps_por_escritor` una lista `id:fps` separada por `;` de los escritores que han
+ * guardado algo. Con reloj virtual el tiempo avanza a saltos y una fila puede cubrir
+ * más de un intervalo. Cada fila se vuelca al escribirse, así una ejecución
+ * interrumpida conserva todo lo muestreado.
+ */
+class TimeSeriesRecorder {
+public:
+    /**
+     * @param path Archivo CSV (se sobrescribe).
+     * @param intervalSeconds Segundos de reloj por fila.
+     * @param stats Contadores del pipeline.
+     * @param sink Cola o pipeline (profundidad y descartes).
+     * @param clock Reloj del generador.
+     */
+    TimeSeriesRecorder(const std::string& path, double intervalSeconds, const PipelineStats& stats,
+                       FrameSink& sink, Clock& clock);
+    ~TimeSeriesRecorder();
+
+    /**
+     * @brief Abre el archivo y lanza el hilo de muestreo.
+     * @return false si no se pudo abrir el archivo.
+     */
+    bool start();
+
+    /**
+     * @brief Escribe la última fila (intervalo parcial) y detiene el hilo.
+     */
+    void stop();
+
+    /**
+     * @brief Filas escritas.
+     */
+    size_t rows() const { return rowCount; }
+
+    /**
+     * @brief Descripción para la configuración, p. ej. "serie.csv cada 1 s".
+     */
+    std::string describe() const;
+
+private:
+    /// Valores acumulados en el instante de la fila anterior.
+    struct Snapshot {
+        Clock::time_point time;
+        size_t generated = 0;
+        size_t enqueued = 0;
+        size_t dropped = 0;
+        size_t saved = 0;
+        size_t bytes = 0;
+        LatencyHistogram::Counts encode{};
+        LatencyHistogram::Counts write{};
+        std::array<size_t, kMaxWriterStats> byWriter{};
+    };
+
+    void run();
+    Snapshot capture(Clock::time_point now) const;
+    void writeRow(const Snapshot& current);
+
+    const std::string path;
+    const Clock::duration interval;
+    const PipelineStats& stats;
+    FrameSink& sink;
+    Clock& clock;
+    std::ofstream out;
+    Snapshot previous;
+    Clock::time_point origin;
+    size_t rowCount = 0;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread sampler;
+};
+
+#endif // TIMESERIES_H
@@ -1,9 +1,12 @@
 #ifndef TURBOJPEGWRITER_H
 #define TURBOJPEGWRITER_H
 
-#include <opencv2/core.hpp>
 #include <string>
+#include <vector>
+#include "Encoder.h"
+#include "PixelKernels.h"
 
+#ifdef FASTCAP_HAVE_OPENCV
 /**
  * @brief Escribe una imagen JPEG usando libjpeg-turbo.
  *
@@ -13,5 +16,104 @@
  * @return true si la imagen se guardó correctamente, false en caso de error.
  */
 bool writeJPEG_turbo(const cv::Mat& image, const std::string& filename, int quality = 90);
+#endif
+
+/**
+ * @class TurboJPEGEncoder
+ * @brief Codificador JPEG con libjpeg-turbo que reutiliza el manejador y el buffer de salida.
+ *
+ * A diferencia de writeJPEG_turbo, el manejador TurboJPEG se crea una sola vez y el
+ * buffer comprimido se preasigna con `tjBufSize`, evitando reservas por fotograma.
+ * El formato de píxel, el submuestreo y la conversión a 8 bits salen de la tabla de
+ * núcleos elegida al construirlo, sin comprobar el tipo en cada fotograma. Las opciones
+ * JPEG (submuestreo, DCT y codificación progresiva) se resuelven también al construirlo.
+ */
+class TurboJPEGEncoder : public Encoder {
+public:
+    /**
+     * @param quality Calidad JPEG entre 0 y 100.
+     * @param kernels Núcleos del formato de los fotogramas (nullptr = BGR de 8 bits).
+     * @param options Submuestreo, DCT y codificación; los formatos de un canal siempre se guardan en gris.
+     */
+    explicit TurboJPEGEncoder(int quality = 90, const PixelKernels* kernels = nullptr,
+                              const JpegOptions& options = JpegOptions());
+    ~TurboJPEGEncoder() override;
+
+    TurboJPEGEncoder(const TurboJPEGEncoder&) = delete;
+    TurboJPEGEncoder& operator=(const TurboJPEGEncoder&) = delete;
+
+    bool encode(const Frame& image, std::vector<unsigned char>& out) override;
+    const char* extension() const override { return "jpg"; }
+    void setQuality(int newQuality) override { quality = newQuality; }
+
+    /**
+     * @brief Indica si el manejador TurboJPEG se inicializó correctamente.
+     */
+    bool isValid() const { return compressor != nullptr; }
+
+private:
+    void* compressor = nullptr;         ///< Manejador TurboJPEG (tjhandle).
+    unsigned char* jpegBuf = nullptr;   ///< Buffer comprimido preasignado.
+    unsigned long jpegBufSize = 0;      ///< Capacidad del buffer comprimido.
+    int quality;                        ///< Calidad JPEG.
+    int subsampling;                    ///< Submuestreo TurboJPEG (TJSAMP_*).
+    int flags;                          ///< Opciones de tjCompress2 (DCT, progresivo, sin realloc).
+    const PixelKernels& kernels;        ///< Núcleos del formato de los fotogramas.
+    Frame scratch;                      ///< Entrada de 8 bits reutilizada (formatos de 16 bits).
+};
+
+/**
+ * @class TurboJPEG3Encoder
+ * @brief Codificador JPEG de 12 bits y sin pérdida con la API de TurboJPEG 3 (tj3).
+ *
+ * La API tjCompress2 solo produce JPEG de 8 bits con pérdida. Este codificador usa un
+ * manejador tj3 reutilizado, configurado con tj3Set al construirlo (calidad,
+ * submuestreo, DCT, progresivo o sin pérdida), y un buffer comprimido que TurboJPEG
+ * amplía si hace falta y se conserva entre fotogramas:
+ *
+ * - **12 bits con pérdida** (`tj3Compress12`): los 12 bits altos de los fotogramas `gray16`.
+ * - **Sin pérdida** (`TJPARAM_LOSSLESS`): de 16 bits con `tj3Compress16` o de 12 bits con
+ *   `tj3Compress12` para `gray16`; con 8 bits, la entrada de 8 bits de cualquier formato.
+ *
+ * Con 8 bits la entrada sale de los núcleos del formato, como en TurboJPEGEncoder. Sin
+ * TurboJPEG 3 al compilar, isValid() devuelve false.
+ */
+class TurboJPEG3Encoder : public Encoder {
+public:
+    /**
+     * @param quality Calidad JPEG entre 1 y 100 (se ignora sin pérdida).
+     * @param kernels Núcleos del formato de los fotogramas.
+     * @param options Precisión, sin pérdida, submuestreo, DCT y codificación.
+     */
+    TurboJPEG3Encoder(int quality, const PixelKernels& kernels, const JpegOptions& options);
+    ~TurboJPEG3Encoder() override;
+
+    TurboJPEG3Encoder(const TurboJPEG3Encoder&) = delete;
+    TurboJPEG3Encoder& operator=(const TurboJPEG3Encoder&) = delete;
+
+    bool encode(const Frame& image, std::vector<unsigned char>& out) override;
+    const char* extension() const override { return "jpg"; }
+    void setQuality(int newQuality) override;
+
+    /**
+     * @brief Indica si el manejador TurboJPEG 3 se inicializó correctamente.
+     */
+    bool isValid() const { return compressor != nullptr; }
+
+    /**
+     * @brief Indica si se compiló con TurboJPEG 3.
+     */
+    static bool available();
+
+private:
+    void* compressor = nullptr;         ///< Manejador tj3 (tjhandle).
+    unsigned char* jpegBuf = nullptr;   ///< Buffer comprimido reutilizado (tj3Alloc).
+    size_t jpegBufSize = 0;             ///< Capacidad conocida del buffer comprimido.
+    const PixelKernels& kernels;        ///< Núcleos del formato de los fotogramas.
+    const int precision;                ///< Bits por muestra: 8, 12 o 16.
+    const bool lossless;                ///< JPEG sin pérdida.
+    Frame scratch;                      ///< Entrada de 8 bits reutilizada (formatos de 16 bits).
+    std::vector<short> samples12;       ///< Muestras de 12 bits reutilizadas.
+};
 
 #endif // TURBOJPEGWRITER_H
@@ -23,4 +23,25 @@ bool createDirectoryIfNotExists(const std::string& path);
  */
 std::string formatByteSize(size_t bytes);
 
+/**
+ * @brief Interpreta un tamaño con sufijo opcional (K, M, G, T), p. ej. "200M"
+ * @param text Texto a interpretar
+ * @param bytes Resultado en bytes
+ * @return true si el texto es un tamaño válido
+ */
+bool parseByteSize(const std::string& text, size_t& bytes);
+
+/**
+ * @brief Comprueba que un nombre leído de un índice sea un único componente de ruta
+ * @param name Nombre a comprobar
+ * @return false si está vacío, es "." o "..", o contiene '/' o un carácter nulo
+ */
+bool isPlainFileName(const std::string& name);
+
+/**
+ * @brief Tiempo de CPU (usuario + sistema) consumido por el proceso
+ * @return Segundos de CPU sumando todos los hilos
+ */
+double processCpuSeconds();
+
 #endif // UTILS_H
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class WorkStealingDeque
+ * @brief Deque de Chase-Lev: el dueño apila y desapila por abajo; los ladrones roban por arriba.
+ *
+ * Implementación de "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê, Pop, Cohen y Zappa Nardelli, 2013). push y pop solo los llama el hilo dueño y no
+ * usan CAS salvo al disputar el último elemento; steal puede llamarse desde cualquier
+ * hilo. El arreglo circular crece al llenarse; los arreglos viejos se conservan hasta
+ * destruir el deque porque un ladrón puede estar leyéndolos.
+ *
+ * @tparam T Tipo trivialmente copiable (normalmente un puntero).
+ */
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque requiere un tipo trivialmente copiable");
+
+public:
+    /**
+     * @param capacity Capacidad inicial (se redondea a potencia de dos).
+     */
+    explicit WorkStealingDeque(size_t capacity = 256) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        arrays.push_back(std::make_unique<Array>(rounded));
+        array.store(arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Apila un elemento (solo el dueño).
+     */
+    void push(T item) {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(a->capacity) - 1) {
+            a = grow(a, b, t);
+        }
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Desapila el último elemento apilado (solo el dueño).
+     * @return true si había un elemento.
+     */
+    bool pop(T& item) {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Vacío
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = a->get(b);
+        if (t == b) {
+            // Último elemento: se disputa con los ladrones
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Roba el elemento más antiguo (cualquier hilo).
+     * @return true si robó un elemento; false si estaba vacío o perdió la disputa.
+     */
+    bool steal(T& item) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+
+        Array* a = array.load(std::memory_order_acquire);
+        item = a->get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Elementos aproximados (puede estar desactualizado si otros hilos operan).
+     */
+    size_t size() const {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+private:
+    /**
+     * @brief Arreglo circular de capacidad potencia de dos.
+     */
+    struct Array {
+        explicit Array(size_t capacity) : capacity(capacity), mask(capacity - 1), slots(capacity) {}
+
+        T get(int64_t index) const { return slots[index & mask].load(std::memory_order_relaxed); }
+        void put(int64_t index, T item) { slots[index & mask].store(item, std::memory_order_relaxed); }
+
+        size_t capacity;
+        size_t mask;
+        std::vector<std::atomic<T>> slots;
+    };
+
+    /**
+     * @brief Duplica el arreglo copiando los elementos vivos (solo el dueño).
+     */
+    Array* grow(Array* old, int64_t b, int64_t t) {
+        arrays.push_back(std::make_unique<Array>(old->capacity * 2));
+        Array* bigger = arrays.back().get();
+        for (int64_t i = t; i < b; i++) {
+            bigger->put(i, old->get(i));
+        }
+        array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<int64_t> top{0};     ///< Extremo de los ladrones.
+    alignas(64) std::atomic<int64_t> bottom{0};  ///< Extremo del dueño.
+    std::atomic<Array*> array{nullptr};          ///< Arreglo vigente.
+    std::vector<std::unique_ptr<Array>> arrays;  ///< Arreglos creados (el dueño los libera al destruir).
+};
+
+#endif // WORKSTEALINGDEQUE_H
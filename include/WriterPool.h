@@ -0,0 +1,130 @@
+#ifndef WRITERPOOL_H
+#define WRITERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ThreadSafeQueue.h"
+#include "Encoder.h"
+#include "Storage.h"
+#include "PipelineStats.h"
+#include "ThreadTuning.h"
+#include "RateLimiter.h"
+#include "FrameCipher.h"
+#include "ImageWriter.h"
+
+/**
+ * @class WriterPool
+ * @brief Conjunto de hilos escritores cuyo tamaño puede cambiar durante la ejecución.
+ *
+ * Al reducir el conjunto, los hilos retirados terminan el fotograma que estén
+ * procesando y salen; el resto del pipeline no se detiene. Los hilos nuevos reciben
+ * identificadores que no se reutilizan, para que los nombres de archivo sigan siendo únicos.
+ *
+ * Con el watchdog activo, un hilo que supera el umbral de bloqueo en una etapa (salvo la
+ * espera del limitador) se retira como si se redujera el conjunto: deja de consumir de
+ * la cola en cuanto su operación retorne. Si el presupuesto de hilos lo permite se lanza
+ * un reemplazo, así el número de escritores activos se mantiene.
+ */
+class WriterPool {
+public:
+    /**
+     * @param queue Cola de donde consumen los escritores.
+     * @param storage Destino de las imágenes codificadas.
+     * @param encoderSettings Formato del codificador.
+     * @param quality Calidad vigente, compartida con los escritores.
+     * @param cipherSettings Cifrado en reposo de los fotogramas codificados.
+     * @param stats Contadores compartidos del pipeline.
+     * @param tuning Prioridades de CPU y de E/S que aplica cada escritor al iniciar.
+     * @param limiter Limitador de ancho de banda compartido (nullptr = sin límite).
+     * @param retries Cola de reintentos de escritura compartida (nullptr = sin reintentos).
+     */
+    WriterPool(ThreadSafeQueue& queue, Storage& storage, const EncoderSettings& encoderSettings,
+               const std::atomic<int>& quality, const CipherSettings& cipherSettings,
+               PipelineStats& stats, const ThreadTuning& tuning,
+               BandwidthLimiter* limiter = nullptr, RetryQueue* retries = nullptr);
+    ~WriterPool();
+
+    WriterPool(const WriterPool&) = delete;
+    WriterPool& operator=(const WriterPool&) = delete;
+
+    /**
+     * @brief Ajusta el número de hilos escritores activos.
+     * @param count Número deseado de escritores (al menos 1).
+     */
+    void resize(int count);
+
+    /**
+     * @brief Número de escritores activos.
+     */
+    int size() const;
+
+    /**
+     * @brief Inicia el watchdog de escritores bloqueados.
+     * @param stallSeconds Segundos en una misma etapa a partir de los que un escritor se considera bloqueado.
+     * @param maxThreads Hilos escritores vivos como máximo, contando los bloqueados.
+     */
+    void startWatchdog(double stallSeconds, int maxThreads);
+
+    /**
+     * @brief Escritores retirados por bloqueo que aún no han terminado.
+     */
+    int stalledCount() const;
+
+    /**
+     * @brief Espera a que terminen todos los escritores (tras finalizar la cola).
+     */
+    void joinAll();
+
+private:
+    /**
+     * @brief Hilo escritor y su indicador de retiro.
+     */
+    struct Worker {
+        int id;
+        std::unique_ptr<std::atomic<bool>> retire;
+        std::unique_ptr<WriterHeartbeat> heartbeat;
+        std::thread thread;
+    };
+
+    /**
+     * @brief Lanza un escritor nuevo (con el mutex tomado).
+     */
+    void spawnLocked();
+
+    /**
+     * @brief Bucle del watchdog.
+     */
+    void watchdogLoop();
+
+    /**
+     * @brief Hilos vivos: activos y retirados que no han terminado (con el mutex tomado).
+     */
+    int liveThreadsLocked() const;
+
+    ThreadSafeQueue& queue;
+    Storage& storage;
+    const EncoderSettings& encoderSettings;
+    const std::atomic<int>& quality;
+    const CipherSettings& cipherSettings;
+    PipelineStats& stats;
+    const ThreadTuning& tuning;
+    BandwidthLimiter* limiter;
+    RetryQueue* retries;
+
+    mutable std::mutex mutex;      ///< Protege las listas de escritores.
+    std::vector<Worker> active;    ///< Escritores en servicio.
+    std::vector<Worker> retired;   ///< Escritores retirados pendientes de join.
+    int nextId = 1;                ///< Siguiente identificador de escritor.
+
+    double stallSeconds = 0.0;     ///< Umbral de bloqueo del watchdog.
+    int maxThreads = 0;            ///< Presupuesto de hilos para reemplazos.
+    bool stopping = false;         ///< Detiene el watchdog (protegido por mutex).
+    std::condition_variable wake;  ///< Despierta al watchdog para terminar.
+    std::thread watchdog;          ///< Hilo del watchdog.
+};
+
+#endif // WRITERPOOL_H
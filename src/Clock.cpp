@@ -0,0 +1,85 @@
+/**
+ * @file Clock.cpp
+ * @brief Implementación del reloj real y del reloj virtual para simulaciones.
+ */
+
+#include "Clock.h"
+#include <thread>
+
+/**
+ * @brief Instante actual del reloj monotónico del sistema.
+ */
+Clock::time_point SteadyClock::now() const {
+    return std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Duerme el hilo hasta el instante indicado.
+ * @param deadline Instante hasta el que se espera.
+ */
+void SteadyClock::sleepUntil(time_point deadline) {
+    std::this_thread::sleep_until(deadline);
+}
+
+/**
+ * @brief Crea un reloj virtual que comienza en `origin`.
+ * @param origin Instante inicial del tiempo virtual.
+ */
+VirtualClock::VirtualClock(time_point origin) : origin(origin) {}
+
+/**
+ * @brief Instante virtual actual.
+ */
+Clock::time_point VirtualClock::now() const {
+    return origin + std::chrono::nanoseconds(elapsedNs.load(std::memory_order_acquire));
+}
+
+/**
+ * @brief Espera al reposo del sistema.
+ *
+ * Bloquea como mucho un segundo real, para no detener la simulación si un consumidor
+ * queda bloqueado.
+ */
+void VirtualClock::settle() {
+    if (!idleWait) return;
+    idleWait(std::chrono::seconds(1));
+}
+
+/**
+ * @brief Adelanta el tiempo virtual hasta `deadline` sin bloquear.
+ * @param deadline Instante virtual a alcanzar.
+ */
+void VirtualClock::sleepUntil(time_point deadline) {
+    // El tiempo nunca retrocede: avanzar solo si el destino es posterior
+    const int64_t target = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - origin).count();
+    int64_t current = elapsedNs.load(std::memory_order_acquire);
+    while (target > current &&
+           !elapsedNs.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {
+    }
+}
+
+/**
+ * @brief Adelanta el tiempo virtual en `delta`.
+ * @param delta Tiempo a avanzar.
+ */
+void VirtualClock::advance(duration delta) {
+    elapsedNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count(),
+                        std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Define la espera de reposo que se hace antes de avanzar el tiempo.
+ * @param wait Función que bloquea hasta el reposo o hasta el límite de tiempo real.
+ */
+void VirtualClock::setIdleWait(std::function<bool(std::chrono::milliseconds)> wait) {
+    idleWait = std::move(wait);
+}
+
+/**
+ * @brief Reloj real compartido por defecto.
+ * @return Referencia a una instancia única de SteadyClock.
+ */
+Clock& systemClock() {
+    static SteadyClock clock;
+    return clock;
+}
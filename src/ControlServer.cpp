@@ -0,0 +1,198 @@
+/**
+ * @file ControlServer.cpp
+ * @brief Servidor del canal de control: socket Unix con un comando por línea.
+ */
+
+#include "ControlServer.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+/// Intervalo con el que el hilo del servidor revisa si debe detenerse.
+constexpr int kPollIntervalMs = 200;
+/// Longitud máxima aceptada para una línea de comando.
+constexpr size_t kMaxLineLength = 4096;
+}
+
+/**
+ * @brief Crea el servidor sin abrir todavía el socket.
+ * @param socketPath Ruta del socket Unix.
+ */
+ControlServer::ControlServer(const std::string& socketPath) : socketPath(socketPath) {}
+
+/**
+ * @brief Detiene el servidor si sigue activo.
+ */
+ControlServer::~ControlServer() {
+    stop();
+}
+
+/**
+ * @brief Registra un comando.
+ * @param name Nombre del comando.
+ * @param usage Sintaxis mostrada por `help`.
+ * @param handler Función que ejecuta el comando.
+ */
+void ControlServer::addCommand(const std::string& name, const std::string& usage, Handler handler) {
+    commands[name] = Command{usage, std::move(handler)};
+}
+
+/**
+ * @brief Crea el socket de escucha y lanza el hilo del servidor.
+ *
+ * Si existe un socket anterior en la misma ruta (de una ejecución interrumpida) se elimina;
+ * si en la ruta hay cualquier otro tipo de fichero no se toca y se devuelve error.
+ *
+ * @return true si el socket se creó correctamente.
+ */
+bool ControlServer::start() {
+    sockaddr_un address{};
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Ruta del socket de control demasiado larga: " << socketPath << std::endl;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    struct stat existing{};
+    if (lstat(socketPath.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            std::cerr << "Error: " << socketPath << " existe y no es un socket; no se sobrescribe" << std::endl;
+            return false;
+        }
+        unlink(socketPath.c_str());
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error al crear el socket de control: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, 4) != 0) {
+        std::cerr << "Error al abrir el socket de control " << socketPath << ": " << std::strerror(errno) << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    struct stat created{};
+    if (lstat(socketPath.c_str(), &created) == 0) {
+        socketDevice = created.st_dev;
+        socketInode = created.st_ino;
+    }
+
+    running = true;
+    thread = std::thread(&ControlServer::run, this);
+    return true;
+}
+
+/**
+ * @brief Detiene el hilo del servidor, cierra el socket y elimina su ruta.
+ *
+ * Solo se elimina la ruta si sigue siendo el socket creado por start().
+ */
+void ControlServer::stop() {
+    if (!running.exchange(false)) return;
+    if (thread.joinable()) thread.join();
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+    }
+    struct stat current{};
+    if (lstat(socketPath.c_str(), &current) == 0 && S_ISSOCK(current.st_mode) &&
+        current.st_dev == socketDevice && current.st_ino == socketInode) {
+        unlink(socketPath.c_str());
+    }
+}
+
+/**
+ * @brief Bucle del servidor: acepta clientes y los atiende de uno en uno.
+ */
+void ControlServer::run() {
+    while (running) {
+        pollfd listener{listenFd, POLLIN, 0};
+        if (poll(&listener, 1, kPollIntervalMs) <= 0) continue;
+
+        int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFd < 0) continue;
+        serveClient(clientFd);
+        close(clientFd);
+    }
+}
+
+/**
+ * @brief Lee líneas de un cliente y responde cada una hasta que cierre la conexión.
+ * @param clientFd Descriptor del cliente.
+ */
+void ControlServer::serveClient(int clientFd) {
+    std::string pending;
+    char chunk[512];
+
+    while (running) {
+        pollfd client{clientFd, POLLIN, 0};
+        int ready = poll(&client, 1, kPollIntervalMs);
+        if (ready == 0) continue;
+        if (ready < 0) return;
+
+        ssize_t received = read(clientFd, chunk, sizeof(chunk));
+        if (received <= 0) return; // El cliente cerró la conexión
+        pending.append(chunk, static_cast<size_t>(received));
+
+        size_t newline;
+        while ((newline = pending.find('\n')) != std::string::npos) {
+            std::string line = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line == "quit") return;
+
+            const std::string reply = dispatch(line) + "\n";
+            if (write(clientFd, reply.data(), reply.size()) < 0) return;
+        }
+
+        if (pending.size() > kMaxLineLength) {
+            const std::string reply = "ERR línea demasiado larga\n";
+            (void)write(clientFd, reply.data(), reply.size());
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Ejecuta una línea de comando.
+ * @param line Línea con el nombre del comando y sus argumentos.
+ * @return Respuesta con prefijo OK o ERR.
+ */
+std::string ControlServer::dispatch(const std::string& line) {
+    std::istringstream input(line);
+    std::string name;
+    if (!(input >> name)) return "ERR comando vacío";
+
+    std::string args;
+    std::getline(input >> std::ws, args);
+
+    if (name == "help") {
+        std::string reply = "OK";
+        for (const auto& entry : commands) {
+            reply += " | " + entry.second.usage;
+        }
+        return reply + " | quit";
+    }
+
+    auto it = commands.find(name);
+    if (it == commands.end()) {
+        return "ERR comando desconocido '" + name + "' (use help)";
+    }
+
+    std::string reply;
+    const bool ok = it->second.handler(args, reply);
+    return (ok ? "OK" : "ERR") + (reply.empty() ? std::string() : " " + reply);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file Crc32c.cpp
+ * @brief CRC32C con SSE4.2 y tabla de respaldo.
+ */
+
+#include "Crc32c.h"
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define FASTCAP_CRC_X86 1
+#endif
+
+namespace {
+/// Polinomio de Castagnoli reflejado.
+constexpr uint32_t kPolynomial = 0x82F63B78u;
+
+struct CrcTable {
+    uint32_t entries[256];
+    CrcTable() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (kPolynomial & (0u - (crc & 1u)));
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+uint32_t crc32cTable(const unsigned char* data, size_t size, uint32_t crc) {
+    static const CrcTable table;
+    for (size_t i = 0; i < size; i++) {
+        crc = table.entries[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef FASTCAP_CRC_X86
+__attribute__((target("sse4.2")))
+uint32_t crc32cHardware(const unsigned char* data, size_t size, uint32_t crc) {
+    uint64_t value = crc;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        value = _mm_crc32_u64(value, word);
+    }
+    uint32_t tail = static_cast<uint32_t>(value);
+    for (; i < size; i++) {
+        tail = _mm_crc32_u8(tail, data[i]);
+    }
+    return tail;
+}
+#endif
+} // namespace
+
+/**
+ * @brief CRC32C encadenable (inversión inicial y final incluidas).
+ */
+uint32_t crc32c(const void* data, size_t size, uint32_t crc) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+#ifdef FASTCAP_CRC_X86
+    static const bool hardware = __builtin_cpu_supports("sse4.2");
+    crc = hardware ? crc32cHardware(bytes, size, crc) : crc32cTable(bytes, size, crc);
+#else
+    crc = crc32cTable(bytes, size, crc);
+#endif
+    return ~crc;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file Dashboard.cpp
+ * @brief Panel de terminal con el estado del pipeline, redibujado en el sitio.
+ */
+
+#include "Dashboard.h"
+#include "Utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+/// Intervalo de refresco del panel (tiempo real).
+constexpr auto kRefreshInterval = std::chrono::milliseconds(250);
+
+/// Ventana de las tasas y los percentiles.
+constexpr auto kRateWindow = std::chrono::seconds(1);
+
+/// Líneas de mensajes que se conservan mientras el panel está activo.
+constexpr size_t kMaxSavedLines = 200;
+
+/// Líneas de mensajes que se muestran al pie del panel.
+constexpr size_t kShownLines = 3;
+
+/// Ancho de las barras de progreso y de la cola.
+constexpr int kBarWidth = 30;
+
+const char* const kBold = "\x1b[1m";
+const char* const kReset = "\x1b[0m";
+const char* const kClearLine = "\x1b[K";
+
+/**
+ * @brief Rellena con espacios hasta `width` caracteres (UTF-8: cuenta puntos de código, no bytes).
+ */
+std::string padRight(const std::string& text, size_t width) {
+    size_t characters = 0;
+    for (unsigned char byte : text) {
+        if ((byte & 0xC0) != 0x80) characters++;
+    }
+    return characters < width ? text + std::string(width - characters, ' ') : text;
+}
+
+/**
+ * @brief Barra de `kBarWidth` caracteres, coloreada según la ocupación.
+ */
+std::string bar(double fraction, bool colored) {
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+    const int filled = static_cast<int>(fraction * kBarWidth + 0.5);
+    std::string text;
+    if (colored) text += fraction < 0.5 ? "\x1b[32m" : fraction < 0.8 ? "\x1b[33m" : "\x1b[31m";
+    text += "[" + std::string(filled, '#') + std::string(kBarWidth - filled, '.') + "]";
+    if (colored) text += kReset;
+    return text;
+}
+} // namespace
+
+std::vector<std::string> ConsoleCapture::Buffer::lines() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<std::string>(complete.begin(), complete.end());
+}
+
+size_t ConsoleCapture::Buffer::total() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+int ConsoleCapture::Buffer::overflow(int c) {
+    if (c == traits_type::eof()) return traits_type::not_eof(c);
+    if (!capturing.load(std::memory_order_relaxed)) return target->sputc(static_cast<char>(c));
+    if (keepLines) {
+        const char ch = static_cast<char>(c);
+        append(&ch, 1);
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize ConsoleCapture::Buffer::xsputn(const char* text, std::streamsize count) {
+    if (!capturing.load(std::memory_order_relaxed)) return target->sputn(text, count);
+    if (keepLines) append(text, count);
+    return count;
+}
+
+int ConsoleCapture::Buffer::sync() {
+    return capturing.load(std::memory_order_relaxed) ? 0 : target->pubsync();
+}
+
+void ConsoleCapture::Buffer::append(const char* text, std::streamsize size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::streamsize i = 0; i < size; i++) {
+        if (text[i] != '\n') {
+            pending += text[i];
+            continue;
+        }
+        complete.push_back(std::move(pending));
+        pending.clear();
+        count++;
+        if (complete.size() > kMaxSavedLines) complete.pop_front();
+    }
+}
+
+ConsoleCapture::~ConsoleCapture() {
+    if (!installed()) return;
+    std::cout.flush();
+    std::cout.rdbuf(savedOut);
+    std::cerr.rdbuf(savedErr);
+}
+
+void ConsoleCapture::install() {
+    if (installed()) return;
+    output.target = std::cout.rdbuf();
+    errors.target = std::cerr.rdbuf();
+    savedOut = std::cout.rdbuf(&output);
+    savedErr = std::cerr.rdbuf(&errors);
+}
+
+void ConsoleCapture::setCapturing(bool capturing) {
+    output.capturing = capturing;
+    errors.capturing = capturing;
+}
+
+void ConsoleCapture::log(const std::string& line) {
+    if (errors.capturing.load()) {
+        errors.append(line.data(), static_cast<std::streamsize>(line.size()));
+        errors.append("\n", 1);
+    } else {
+        std::cout << line << std::endl;
+    }
+}
+
+Dashboard::Dashboard(ConsoleCapture& console, const PipelineStats& stats, FrameSink& sink, const Storage& storage,
+                     Clock& clock, double runSeconds)
+    : console(console), stats(stats), sink(sink), storage(storage), clock(clock), runSeconds(runSeconds) {}
+
+Dashboard::~Dashboard() {
+    stop();
+}
+
+bool Dashboard::start() {
+    if (!console.installed() || !isatty(STDOUT_FILENO)) {
+        std::cerr << "Aviso: la salida no es una terminal; se continúa sin panel" << std::endl;
+        return false;
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    console.setCapturing(true);
+    screen = std::make_unique<std::ostream>(console.screen());
+    // Pantalla alternativa: al salir vuelve la consola con la configuración mostrada
+    *screen << "\x1b[?1049h\x1b[?25l\x1b[2J" << std::flush;
+
+    origin = clock.now();
+    window.push_back(capture());
+    active = true;
+    refresher = std::thread(&Dashboard::run, this);
+    return true;
+}
+
+void Dashboard::stop() {
+    if (!active) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    refresher.join();
+
+    // Cursor visible y pantalla principal de vuelta
+    *screen << "\x1b[?25h\x1b[?1049l" << std::flush;
+    console.setCapturing(false);
+    active = false;
+
+    const std::vector<std::string> saved = console.lines();
+    if (!saved.empty()) {
+        std::cerr << console.total() << " mensajes durante el panel";
+        if (saved.size() < console.total()) std::cerr << " (últimos " << saved.size() << ")";
+        std::cerr << ":" << std::endl;
+        for (const auto& line : saved) std::cerr << "  " << line << std::endl;
+    }
+}
+
+/**
+ * @brief Redibuja el panel cada kRefreshInterval con las tasas del último segundo.
+ */
+void Dashboard::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wake.wait_for(lock, kRefreshInterval);
+        if (stopping) break;
+        lock.unlock();
+        window.push_back(capture());
+        const Snapshot& now = window.back();
+        while (window.size() > 2 && now.time - window[1].time >= kRateWindow) {
+            window.pop_front();
+        }
+        *screen << "\x1b[H" << render(now, window.front()) << "\x1b[J" << std::flush;
+        lock.lock();
+    }
+}
+
+Dashboard::Snapshot Dashboard::capture() const {
+    Snapshot snapshot;
+    snapshot.time = clock.now();
+    snapshot.generated = stats.imagesGenerated.load();
+    snapshot.enqueued = stats.imagesEnqueued.load();
+    snapshot.saved = stats.imagesSaved.load();
+    snapshot.dropped = sink.dropped();
+    snapshot.failures = stats.writeFailures.load();
+    snapshot.encode = stats.encodeLatency.counts();
+    snapshot.write = stats.writeLatency.counts();
+    for (int writer = 0; writer < kMaxWriterStats; writer++) {
+        snapshot.byWriter[writer] = stats.savedByWriter[writer].load(std::memory_order_relaxed);
+    }
+    snapshot.volumes = storage.volumeUsage();
+    if (snapshot.volumes.empty()) {
+        snapshot.volumes.push_back({storage.describe(), stats.bytesWritten.load()});
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Texto del panel; cada línea borra el resto de la anterior.
+ */
+std::string Dashboard::render(const Snapshot& now, const Snapshot& before) const {
+    const double seconds = std::chrono::duration<double>(now.time - before.time).count();
+    auto rate = [seconds](size_t current, size_t previous) {
+        return seconds > 0.0 ? (current - previous) / seconds : 0.0;
+    };
+    const double elapsed = std::chrono::duration<double>(now.time - origin).count();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << kBold << "fastcap" << kReset << "  " << elapsed << " / " << runSeconds << " s  "
+        << bar(runSeconds > 0.0 ? elapsed / runSeconds : 0.0, false) << kClearLine << "\n" << kClearLine << "\n";
+
+    out << kBold << padRight("Etapa", 16) << std::setw(10) << "FPS"
+        << std::setw(12) << "total" << kReset << kClearLine << "\n";
+    auto stage = [&](const char* name, size_t current, size_t previous) {
+        out << "  " << padRight(name, 14) << std::setw(10)
+            << rate(current, previous) << std::setw(12) << current << kClearLine << "\n";
+    };
+    stage("generadas", now.generated, before.generated);
+    stage("encoladas", now.enqueued, before.enqueued);
+    stage("guardadas", now.saved, before.saved);
+    stage("descartadas", now.dropped, before.dropped);
+    stage("perdidas", now.failures, before.failures);
+    out << kClearLine << "\n";
+
+    const size_t depth = sink.size();
+    const size_t capacity = sink.capacity();
+    out << kBold << "Cola" << kReset << "  ";
+    if (capacity > 0) {
+        out << bar(static_cast<double>(depth) / capacity, true) << " " << depth << "/" << capacity;
+    } else {
+        out << "sin cola intermedia";
+    }
+    out << kClearLine << "\n" << kClearLine << "\n";
+
+    // "máx" ocupa un byte más que caracteres, como la "á" de los nombres
+    out << kBold << padRight("Latencia (µs)", 16) << std::setw(11) << "p50"
+        << std::setw(10) << "p99" << std::setw(11) << "máx" << kReset << kClearLine << "\n";
+    out << std::setprecision(0);
+    auto latency = [&](const char* name, const LatencyHistogram::Counts& current, const LatencyHistogram::Counts& previous) {
+        const LatencyHistogram::Counts delta = LatencyHistogram::difference(current, previous);
+        out << "  " << padRight(name, 15)
+            << std::setw(10) << LatencyHistogram::percentileUs(delta, 0.50)
+            << std::setw(10) << LatencyHistogram::percentileUs(delta, 0.99)
+            << std::setw(10) << LatencyHistogram::percentileUs(delta, 1.0) << kClearLine << "\n";
+    };
+    latency("codificación", now.encode, before.encode);
+    latency("escritura", now.write, before.write);
+    out << std::setprecision(1) << kClearLine << "\n";
+
+    out << kBold << "Escritores (FPS)" << kReset;
+    int shown = 0;
+    for (int writer = 1; writer < kMaxWriterStats; writer++) {
+        if (now.byWriter[writer] == 0) continue;
+        if (shown > 0 && shown % 8 == 0) out << kClearLine << "\n" << std::string(16, ' ');
+        out << "  #" << writer << " " << rate(now.byWriter[writer], before.byWriter[writer]);
+        shown++;
+    }
+    if (shown == 0) out << "  -";
+    out << kClearLine << "\n" << kClearLine << "\n";
+
+    out << kBold << padRight("Volumen", 40) << std::setw(12) << "/s"
+        << std::setw(12) << "total" << kReset << kClearLine << "\n";
+    for (size_t i = 0; i < now.volumes.size(); i++) {
+        const VolumeUsage& volume = now.volumes[i];
+        const size_t previous = i < before.volumes.size() ? before.volumes[i].bytes : volume.bytes;
+        std::string name = volume.name;
+        if (name.size() > 38) name = "..." + name.substr(name.size() - 35);
+        out << "  " << padRight(name, 38)
+            << std::setw(12) << formatByteSize(static_cast<size_t>(rate(volume.bytes, previous)))
+            << std::setw(12) << formatByteSize(volume.bytes) << kClearLine << "\n";
+    }
+
+    const std::vector<std::string> lines = console.lines();
+    if (!lines.empty()) {
+        out << kClearLine << "\n" << kBold << "Mensajes: " << console.total() << kReset << kClearLine << "\n";
+        for (size_t i = lines.size() > kShownLines ? lines.size() - kShownLines : 0; i < lines.size(); i++) {
+            out << "  " << lines[i] << kClearLine << "\n";
+        }
+    }
+    return out.str();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file Encoder.cpp
+ * @brief Codificadores BMP, crudo y nulo, y selección del codificador según el formato.
+ */
+
+#include "Encoder.h"
+#include "LibjpegEncoder.h"
+#include "PixelKernels.h"
+#include "TurboJPEGWriter.h"
+#include <turbojpeg.h>
+#include <cstring>
+#include <sstream>
+
+#ifdef FASTCAP_HAVE_OPENCV
+#include <opencv2/imgcodecs.hpp>
+
+BmpEncoder::BmpEncoder(const PixelKernels& kernels) : kernels(kernels) {}
+
+/**
+ * @brief Codifica la imagen como BMP sin compresión.
+ * @param image Imagen a codificar.
+ * @param out Buffer de salida.
+ * @return true si la codificación fue exitosa.
+ */
+bool BmpEncoder::encode(const Frame& image, std::vector<unsigned char>& out) {
+    return cv::imencode(".bmp", toMat(kernels.encoderInput(image, scratch)), out);
+}
+#endif
+
+/**
+ * @brief Copia los píxeles fila a fila; con filas contiguas, de una vez.
+ * @param image Imagen a codificar.
+ * @param out Buffer de salida.
+ * @return true si la imagen no está vacía.
+ */
+bool RawEncoder::encode(const Frame& image, std::vector<unsigned char>& out) {
+    if (image.empty()) return false;
+    const size_t rowSize = image.rowSize();
+    out.resize(rowSize * image.height());
+    if (image.isContinuous()) {
+        std::memcpy(out.data(), image.data(), out.size());
+        return true;
+    }
+    for (int y = 0; y < image.height(); y++) {
+        std::memcpy(out.data() + rowSize * y, image.row(y), rowSize);
+    }
+    return true;
+}
+
+/**
+ * @brief Crea un codificador nulo.
+ * @param nominalSize Bytes por fotograma codificado (0 = 10% del fotograma).
+ */
+NullEncoder::NullEncoder(size_t nominalSize) : nominalSize(nominalSize) {}
+
+/**
+ * @brief Entrega un buffer de tamaño nominal sin leer los píxeles.
+ *
+ * El buffer se reutiliza entre llamadas: tras el primer fotograma, `resize` al mismo
+ * tamaño no tiene coste.
+ *
+ * @param image Imagen (solo se consultan sus dimensiones).
+ * @param out Buffer de salida.
+ * @return Siempre true.
+ */
+bool NullEncoder::encode(const Frame& image, std::vector<unsigned char>& out) {
+    const size_t size = nominalSize > 0
+        ? nominalSize
+        : image.rowSize() * image.height() / 10;
+    out.resize(size);
+    return true;
+}
+
+/**
+ * @brief Indica si un formato de salida es soportado.
+ * @param format Nombre del formato.
+ */
+bool isValidEncoderFormat(const std::string& format) {
+#ifdef FASTCAP_HAVE_OPENCV
+    if (format == "bmp") return true;
+#endif
+    return format == "jpg" || format == "raw" || format == "null";
+}
+
+/**
+ * @brief Interpreta opciones JPEG separadas por comas.
+ * @param text Lista de opciones, p. ej. "444,accurate,progressive".
+ * @param options Opciones resultantes.
+ * @return true si todas las opciones son válidas.
+ */
+bool parseJpegOptions(const std::string& text, JpegOptions& options) {
+    JpegOptions parsed;
+    std::istringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (item == "444") parsed.subsampling = TJSAMP_444;
+        else if (item == "422") parsed.subsampling = TJSAMP_422;
+        else if (item == "420") parsed.subsampling = TJSAMP_420;
+        else if (item == "gray") parsed.subsampling = TJSAMP_GRAY;
+        else if (item == "fast") parsed.accurateDct = false;
+        else if (item == "accurate") parsed.accurateDct = true;
+        else if (item == "baseline") parsed.progressive = false;
+        else if (item == "progressive") parsed.progressive = true;
+        else if (item == "optimize") parsed.huffman = JpegHuffman::PerFrame;
+        else if (item == "cached") parsed.huffman = JpegHuffman::Cached;
+        else if (item.compare(0, 7, "cached:") == 0) {
+            parsed.huffman = JpegHuffman::Cached;
+            try { parsed.huffmanRefresh = std::stoul(item.substr(7)); } catch (const std::exception&) { return false; }
+            if (parsed.huffmanRefresh == 0) return false;
+        }
+        else if (item == "12bit") parsed.precision = 12;
+        else if (item == "16bit") parsed.precision = 16;
+        else if (item == "lossless") parsed.lossless = true;
+        else return false;
+    }
+    if (parsed.progressive && parsed.huffman != JpegHuffman::Standard) return false;
+    // Las tablas de libjpeg son de 8 bits; la precisión de 16 bits solo existe sin pérdida
+    if (parsed.precision != 8 && parsed.huffman != JpegHuffman::Standard) return false;
+    if (parsed.precision == 16 && !parsed.lossless) return false;
+    if (parsed.lossless && (parsed.progressive || parsed.huffman != JpegHuffman::Standard)) return false;
+    options = parsed;
+    return true;
+}
+
+std::string describeJpegOptions(const JpegOptions& options) {
+    std::string text;
+    auto append = [&](const std::string& item) {
+        if (!text.empty()) text += ",";
+        text += item;
+    };
+    switch (options.subsampling) {
+        case TJSAMP_444: append("444"); break;
+        case TJSAMP_422: append("422"); break;
+        case TJSAMP_420: append("420"); break;
+        case TJSAMP_GRAY: append("gray"); break;
+        default: break;
+    }
+    if (options.accurateDct) append("accurate");
+    if (options.progressive) append("progressive");
+    if (options.huffman == JpegHuffman::PerFrame) append("optimize");
+    if (options.huffman == JpegHuffman::Cached) {
+        append(options.huffmanRefresh == JpegOptions().huffmanRefresh
+            ? std::string("cached") : "cached:" + std::to_string(options.huffmanRefresh));
+    }
+    if (options.precision != 8) append(std::to_string(options.precision) + "bit");
+    if (options.lossless) append("lossless");
+    return text;
+}
+
+/**
+ * @brief Crea un codificador según la configuración.
+ *
+ * Los núcleos del formato de píxel (y de la resolución, si tiene instancia propia) se
+ * eligen aquí, una vez por codificador.
+ *
+ * @param settings Parámetros del codificador.
+ * @return Codificador creado, o nullptr si el formato no es válido o no pudo inicializarse.
+ */
+std::unique_ptr<Encoder> createEncoder(const EncoderSettings& settings) {
+    const PixelKernels* kernels = selectPixelKernels(settings.pixelFormat, settings.width, settings.height);
+    if (!kernels) return nullptr;
+    if (settings.format == "jpg" && (settings.jpeg.precision != 8 || settings.jpeg.lossless)) {
+        auto encoder = std::make_unique<TurboJPEG3Encoder>(settings.quality, *kernels, settings.jpeg);
+        if (!encoder->isValid()) return nullptr;
+        return encoder;
+    }
+    if (settings.format == "jpg" && settings.jpeg.huffman != JpegHuffman::Standard) {
+        auto encoder = std::make_unique<LibjpegEncoder>(settings.quality, *kernels, settings.jpeg);
+        if (!encoder->isValid()) return nullptr;
+        return encoder;
+    }
+    if (settings.format == "jpg") {
+        auto encoder = std::make_unique<TurboJPEGEncoder>(settings.quality, kernels, settings.jpeg);
+        if (!encoder->isValid()) return nullptr;
+        return encoder;
+    }
+    if (settings.format == "null") {
+        return std::make_unique<NullEncoder>(settings.nullSize);
+    }
+    if (settings.format == "raw") {
+        return std::make_unique<RawEncoder>();
+    }
+#ifdef FASTCAP_HAVE_OPENCV
+    if (settings.format == "bmp") {
+        return std::make_unique<BmpEncoder>(*kernels);
+    }
+#endif
+    return nullptr;
+}
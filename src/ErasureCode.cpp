@@ -0,0 +1,306 @@
+/**
+ * @file ErasureCode.cpp
+ * @brief Reed-Solomon K+M sobre GF(2^8) con núcleos escalar, PSHUFB y GFNI.
+ */
+
+#include "ErasureCode.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FASTCAP_GF_X86 1
+#endif
+
+namespace {
+/// Polinomio del cuerpo (x^8 + x^4 + x^3 + x + 1), compartido con GFNI.
+constexpr unsigned kPolynomial = 0x11B;
+
+/// Bytes por bloque al recorrer los fragmentos, para reutilizar los datos en caché.
+constexpr size_t kBlockSize = 16 * 1024;
+
+/**
+ * @brief Tablas del cuerpo: producto completo y tablas de nibbles para PSHUFB.
+ */
+struct GaloisTables {
+    uint8_t mul[256][256];
+    uint8_t inverse[256];
+    uint8_t low[256][16];   ///< low[c][i] = c * i
+    uint8_t high[256][16];  ///< high[c][i] = c * (i << 4)
+
+    GaloisTables() {
+        for (unsigned a = 0; a < 256; a++) {
+            for (unsigned b = 0; b < 256; b++) {
+                // Multiplicación "ruso campesino" reduciendo por el polinomio
+                unsigned x = a, y = b, product = 0;
+                while (y) {
+                    if (y & 1) product ^= x;
+                    x <<= 1;
+                    if (x & 0x100) x ^= kPolynomial;
+                    y >>= 1;
+                }
+                mul[a][b] = static_cast<uint8_t>(product);
+                if (product == 1) inverse[a] = static_cast<uint8_t>(b);
+            }
+        }
+        inverse[0] = 0;
+        for (unsigned c = 0; c < 256; c++) {
+            for (unsigned i = 0; i < 16; i++) {
+                low[c][i] = mul[c][i];
+                high[c][i] = mul[c][i << 4];
+            }
+        }
+    }
+};
+
+const GaloisTables& tables() {
+    static const GaloisTables instance;
+    return instance;
+}
+
+/// Núcleo: dst ^= c * src en `size` bytes.
+using MulAddKernel = void (*)(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size);
+
+void mulAddScalar(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    const uint8_t* row = tables().mul[c];
+    for (size_t i = 0; i < size; i++) {
+        dst[i] ^= row[src[i]];
+    }
+}
+
+#ifdef FASTCAP_GF_X86
+__attribute__((target("ssse3")))
+void mulAddSsse3(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables().low[c]));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables().high[c]));
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i product = _mm_xor_si128(
+            _mm_shuffle_epi8(low, _mm_and_si128(s, mask)),
+            _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi64(s, 4), mask)));
+        __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+        _mm_storeu_si128(out, _mm_xor_si128(_mm_loadu_si128(out), product));
+    }
+    mulAddScalar(dst + i, src + i, c, size - i);
+}
+
+__attribute__((target("avx2")))
+void mulAddAvx2(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables().low[c])));
+    const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables().high[c])));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i product = _mm256_xor_si256(
+            _mm256_shuffle_epi8(low, _mm256_and_si256(s, mask)),
+            _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi64(s, 4), mask)));
+        __m256i* out = reinterpret_cast<__m256i*>(dst + i);
+        _mm256_storeu_si256(out, _mm256_xor_si256(_mm256_loadu_si256(out), product));
+    }
+    mulAddScalar(dst + i, src + i, c, size - i);
+}
+
+__attribute__((target("gfni,avx2")))
+void mulAddGfni(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    const __m256i factor = _mm256_set1_epi8(static_cast<char>(c));
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i* out = reinterpret_cast<__m256i*>(dst + i);
+        _mm256_storeu_si256(out, _mm256_xor_si256(_mm256_loadu_si256(out), _mm256_gf2p8mul_epi8(s, factor)));
+    }
+    mulAddScalar(dst + i, src + i, c, size - i);
+}
+#endif
+
+/**
+ * @brief Núcleo disponible.
+ */
+struct Kernel {
+    const char* name;
+    MulAddKernel function;
+    bool (*supported)();
+};
+
+const Kernel kKernels[] = {
+#ifdef FASTCAP_GF_X86
+    {"gfni", mulAddGfni, [] { return __builtin_cpu_supports("gfni") && __builtin_cpu_supports("avx2"); }},
+    {"avx2", mulAddAvx2, [] { return static_cast<bool>(__builtin_cpu_supports("avx2")); }},
+    {"ssse3", mulAddSsse3, [] { return static_cast<bool>(__builtin_cpu_supports("ssse3")); }},
+#endif
+    {"escalar", mulAddScalar, [] { return true; }},
+};
+
+/**
+ * @brief Núcleo seleccionado; por defecto el más rápido que admite la CPU.
+ */
+const Kernel*& activeKernel() {
+    static const Kernel* kernel = [] {
+        for (const Kernel& candidate : kKernels) {
+            if (candidate.supported()) return &candidate;
+        }
+        return &kKernels[0];
+    }();
+    return kernel;
+}
+
+/**
+ * @brief dst = sum(coefficients[i] * sources[i]) en bloques para aprovechar la caché.
+ */
+void combine(const uint8_t* coefficients, const unsigned char* const* sources, int count,
+             unsigned char* dst, size_t size) {
+    const MulAddKernel mulAdd = activeKernel()->function;
+    std::memset(dst, 0, size);
+    for (size_t offset = 0; offset < size; offset += kBlockSize) {
+        const size_t block = std::min(kBlockSize, size - offset);
+        for (int i = 0; i < count; i++) {
+            if (coefficients[i] != 0) {
+                mulAdd(dst + offset, sources[i] + offset, coefficients[i], block);
+            }
+        }
+    }
+}
+} // namespace
+
+/**
+ * @brief Construye la matriz de paridad de Cauchy: P[p][j] = 1 / (x_p + y_j).
+ *
+ * Con x_p = K + p e y_j = j, los conjuntos son disjuntos y toda submatriz cuadrada de
+ * [I; P] de K filas es invertible.
+ */
+ErasureCode::ErasureCode(int dataShards, int parityShards)
+    : k(dataShards), m(parityShards), matrix(static_cast<size_t>(dataShards * parityShards)) {
+    const GaloisTables& gf = tables();
+    for (int p = 0; p < m; p++) {
+        for (int j = 0; j < k; j++) {
+            matrix[p * k + j] = gf.inverse[static_cast<uint8_t>((k + p) ^ j)];
+        }
+    }
+}
+
+/**
+ * @brief Interpreta "K+M".
+ */
+bool ErasureCode::parseSpec(const std::string& text, int& dataShards, int& parityShards) {
+    std::istringstream iss(text);
+    char plus = 0;
+    int data = 0, parity = 0;
+    if (!(iss >> data >> plus >> parity) || plus != '+' || !iss.eof()) return false;
+    if (data < 1 || parity < 1 || data + parity > 255) return false;
+    dataShards = data;
+    parityShards = parity;
+    return true;
+}
+
+/**
+ * @brief Calcula las M paridades de un conjunto de K fragmentos.
+ */
+void ErasureCode::encode(const unsigned char* const* data, unsigned char* const* parity, size_t size) const {
+    for (int p = 0; p < m; p++) {
+        combine(&matrix[p * k], data, k, parity[p], size);
+    }
+}
+
+/**
+ * @brief Reconstruye los fragmentos perdidos.
+ *
+ * Toma las filas de la matriz generadora [I; P] de K fragmentos presentes, invierte
+ * esa submatriz (Gauss-Jordan en GF(2^8)) para recuperar los datos perdidos y vuelve
+ * a calcular la paridad perdida a partir de los datos completos.
+ */
+bool ErasureCode::reconstruct(unsigned char* const* shards, const std::vector<bool>& present, size_t size) const {
+    const GaloisTables& gf = tables();
+
+    std::vector<int> rows;
+    for (int i = 0; i < k + m && static_cast<int>(rows.size()) < k; i++) {
+        if (present[i]) rows.push_back(i);
+    }
+    if (static_cast<int>(rows.size()) < k) return false;
+
+    bool dataMissing = false;
+    for (int j = 0; j < k; j++) dataMissing = dataMissing || !present[j];
+
+    if (dataMissing) {
+        // Submatriz K x K de la matriz generadora para las filas elegidas
+        std::vector<uint8_t> a(static_cast<size_t>(k * k), 0), inv(static_cast<size_t>(k * k), 0);
+        for (int r = 0; r < k; r++) {
+            const int row = rows[r];
+            for (int j = 0; j < k; j++) {
+                a[r * k + j] = row < k ? (row == j ? 1 : 0) : matrix[(row - k) * k + j];
+            }
+            inv[r * k + r] = 1;
+        }
+        for (int col = 0; col < k; col++) {
+            int pivot = col;
+            while (pivot < k && a[pivot * k + col] == 0) pivot++;
+            if (pivot == k) return false;
+            for (int j = 0; j < k; j++) {
+                std::swap(a[col * k + j], a[pivot * k + j]);
+                std::swap(inv[col * k + j], inv[pivot * k + j]);
+            }
+            const uint8_t scale = gf.inverse[a[col * k + col]];
+            for (int j = 0; j < k; j++) {
+                a[col * k + j] = gf.mul[scale][a[col * k + j]];
+                inv[col * k + j] = gf.mul[scale][inv[col * k + j]];
+            }
+            for (int r = 0; r < k; r++) {
+                const uint8_t factor = a[r * k + col];
+                if (r == col || factor == 0) continue;
+                for (int j = 0; j < k; j++) {
+                    a[r * k + j] ^= gf.mul[factor][a[col * k + j]];
+                    inv[r * k + j] ^= gf.mul[factor][inv[col * k + j]];
+                }
+            }
+        }
+
+        std::vector<const unsigned char*> sources(k);
+        for (int r = 0; r < k; r++) sources[r] = shards[rows[r]];
+        for (int j = 0; j < k; j++) {
+            if (!present[j]) {
+                combine(&inv[j * k], sources.data(), k, shards[j], size);
+            }
+        }
+    }
+
+    for (int p = 0; p < m; p++) {
+        if (!present[k + p]) {
+            combine(&matrix[p * k], shards, k, shards[k + p], size);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Nombre del núcleo en uso.
+ */
+const char* ErasureCode::kernelName() {
+    return activeKernel()->name;
+}
+
+/**
+ * @brief Núcleos que admite la CPU.
+ */
+std::vector<std::string> ErasureCode::availableKernels() {
+    std::vector<std::string> names;
+    for (const Kernel& kernel : kKernels) {
+        if (kernel.supported()) names.push_back(kernel.name);
+    }
+    return names;
+}
+
+/**
+ * @brief Fuerza un núcleo concreto.
+ */
+bool ErasureCode::selectKernel(const std::string& name) {
+    for (const Kernel& kernel : kKernels) {
+        if (name == kernel.name && kernel.supported()) {
+            activeKernel() = &kernel;
+            return true;
+        }
+    }
+    return false;
+}
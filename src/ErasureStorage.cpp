@@ -0,0 +1,492 @@
+/**
+ * @file ErasureStorage.cpp
+ * @brief Franjas con código de borrado K+M repartidas en varios volúmenes.
+ */
+
+#include "ErasureStorage.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+/// Franjas cerradas que pueden esperar a la etapa de paridad antes de frenar a los escritores.
+constexpr size_t kMaxClosedStripes = 2;
+
+/// Franjas codificadas que pueden estar escribiéndose a la vez en los volúmenes.
+constexpr size_t kMaxWritingStripes = 2;
+
+/// Alineación del tamaño de fragmento, para que los núcleos vectoriales no usen la cola escalar.
+constexpr size_t kShardAlignment = 64;
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe un archivo completo y lo sincroniza con fsync.
+ */
+bool writeSynced(const std::string& path, const void* data, size_t size) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    const bool ok = writeAll(fd, data, size) && fsync(fd) == 0;
+    return ::close(fd) == 0 && ok;
+}
+
+/**
+ * @brief Sincroniza un directorio para que un rename sobreviva a un corte.
+ */
+void syncDirectory(const std::string& directory) {
+    const int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+} // namespace
+
+/**
+ * @brief Ruta de un fragmento (`.sII`) o del índice (`.idx`) de una franja.
+ */
+std::string stripePath(const std::string& volume, uint64_t stripe, int shard) {
+    std::ostringstream oss;
+    oss << volume << "/stripe_" << std::setw(8) << std::setfill('0') << stripe;
+    if (shard < 0) {
+        oss << ".idx";
+    } else {
+        oss << ".s" << std::setw(2) << shard;
+    }
+    return oss.str();
+}
+
+/**
+ * @brief Guarda el índice (cabecera, geometría y una línea por fotograma) en un temporal
+ *        sincronizado que sustituye al definitivo con rename.
+ */
+bool StripeIndex::save(const std::string& path) const {
+    std::ostringstream oss;
+    oss << "fastcap-ec 1\n"
+        << "geometry " << dataShards << " " << parityShards << " " << shardSize << " " << totalBytes << "\n";
+    for (const auto& entry : entries) {
+        oss << "frame " << entry.name << " " << entry.offset << " " << entry.size << "\n";
+    }
+    oss << "end\n";
+    const std::string content = oss.str();
+
+    const std::string partial = path + ".tmp";
+    if (!writeSynced(partial, content.data(), content.size()) || std::rename(partial.c_str(), path.c_str()) != 0) {
+        std::remove(partial.c_str());
+        return false;
+    }
+    syncDirectory(std::filesystem::path(path).parent_path().string());
+    return true;
+}
+
+/**
+ * @brief Lee un índice; exige la marca final para descartar índices truncados.
+ */
+bool StripeIndex::load(const std::string& path) {
+    std::ifstream in(path);
+    std::string magic;
+    int version = 0;
+    if (!(in >> magic >> version) || magic != "fastcap-ec" || version != 1) return false;
+
+    entries.clear();
+    std::string tag;
+    while (in >> tag) {
+        if (tag == "geometry") {
+            if (!(in >> dataShards >> parityShards >> shardSize >> totalBytes)) return false;
+        } else if (tag == "frame") {
+            StripeEntry entry;
+            if (!(in >> entry.name >> entry.offset >> entry.size)) return false;
+            entries.push_back(entry);
+        } else if (tag == "end") {
+            return dataShards > 0 && parityShards > 0;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Lista de directorios separados por comas.
+ */
+std::vector<std::string> splitVolumeList(const std::string& text) {
+    std::vector<std::string> volumes;
+    std::istringstream iss(text);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) volumes.push_back(item);
+    }
+    return volumes;
+}
+
+/**
+ * @brief Crea el almacenamiento y arranca los escritores de volumen y la etapa de paridad.
+ *
+ * La numeración de franjas continúa tras la mayor encontrada en los volúmenes, para no
+ * sobrescribir grabaciones anteriores.
+ */
+ErasureStorage::ErasureStorage(const std::vector<std::string>& volumes, int dataShards, int parityShards,
+                               size_t stripeSize)
+    : volumes(volumes), code(dataShards, parityShards), stripeSize(stripeSize) {
+    for (const auto& volume : volumes) {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(volume, error)) {
+            const std::string file = entry.path().filename().string();
+            unsigned long long number = 0;
+            if (std::sscanf(file.c_str(), "stripe_%llu.idx", &number) == 1 && file.size() > 4 &&
+                file.compare(file.size() - 4, 4, ".idx") == 0) {
+                nextStripe = std::max<uint64_t>(nextStripe, number + 1);
+            }
+        }
+    }
+    open.number = nextStripe++;
+    open.bytes.reserve(stripeSize);
+    for (size_t i = 0; i < volumes.size(); i++) {
+        writers.push_back(std::make_unique<VolumeWriter>());
+    }
+    for (size_t i = 0; i < volumes.size(); i++) {
+        writers[i]->thread = std::thread(&ErasureStorage::volumeLoop, this, static_cast<int>(i));
+    }
+    parityThread = std::thread(&ErasureStorage::parityLoop, this);
+}
+
+/**
+ * @brief Escribe lo pendiente y detiene la etapa de paridad y los escritores.
+ */
+ErasureStorage::~ErasureStorage() {
+    drain();
+}
+
+/**
+ * @brief Cierra la franja abierta y la pasa a la cola de paridad.
+ */
+void ErasureStorage::closeStripeLocked() {
+    if (open.entries.empty()) return;
+    closed.push_back(std::move(open));
+    open = Stripe();
+    open.number = nextStripe++;
+    open.bytes.reserve(stripeSize);
+    stripeReady.notify_one();
+}
+
+/**
+ * @brief Añade el fotograma a la franja abierta, cerrándola antes si no cabe.
+ */
+bool ErasureStorage::write(const std::string& name, const std::vector<unsigned char>& data) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stopping) return false;
+
+    if (!open.entries.empty() && open.bytes.size() + data.size() > stripeSize) {
+        // La etapa de paridad va retrasada: frenar a los escritores en lugar de acumular memoria
+        stripeDone.wait(lock, [this] { return closed.size() < kMaxClosedStripes || stopping; });
+        closeStripeLocked();
+    }
+
+    StripeEntry entry;
+    entry.name = name;
+    entry.offset = open.bytes.size();
+    entry.size = data.size();
+    open.entries.push_back(entry);
+    open.bytes.insert(open.bytes.end(), data.begin(), data.end());
+    return true;
+}
+
+/**
+ * @brief Cierra la franja abierta.
+ */
+bool ErasureStorage::rollover() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closeStripeLocked();
+    return true;
+}
+
+/**
+ * @brief Lee los índices de las franjas anteriores de cualquier volumen.
+ */
+bool ErasureStorage::recover(uint64_t& nextSequence) {
+    bool found = false;
+    for (uint64_t stripe = 0; stripe < open.number; stripe++) {
+        StripeIndex index;
+        bool loaded = false;
+        for (const auto& volume : volumes) {
+            if ((loaded = index.load(stripePath(volume, stripe, -1)))) break;
+        }
+        if (!loaded) continue;
+        for (const auto& entry : index.entries) {
+            uint64_t sequence = 0;
+            if (parseFrameSequence(entry.name, sequence)) {
+                nextSequence = std::max(nextSequence, sequence + 1);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Divide la franja en K fragmentos y calcula los M de paridad.
+ */
+std::shared_ptr<ErasureStorage::EncodedStripe> ErasureStorage::encodeStripe(Stripe& stripe) {
+    const int k = code.dataShards();
+    const int m = code.parityShards();
+
+    auto encoded = std::make_shared<EncodedStripe>();
+    encoded->number = stripe.number;
+    StripeIndex& index = encoded->index;
+    index.dataShards = k;
+    index.parityShards = m;
+    index.totalBytes = stripe.bytes.size();
+    index.shardSize = (index.totalBytes + k - 1) / k;
+    index.shardSize = (index.shardSize + kShardAlignment - 1) / kShardAlignment * kShardAlignment;
+    index.entries = std::move(stripe.entries);
+
+    // Los fragmentos de datos son trozos contiguos de la franja rellenada con ceros
+    encoded->bytes = std::move(stripe.bytes);
+    encoded->bytes.resize(index.shardSize * (k + m), 0);
+    std::vector<unsigned char*> shards(k + m);
+    for (int i = 0; i < k + m; i++) {
+        shards[i] = encoded->bytes.data() + index.shardSize * i;
+    }
+
+    const auto parityStart = std::chrono::steady_clock::now();
+    code.encode(shards.data(), shards.data() + k, index.shardSize);
+    parityNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - parityStart).count();
+
+    dataBytes += index.totalBytes;
+    parityBytes += index.shardSize * m;
+    frames += index.entries.size();
+    encoded->shardOk.assign(k + m, 0);
+    encoded->shardsLeft = k + m;
+    return encoded;
+}
+
+/**
+ * @brief Codifica franjas y entrega cada fragmento a su volumen hasta que se pida parar.
+ */
+void ErasureStorage::parityLoop() {
+    while (true) {
+        Stripe stripe;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stripeReady.wait(lock, [this] { return stopping || !closed.empty(); });
+            if (closed.empty()) return;
+            stripe = std::move(closed.front());
+            closed.pop_front();
+        }
+        stripeDone.notify_all();
+
+        // La paridad de esta franja se calcula mientras los volúmenes escriben las anteriores
+        auto encoded = encodeStripe(stripe);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stripeWritten.wait(lock, [this] { return writingStripes < kMaxWritingStripes; });
+            if (writingStripes++ == 0) busySince = std::chrono::steady_clock::now();
+        }
+        for (size_t i = 0; i < writers.size(); i++) {
+            submit(static_cast<int>(i), {encoded, false});
+        }
+    }
+}
+
+/**
+ * @brief Añade la tarea al final de la cola del volumen.
+ */
+void ErasureStorage::submit(int volume, VolumeTask task) {
+    VolumeWriter& writer = *writers[volume];
+    {
+        std::lock_guard<std::mutex> lock(writer.mutex);
+        writer.tasks.push_back(std::move(task));
+    }
+    writer.ready.notify_one();
+}
+
+/**
+ * @brief Escribe y sincroniza los fragmentos e índices del volumen en orden de llegada.
+ */
+void ErasureStorage::volumeLoop(int volume) {
+    VolumeWriter& writer = *writers[volume];
+    while (true) {
+        VolumeTask task;
+        {
+            std::unique_lock<std::mutex> lock(writer.mutex);
+            writer.ready.wait(lock, [&writer] { return writer.stopping || !writer.tasks.empty(); });
+            if (writer.tasks.empty()) return;
+            task = std::move(writer.tasks.front());
+            writer.tasks.pop_front();
+        }
+        EncodedStripe& stripe = *task.stripe;
+
+        if (task.index) {
+            if (!stripe.index.save(stripePath(volumes[volume], stripe.number, -1))) {
+                std::cerr << "Error al escribir el índice de la franja " << stripe.number << " en "
+                          << volumes[volume] << std::endl;
+                stripe.indexFailed = true;
+            }
+            if (--stripe.indexesLeft == 0) finishStripe(stripe);
+            continue;
+        }
+
+        const size_t size = stripe.index.shardSize;
+        if (writeSynced(stripePath(volumes[volume], stripe.number, volume), stripe.bytes.data() + size * volume, size)) {
+            stripe.shardOk[volume] = 1;
+            writer.bytes += size;
+        } else {
+            std::cerr << "Error al escribir la franja " << stripe.number << " en " << volumes[volume] << std::endl;
+        }
+        if (--stripe.shardsLeft == 0) commitStripe(task.stripe);
+    }
+}
+
+/**
+ * @brief Con todos los fragmentos sincronizados, escribe el índice en los volúmenes que
+ *        tienen el suyo; con menos de K la franja no se puede leer y se queda sin índice.
+ */
+void ErasureStorage::commitStripe(const std::shared_ptr<EncodedStripe>& stripe) {
+    const int written = static_cast<int>(std::count(stripe->shardOk.begin(), stripe->shardOk.end(), 1));
+    if (written < code.dataShards()) {
+        std::cerr << "Franja " << stripe->number << " perdida: solo " << written << " de "
+                  << code.dataShards() << " fragmentos necesarios escritos" << std::endl;
+        stripesLost++;
+        finishStripe(*stripe);
+        return;
+    }
+    stripe->indexesLeft = written;
+    for (size_t i = 0; i < writers.size(); i++) {
+        if (stripe->shardOk[i]) submit(static_cast<int>(i), {stripe, true});
+    }
+}
+
+/**
+ * @brief Cuenta la franja y acumula el tiempo en que los volúmenes estuvieron ocupados.
+ */
+void ErasureStorage::finishStripe(const EncodedStripe& stripe) {
+    const bool complete = !stripe.indexFailed &&
+                          std::find(stripe.shardOk.begin(), stripe.shardOk.end(), 0) == stripe.shardOk.end();
+    if (complete) {
+        stripesWritten++;
+    } else {
+        stripeFailures++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--writingStripes == 0) {
+            writeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - busySince).count();
+        }
+    }
+    stripeWritten.notify_all();
+}
+
+/**
+ * @brief Cierra la franja abierta, escribe lo pendiente y detiene la etapa y los escritores.
+ */
+void ErasureStorage::drain() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) return;
+        closeStripeLocked();
+        stopping = true;
+    }
+    stripeReady.notify_all();
+    stripeDone.notify_all();
+    if (parityThread.joinable()) {
+        parityThread.join();
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stripeWritten.wait(lock, [this] { return writingStripes == 0; });
+    }
+    for (auto& writer : writers) {
+        {
+            std::lock_guard<std::mutex> lock(writer->mutex);
+            writer->stopping = true;
+        }
+        writer->ready.notify_all();
+        if (writer->thread.joinable()) {
+            writer->thread.join();
+        }
+    }
+}
+
+/**
+ * @brief Bytes de fragmento que cada volumen escribió con éxito.
+ */
+std::vector<VolumeUsage> ErasureStorage::volumeUsage() const {
+    std::vector<VolumeUsage> usage;
+    for (size_t i = 0; i < volumes.size(); i++) usage.push_back({volumes[i], writers[i]->bytes.load()});
+    return usage;
+}
+
+/**
+ * @brief Descripción de la geometría y los volúmenes.
+ */
+std::string ErasureStorage::describe() const {
+    std::ostringstream oss;
+    oss << "código de borrado " << code.dataShards() << "+" << code.parityShards()
+        << " (franjas de " << formatByteSize(stripeSize) << ", núcleo " << ErasureCode::kernelName() << "):";
+    for (const auto& volume : volumes) oss << " " << volume;
+    return oss.str();
+}
+
+/**
+ * @brief Guarda la tasa configurada para el informe.
+ */
+void ErasureStorage::setTargetRate(double framesPerSecond) {
+    targetRate = framesPerSecond;
+}
+
+/**
+ * @brief Informe de franjas y throughput de paridad para los resultados finales.
+ *
+ * El throughput necesario es la tasa configurada por el tamaño medio de fotograma grabado.
+ */
+std::string ErasureStorage::report() const {
+    const double paritySeconds = parityNs.load() / 1e9;
+    const double writeSeconds = writeNs.load() / 1e9;
+    const double parityRate = paritySeconds > 0 ? dataBytes.load() / paritySeconds : 0.0;
+    const double writeRate = writeSeconds > 0 ? dataBytes.load() / writeSeconds : 0.0;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "Franjas escritas: " << stripesWritten.load();
+    if (stripeFailures.load() > 0) {
+        oss << " (" << stripeFailures.load() << " con volúmenes fallidos, " << stripesLost.load() << " irrecuperables)";
+    }
+    oss << ", datos " << formatByteSize(dataBytes.load()) << ", paridad " << formatByteSize(parityBytes.load());
+    oss << "\nCálculo de paridad (" << ErasureCode::kernelName() << "): "
+        << formatByteSize(static_cast<size_t>(parityRate)) << "/s de datos (" << paritySeconds << " s)";
+    oss << "\nEscritura de fragmentos: " << formatByteSize(static_cast<size_t>(writeRate)) << "/s de datos, "
+        << formatByteSize(static_cast<size_t>(writeSeconds > 0 ? (dataBytes.load() + parityBytes.load()) / writeSeconds : 0.0))
+        << "/s con paridad (" << writeSeconds << " s)";
+
+    const double target = targetRate.load();
+    if (target > 0 && frames.load() > 0) {
+        const double required = target * dataBytes.load() / frames.load();
+        oss << "\nNecesario a " << target << " FPS: " << formatByteSize(static_cast<size_t>(required)) << "/s de datos";
+        if (parityRate < required) {
+            oss << "\nAviso: la paridad no alcanza la tasa configurada (" << 100.0 * parityRate / required << "%)";
+        }
+        if (writeRate < required) {
+            oss << "\nAviso: la escritura de fragmentos no alcanza la tasa configurada ("
+                << 100.0 * writeRate / required << "%)";
+        }
+    }
+    return oss.str();
+}
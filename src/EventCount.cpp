@@ -0,0 +1,203 @@
+/**
+ * @file EventCount.cpp
+ * @brief EventCount sobre futex de Linux.
+ */
+
+#include "EventCount.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+              "el futex necesita una palabra atómica de 32 bits sin bloqueo");
+
+namespace {
+/// Giro mínimo del modo adaptativo cuando las esperas suelen superar el presupuesto.
+constexpr int64_t kMinAdaptiveSpinNs = 1000;
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long futex(std::atomic<uint32_t>* word, int op, uint32_t value) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, nullptr, nullptr, 0);
+}
+} // namespace
+
+void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+EventCountStats& EventCountStats::operator+=(const EventCountStats& other) {
+    notifies += other.notifies;
+    skippedNotifies += other.skippedNotifies;
+    wakeSyscalls += other.wakeSyscalls;
+    waitSyscalls += other.waitSyscalls;
+    spinWakeups += other.spinWakeups;
+    parkedWakeups += other.parkedWakeups;
+    wakeLatencyNs += other.wakeLatencyNs;
+    maxWakeLatencyNs = std::max(maxWakeLatencyNs, other.maxWakeLatencyNs);
+    spinLatencyNs += other.spinLatencyNs;
+    spinNs += other.spinNs;
+    parkedNs += other.parkedNs;
+    return *this;
+}
+
+/**
+ * @brief Se registra antes de leer la época: un notify posterior verá al hilo.
+ */
+EventCount::Key EventCount::prepareWait() {
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    return epoch.load(std::memory_order_seq_cst);
+}
+
+void EventCount::cancelWait() {
+    waiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Cambia el giro antes de dormir.
+ * @param policy Presupuesto de giro y si se ajusta a la espera típica.
+ */
+void EventCount::setSpin(const SpinPolicy& policy) {
+    spinBudget.store(std::max<int64_t>(policy.budgetNs, 0), std::memory_order_relaxed);
+    adaptiveSpin.store(policy.adaptive, std::memory_order_relaxed);
+    typicalWaitNs.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Giro de la siguiente espera.
+ *
+ * En modo adaptativo se gira el doble de la espera típica si cabe en el presupuesto,
+ * y lo mínimo si las esperas suelen durar más que el presupuesto. Sin historial se
+ * gira el presupuesto completo.
+ */
+int64_t EventCount::spinBudgetNs() const {
+    const int64_t budget = spinBudget.load(std::memory_order_relaxed);
+    if (!adaptiveSpin.load(std::memory_order_relaxed)) return budget;
+    const int64_t typical = typicalWaitNs.load(std::memory_order_relaxed);
+    if (typical == 0) return budget;
+    if (typical > budget) return std::min(budget, kMinAdaptiveSpinNs);
+    return std::min(budget, std::max(2 * typical, kMinAdaptiveSpinNs));
+}
+
+/**
+ * @brief Actualiza la media móvil (peso 1/8) de la duración de las esperas.
+ *
+ * Varios esperadores pueden pisarse la actualización; para una estimación basta.
+ */
+void EventCount::recordWait(int64_t waitedNs) {
+    const int64_t typical = typicalWaitNs.load(std::memory_order_relaxed);
+    typicalWaitNs.store(typical == 0 ? std::max<int64_t>(waitedNs, 1) : typical + (waitedNs - typical) / 8,
+                        std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gira mientras la época no cambie y después duerme en el futex.
+ *
+ * El reloj se consulta cada 16 pausas para no encarecer el giro. FUTEX_WAIT solo
+ * duerme si la época sigue siendo `key`, así que un notify entre la comprobación y la
+ * syscall no se pierde.
+ */
+void EventCount::wait(Key key) {
+    const int64_t start = steadyNowNs();
+    const int64_t budget = spinBudgetNs();
+    if (budget > 0) {
+        for (unsigned i = 1;; i++) {
+            if (epoch.load(std::memory_order_acquire) != key) {
+                const int64_t now = steadyNowNs();
+                waiters.fetch_sub(1, std::memory_order_seq_cst);
+                spinWakeups.fetch_add(1, std::memory_order_relaxed);
+                spinNs.fetch_add(now - start, std::memory_order_relaxed);
+                spinLatencyNs.fetch_add(std::max<int64_t>(0, now - lastNotifyNs.load(std::memory_order_relaxed)),
+                                        std::memory_order_relaxed);
+                recordWait(now - start);
+                return;
+            }
+            cpuRelax();
+            if ((i & 15) == 0 && steadyNowNs() - start >= budget) break;
+        }
+    }
+
+    const int64_t parkStart = steadyNowNs();
+    spinNs.fetch_add(parkStart - start, std::memory_order_relaxed);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    bool slept = false;
+    while (epoch.load(std::memory_order_acquire) == key) {
+        waitSyscalls.fetch_add(1, std::memory_order_relaxed);
+        futex(&epoch, FUTEX_WAIT_PRIVATE, key);
+        slept = true;
+    }
+    sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+    const int64_t end = steadyNowNs();
+    recordWait(end - start);
+    if (slept) {
+        parkedWakeups.fetch_add(1, std::memory_order_relaxed);
+        parkedNs.fetch_add(end - parkStart, std::memory_order_relaxed);
+        const int64_t latency = std::max<int64_t>(0, end - lastNotifyNs.load(std::memory_order_relaxed));
+        wakeLatencyNs.fetch_add(latency, std::memory_order_relaxed);
+        int64_t peak = maxWakeLatencyNs.load(std::memory_order_relaxed);
+        while (latency > peak && !maxWakeLatencyNs.compare_exchange_weak(peak, latency)) {
+        }
+    } else {
+        spinWakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void EventCount::notifyOne() {
+    notify(1);
+}
+
+void EventCount::notifyAll() {
+    notify(INT_MAX);
+}
+
+/**
+ * @brief Avanza la época si hay hilos registrados y despierta a los que duermen.
+ *
+ * La barrera ordena la publicación de la condición antes de leer `waiters`: o el
+ * esperador ve la condición al volver a comprobarla, o este notify ve al esperador.
+ */
+void EventCount::notify(int count) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) == 0) {
+        skippedNotifies.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    notifies.fetch_add(1, std::memory_order_relaxed);
+    lastNotifyNs.store(steadyNowNs(), std::memory_order_relaxed);
+    epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        wakeSyscalls.fetch_add(1, std::memory_order_relaxed);
+        futex(&epoch, FUTEX_WAKE_PRIVATE, static_cast<uint32_t>(count));
+    }
+}
+
+EventCountStats EventCount::stats() const {
+    EventCountStats result;
+    result.notifies = notifies.load();
+    result.skippedNotifies = skippedNotifies.load();
+    result.wakeSyscalls = wakeSyscalls.load();
+    result.waitSyscalls = waitSyscalls.load();
+    result.spinWakeups = spinWakeups.load();
+    result.parkedWakeups = parkedWakeups.load();
+    result.wakeLatencyNs = wakeLatencyNs.load();
+    result.maxWakeLatencyNs = maxWakeLatencyNs.load();
+    result.spinLatencyNs = spinLatencyNs.load();
+    result.spinNs = spinNs.load();
+    result.parkedNs = parkedNs.load();
+    return result;
+}
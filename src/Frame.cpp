@@ -0,0 +1,163 @@
+/**
+ * @file Frame.cpp
+ * @brief Fotogramas ligeros, pool de bloques reutilizables e interoperabilidad con OpenCV.
+ */
+
+#include "Frame.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+/// Alineación de los bloques, una línea de caché.
+constexpr size_t kFrameAlignment = 64;
+
+uint8_t* allocateBlock(size_t bytes) {
+    // aligned_alloc exige un tamaño múltiplo de la alineación
+    const size_t rounded = (bytes + kFrameAlignment - 1) / kFrameAlignment * kFrameAlignment;
+    return static_cast<uint8_t*>(std::aligned_alloc(kFrameAlignment, std::max(rounded, kFrameAlignment)));
+}
+} // namespace
+
+int pixelChannels(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::Bgr8: return 3;
+        case PixelFormat::Bgra8: return 4;
+        case PixelFormat::Gray8:
+        case PixelFormat::Gray16:
+        default: return 1;
+    }
+}
+
+int pixelBytes(PixelFormat format) {
+    return format == PixelFormat::Gray16 ? 2 : pixelChannels(format);
+}
+
+bool parsePixelFormat(const std::string& text, PixelFormat& format) {
+    if (text == "bgr") format = PixelFormat::Bgr8;
+    else if (text == "bgra") format = PixelFormat::Bgra8;
+    else if (text == "gray") format = PixelFormat::Gray8;
+    else if (text == "gray16") format = PixelFormat::Gray16;
+    else return false;
+    return true;
+}
+
+const char* pixelFormatName(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::Bgr8: return "bgr";
+        case PixelFormat::Bgra8: return "bgra";
+        case PixelFormat::Gray8: return "gray";
+        case PixelFormat::Gray16: return "gray16";
+        default: return "desconocido";
+    }
+}
+
+Frame Frame::allocate(int width, int height, PixelFormat format) {
+    const size_t stride = static_cast<size_t>(width) * pixelBytes(format);
+    uint8_t* block = allocateBlock(stride * height);
+    if (!block) return Frame();
+    return wrap(block, width, height, stride, format, std::shared_ptr<void>(block, std::free));
+}
+
+Frame Frame::wrap(void* data, int width, int height, size_t stride, PixelFormat format,
+                  std::shared_ptr<void> owner) {
+    Frame frame;
+    frame.owner = std::move(owner);
+    frame.pixels = static_cast<uint8_t*>(data);
+    frame.cols = width;
+    frame.rows = height;
+    frame.rowBytes = stride;
+    frame.pixelFormat = format;
+    return frame;
+}
+
+void Frame::create(int width, int height, PixelFormat format) {
+    if (pixels && cols == width && rows == height && pixelFormat == format) return;
+    *this = allocate(width, height, format);
+}
+
+FramePool::FramePool(int width, int height, PixelFormat format)
+    : width(width), height(height), format(format), state(std::make_shared<State>()) {}
+
+FramePool::State::~State() {
+    for (uint8_t* block : free) std::free(block);
+}
+
+/**
+ * @brief Toma un bloque libre o reserva uno; el dueño del Frame lo devuelve al pool.
+ */
+Frame FramePool::acquire() {
+    const size_t stride = static_cast<size_t>(width) * pixelBytes(format);
+    uint8_t* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->free.empty()) {
+            block = state->free.back();
+            state->free.pop_back();
+            state->reused++;
+        } else {
+            state->allocated++;
+        }
+    }
+    if (!block) block = allocateBlock(stride * height);
+    if (!block) return Frame();
+
+    // El dueño guarda el estado: los bloques en curso pueden sobrevivir al pool
+    std::shared_ptr<State> poolState = state;
+    std::shared_ptr<void> owner(block, [poolState](void* released) {
+        std::lock_guard<std::mutex> lock(poolState->mutex);
+        poolState->free.push_back(static_cast<uint8_t*>(released));
+    });
+    return Frame::wrap(block, width, height, stride, format, std::move(owner));
+}
+
+bool FramePool::prefault() {
+    const size_t bytes = static_cast<size_t>(width) * pixelBytes(format) * height;
+    uint8_t* block = allocateBlock(bytes);
+    if (!block) return false;
+    std::memset(block, 0, bytes);
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->free.push_back(block);
+    state->allocated++;
+    return true;
+}
+
+size_t FramePool::allocated() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->allocated;
+}
+
+size_t FramePool::reused() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->reused;
+}
+
+#ifdef FASTCAP_HAVE_OPENCV
+int toCvType(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::Bgra8: return CV_8UC4;
+        case PixelFormat::Gray8: return CV_8UC1;
+        case PixelFormat::Gray16: return CV_16UC1;
+        case PixelFormat::Bgr8:
+        default: return CV_8UC3;
+    }
+}
+
+cv::Mat toMat(const Frame& frame) {
+    return cv::Mat(frame.height(), frame.width(), toCvType(frame.format()),
+                   const_cast<uint8_t*>(frame.data()), frame.stride());
+}
+
+Frame fromMat(const cv::Mat& image) {
+    PixelFormat format;
+    switch (image.type()) {
+        case CV_8UC3: format = PixelFormat::Bgr8; break;
+        case CV_8UC4: format = PixelFormat::Bgra8; break;
+        case CV_8UC1: format = PixelFormat::Gray8; break;
+        case CV_16UC1: format = PixelFormat::Gray16; break;
+        default: return Frame();
+    }
+    auto owner = std::make_shared<cv::Mat>(image);
+    return Frame::wrap(owner->data, image.cols, image.rows, image.step, format, owner);
+}
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file FrameCipher.cpp
+ * @brief Cifrado autenticado de fotogramas con OpenSSL EVP e índice de nonces.
+ */
+
+#include "FrameCipher.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+#ifdef FASTCAP_HAVE_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+/**
+ * @brief Lee una clave binaria de 32 bytes o hexadecimal de 64 dígitos.
+ */
+bool loadCipherKey(const std::string& path, std::array<unsigned char, 32>& key) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (content.size() == key.size()) {
+        std::copy(content.begin(), content.end(), key.begin());
+        return true;
+    }
+
+    std::string hex;
+    for (char c : content) {
+        if (!std::isspace(static_cast<unsigned char>(c))) hex += c;
+    }
+    if (hex.size() != key.size() * 2) return false;
+    for (size_t i = 0; i < key.size(); i++) {
+        try {
+            size_t used = 0;
+            key[i] = static_cast<unsigned char>(std::stoul(hex.substr(i * 2, 2), &used, 16));
+            if (used != 2) return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sal en big-endian seguida de la secuencia en big-endian.
+ */
+CipherNonce makeCipherNonce(uint32_t salt, uint64_t sequence) {
+    CipherNonce nonce{};
+    for (int i = 0; i < 4; i++) nonce[i] = static_cast<unsigned char>(salt >> (24 - 8 * i));
+    for (int i = 0; i < 8; i++) nonce[4 + i] = static_cast<unsigned char>(sequence >> (56 - 8 * i));
+    return nonce;
+}
+
+/**
+ * @brief SHA-256 de la clave truncado a 8 bytes.
+ */
+std::string cipherKeyId(const std::array<unsigned char, 32>& key) {
+#ifdef FASTCAP_HAVE_OPENSSL
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    if (EVP_Digest(key.data(), key.size(), digest, &length, EVP_sha256(), nullptr) != 1 || length < 8) return "";
+    char text[17];
+    for (int i = 0; i < 8; i++) std::snprintf(text + 2 * i, 3, "%02x", digest[i]);
+    return text;
+#else
+    (void)key;
+    return "";
+#endif
+}
+
+std::string nonceToHex(const CipherNonce& nonce) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text;
+    for (unsigned char byte : nonce) {
+        text += digits[byte >> 4];
+        text += digits[byte & 0x0f];
+    }
+    return text;
+}
+
+bool nonceFromHex(const std::string& text, CipherNonce& nonce) {
+    if (text.size() != nonce.size() * 2) return false;
+    for (size_t i = 0; i < nonce.size(); i++) {
+        unsigned value = 0;
+        for (int j = 0; j < 2; j++) {
+            const char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i * 2 + j])));
+            if (c >= '0' && c <= '9') value = value * 16 + (c - '0');
+            else if (c >= 'a' && c <= 'f') value = value * 16 + (c - 'a' + 10);
+            else return false;
+        }
+        nonce[i] = static_cast<unsigned char>(value);
+    }
+    return true;
+}
+
+#ifdef FASTCAP_HAVE_OPENSSL
+namespace {
+const EVP_CIPHER* selectCipher(const std::string& algorithm) {
+    if (algorithm == "aes-256-gcm") return EVP_aes_256_gcm();
+    if (algorithm == "chacha20-poly1305") return EVP_chacha20_poly1305();
+    return nullptr;
+}
+
+/**
+ * @brief Inicializa el contexto con algoritmo y clave; el nonce se fija por fotograma.
+ */
+EVP_CIPHER_CTX* createContext(const CipherSettings& settings, bool decrypt) {
+    const EVP_CIPHER* cipher = selectCipher(settings.algorithm);
+    if (!cipher) return nullptr;
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    if (!ctx) return nullptr;
+    const int ok = EVP_CipherInit_ex(ctx, cipher, nullptr, nullptr, nullptr, decrypt ? 0 : 1) == 1 &&
+                   EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, static_cast<int>(kCipherNonceSize), nullptr) == 1 &&
+                   EVP_CipherInit_ex(ctx, nullptr, nullptr, settings.key.data(), nullptr, -1) == 1;
+    if (!ok) {
+        EVP_CIPHER_CTX_free(ctx);
+        return nullptr;
+    }
+    return ctx;
+}
+} // namespace
+#endif
+
+/**
+ * @brief Prepara el contexto de cifrado (la clave se expande una sola vez).
+ */
+FrameCipher::FrameCipher(const CipherSettings& settings) : settings(settings) {
+#ifdef FASTCAP_HAVE_OPENSSL
+    context = createContext(settings, false);
+#endif
+}
+
+FrameCipher::~FrameCipher() {
+#ifdef FASTCAP_HAVE_OPENSSL
+    EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX*>(context));
+#endif
+}
+
+/**
+ * @brief Cifra en el propio buffer y añade la etiqueta de autenticación.
+ */
+bool FrameCipher::encrypt(std::vector<unsigned char>& buffer, const CipherNonce& nonce, const std::string& name) {
+#ifdef FASTCAP_HAVE_OPENSSL
+    if (decrypting) {
+        EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX*>(context));
+        context = createContext(settings, false);
+        decrypting = false;
+    }
+    auto* ctx = static_cast<EVP_CIPHER_CTX*>(context);
+    if (!ctx) return false;
+
+    int length = 0, finalLength = 0;
+    const size_t size = buffer.size();
+    bool ok = EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce.data(), 1) == 1 &&
+              EVP_CipherUpdate(ctx, nullptr, &length, reinterpret_cast<const unsigned char*>(name.data()),
+                               static_cast<int>(name.size())) == 1 &&
+              EVP_CipherUpdate(ctx, buffer.data(), &length, buffer.data(), static_cast<int>(size)) == 1 &&
+              EVP_CipherFinal_ex(ctx, buffer.data() + length, &finalLength) == 1;
+    if (!ok) return false;
+
+    buffer.resize(size + kCipherTagSize);
+    return EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, static_cast<int>(kCipherTagSize), buffer.data() + size) == 1;
+#else
+    (void)buffer; (void)nonce; (void)name;
+    return false;
+#endif
+}
+
+/**
+ * @brief Verifica la etiqueta y descifra en el propio buffer.
+ */
+bool FrameCipher::decrypt(std::vector<unsigned char>& buffer, const CipherNonce& nonce, const std::string& name) {
+#ifdef FASTCAP_HAVE_OPENSSL
+    if (!decrypting) {
+        EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX*>(context));
+        context = createContext(settings, true);
+        decrypting = true;
+    }
+    auto* ctx = static_cast<EVP_CIPHER_CTX*>(context);
+    if (!ctx || buffer.size() < kCipherTagSize) return false;
+
+    const size_t size = buffer.size() - kCipherTagSize;
+    int length = 0, finalLength = 0;
+    const bool ok = EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce.data(), 0) == 1 &&
+                    EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, static_cast<int>(kCipherTagSize),
+                                        buffer.data() + size) == 1 &&
+                    EVP_CipherUpdate(ctx, nullptr, &length, reinterpret_cast<const unsigned char*>(name.data()),
+                                     static_cast<int>(name.size())) == 1 &&
+                    EVP_CipherUpdate(ctx, buffer.data(), &length, buffer.data(), static_cast<int>(size)) == 1 &&
+                    EVP_CipherFinal_ex(ctx, buffer.data() + length, &finalLength) == 1;
+    if (!ok) return false;
+    buffer.resize(size);
+    return true;
+#else
+    (void)buffer; (void)nonce; (void)name;
+    return false;
+#endif
+}
+
+bool FrameCipher::available() {
+#ifdef FASTCAP_HAVE_OPENSSL
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FrameCipher::isValidAlgorithm(const std::string& algorithm) {
+    return algorithm == "aes-256-gcm" || algorithm == "chacha20-poly1305";
+}
+
+/**
+ * @brief Aceleración que OpenSSL puede usar en esta CPU para el algoritmo.
+ */
+std::string FrameCipher::acceleration(const std::string& algorithm) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (algorithm == "aes-256-gcm") {
+        if (__builtin_cpu_supports("vaes") && __builtin_cpu_supports("vpclmulqdq")) return "VAES + VPCLMULQDQ";
+        if (__builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul")) return "AES-NI + PCLMULQDQ";
+        return "sin AES-NI";
+    }
+    if (__builtin_cpu_supports("avx512f")) return "AVX-512";
+    if (__builtin_cpu_supports("avx2")) return "AVX2";
+    return "SSE";
+#else
+    (void)algorithm;
+    return "según la CPU";
+#endif
+}
+
+/**
+ * @brief Abre el índice en modo añadir y deja en disco la cabecera de la ejecución.
+ */
+bool CipherIndex::open(const std::string& path, const CipherSettings& settings) {
+    std::lock_guard<std::mutex> lock(mutex);
+    file = std::fopen(path.c_str(), "a");
+    filePath = path;
+    if (!file) return false;
+    // Sin la sal no se pueden reconstruir los nonces: la cabecera se sincroniza ya
+    std::fprintf(file, "run %08x %s %s\n", static_cast<unsigned>(settings.salt),
+                 cipherKeyId(settings.key).c_str(), settings.algorithm.c_str());
+    return std::fflush(file) == 0 && fsync(fileno(file)) == 0;
+}
+
+/**
+ * @brief Añade la línea del fotograma y la vuelca al sistema de archivos.
+ */
+void CipherIndex::record(const std::string& name, const CipherNonce& nonce, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) return;
+    std::fprintf(file, "%s %s %zu\n", name.c_str(), nonceToHex(nonce).c_str(), size);
+    std::fflush(file);
+}
+
+void CipherIndex::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file) {
+        std::fflush(file);
+        fsync(fileno(file));
+        std::fclose(file);
+        file = nullptr;
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file FrameSource.cpp
+ * @brief Orígenes de fotogramas: ruido aleatorio y banco de fotogramas pregenerados.
+ */
+
+#include "FrameSource.h"
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+namespace {
+/**
+ * @brief Semilla distinta para cada origen (varios generadores en el modo por núcleo).
+ */
+uint64_t nextNoiseSeed() {
+    static std::atomic<uint64_t> sources{0};
+    return sources.fetch_add(1) + 1;
+}
+
+/**
+ * @brief Hilos de preparación para `items` tareas: uno por núcleo, sin pasar de `items`.
+ */
+size_t warmupThreads(size_t items) {
+    return std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), items);
+}
+
+} // namespace
+
+/**
+ * @brief Crea un origen de ruido aleatorio y lanza la pre-carga de bloques del pool.
+ * @param width Ancho de las imágenes.
+ * @param height Alto de las imágenes.
+ * @param kernels Núcleos del formato de píxel.
+ * @param prefaultBlocks Bloques del pool que se pre-cargan en segundo plano.
+ */
+NoiseFrameSource::NoiseFrameSource(int width, int height, const PixelKernels& kernels, size_t prefaultBlocks)
+    : kernels(kernels), pool(width, height, kernels.format), noise(nextNoiseSeed()), prefaultBlocks(prefaultBlocks) {
+    for (size_t t = 0; t < warmupThreads(prefaultBlocks); t++) {
+        warmup.emplace_back([this] {
+            while (prefaultClaimed.fetch_add(1) < this->prefaultBlocks) {
+                pool.prefault();
+                prefaultDone++;
+            }
+        });
+    }
+}
+
+NoiseFrameSource::~NoiseFrameSource() {
+    for (auto& thread : warmup) thread.join();
+}
+
+/**
+ * @brief Genera una imagen de ruido nueva en un bloque del pool.
+ */
+Frame NoiseFrameSource::next() {
+    Frame frame = pool.acquire();
+    if (!frame.empty()) kernels.fillNoise(frame, noise);
+    return frame;
+}
+
+/**
+ * @brief Descripción del origen de ruido.
+ */
+std::string NoiseFrameSource::describe() const {
+    if (prefaultBlocks == 0) return "ruido aleatorio";
+    std::ostringstream oss;
+    oss << "ruido aleatorio, " << prefaultBlocks << " bloques pre-cargados en segundo plano";
+    return oss.str();
+}
+
+bool NoiseFrameSource::ready() const {
+    return prefaultDone.load() >= prefaultBlocks;
+}
+
+/**
+ * @brief Crea el banco: genera el primer fotograma y lanza la generación del resto.
+ * @param width Ancho de las imágenes.
+ * @param height Alto de las imágenes.
+ * @param count Número de fotogramas distintos del banco (al menos 1).
+ * @param kernels Núcleos del formato de píxel.
+ */
+FrameBankSource::FrameBankSource(int width, int height, size_t count, const PixelKernels& kernels)
+    : frames(std::max<size_t>(count, 1)), filled(new std::atomic<bool>[frames.size()]) {
+    for (size_t i = 0; i < frames.size(); i++) filled[i] = false;
+    NoiseState noise(nextNoiseSeed());
+    frames[0] = Frame::allocate(width, height, kernels.format);
+    kernels.fillNoise(frames[0], noise);
+    filled[0] = true;
+
+    // Cada hilo reserva (y así pre-carga) y rellena los fotogramas que va tomando
+    for (size_t t = 0; t < warmupThreads(frames.size() - 1); t++) {
+        warmup.emplace_back([this, width, height, &kernels] {
+            NoiseState threadNoise(nextNoiseSeed());
+            for (size_t i = nextToFill.fetch_add(1); i < frames.size(); i = nextToFill.fetch_add(1)) {
+                frames[i] = Frame::allocate(width, height, kernels.format);
+                kernels.fillNoise(frames[i], threadNoise);
+                filled[i].store(true, std::memory_order_release);
+                filledCount++;
+            }
+        });
+    }
+}
+
+FrameBankSource::~FrameBankSource() {
+    for (auto& thread : warmup) thread.join();
+}
+
+/**
+ * @brief Entrega el siguiente fotograma del banco, compartiendo su memoria.
+ *
+ * Mientras el banco se completa, el ciclo cubre solo el prefijo ya generado.
+ */
+Frame FrameBankSource::next() {
+    while (available < frames.size() && filled[available].load(std::memory_order_acquire)) {
+        available++;
+    }
+    const Frame& frame = frames[cursor];
+    cursor = (cursor + 1) % available;
+    return frame;
+}
+
+/**
+ * @brief Descripción del banco de fotogramas.
+ */
+std::string FrameBankSource::describe() const {
+    std::ostringstream oss;
+    oss << "banco de " << frames.size() << " fotogramas";
+    if (frames.size() > 1) oss << ", generados en segundo plano";
+    return oss.str();
+}
+
+bool FrameBankSource::ready() const {
+    return filledCount.load() == frames.size();
+}
+
+/**
+ * @brief Crea el origen de fotogramas adecuado.
+ * @param width Ancho de las imágenes.
+ * @param height Alto de las imágenes.
+ * @param bankSize Tamaño del banco de fotogramas; 0 genera ruido nuevo en cada fotograma.
+ * @param pixelFormat Formato de píxel de los fotogramas.
+ * @param prefaultBlocks Bloques del pool de ruido que se pre-cargan en segundo plano (sin banco).
+ * @return Origen de fotogramas, o nullptr si el formato no está soportado.
+ */
+std::unique_ptr<FrameSource> createFrameSource(int width, int height, size_t bankSize, PixelFormat pixelFormat,
+                                               size_t prefaultBlocks) {
+    const PixelKernels* kernels = selectPixelKernels(pixelFormat, width, height);
+    if (!kernels) return nullptr;
+    if (bankSize > 0) {
+        return std::make_unique<FrameBankSource>(width, height, bankSize, *kernels);
+    }
+    return std::make_unique<NoiseFrameSource>(width, height, *kernels, prefaultBlocks);
+}
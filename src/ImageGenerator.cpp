@@ -4,92 +4,137 @@
  */
 
 #include "ImageGenerator.h"
-#include <opencv2/imgproc.hpp>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
-#include <thread>
 
 /**
- * @brief Genera una imagen aleatoria con valores de píxel entre 0 y 255.
+ * @brief Función para el hilo que genera imágenes aleatorias siguiendo un perfil de carga.
  * 
- * @param width Ancho de la imagen.
- * @param height Alto de la imagen.
- * @return cv::Mat Imagen aleatoria de tipo CV_8UC3.
- */
-cv::Mat generateRandomImage(int width, int height) {
-    cv::Mat randomImage(height, width, CV_8UC3);
-    cv::randu(randomImage, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
-    return randomImage;
-}
-
-/**
- * @brief Función para el hilo que genera imágenes aleatorias a una tasa constante.
- * 
- * Genera imágenes de tamaño `width` x `height` y las encola en `queue` para ser procesadas
- * en otro hilo. Intenta mantener un framerate de `targetFPS` durante `runDuration`.
+ * Obtiene imágenes de `source` y las encola en `queue` para ser procesadas en otro hilo.
+ * Los instantes de llegada se calculan con `profile` (tasa constante, escalones, rampas,
+ * ráfagas o llegadas de Poisson) durante `runDuration`, medidos con `clock`, que puede
+ * ser un reloj virtual para simular ejecuciones largas.
  * 
- * @param queue Cola segura para compartir las imágenes generadas.
- * @param width Ancho de cada imagen generada.
- * @param height Alto de cada imagen generada.
- * @param targetFPS Tasa de frames por segundo deseada.
+ * @param queue Destino de las imágenes generadas: la cola de los escritores o el runtime de tareas.
+ * @param source Origen de los fotogramas (ruido o banco de fotogramas).
+ * @param profile Perfil de carga que define la tasa objetivo en cada instante.
+ * @param clock Reloj usado para el ritmo de generación.
  * @param runDuration Duración total para la generación de imágenes.
- * @param statsImageCount Referencia atómica que contabiliza el total de imágenes generadas.
+ * @param stats Contadores compartidos; `imagesGenerated` también reparte los números de secuencia.
+ * @param firstSequence Número de secuencia del primer fotograma (continúa una grabación recuperada).
+ * @param generatorIndex Índice de este generador cuando hay varios (modo por núcleo).
+ * @param generatorCount Generadores que se reparten el perfil: cada uno genera 1/N de la tasa,
+ *        desfasado para que las llegadas se intercalen. Solo el generador 0 muestra el progreso,
+ *        con la tasa total.
  */
 void imageGeneratorThread(
-    ThreadSafeQueue& queue, 
-    int width, 
-    int height, 
-    int targetFPS,
+    FrameSink& queue, 
+    FrameSource& source, 
+    LoadProfile& profile,
+    Clock& clock,
     std::chrono::seconds runDuration,
-    std::atomic<size_t>& statsImageCount,
-    std::atomic<size_t>& imagesEnqueued) {
+    PipelineStats& stats,
+    uint64_t firstSequence,
+    int generatorIndex,
+    int generatorCount) {
     
-    const auto startTime = std::chrono::steady_clock::now();
+    const auto startTime = clock.now();
     const auto endTime = startTime + runDuration;
-    size_t frameCount = 0;
+    // Las marcas de tiempo son de pared, pero avanzan con `clock` (también en simulación)
+    const auto wallStart = std::chrono::system_clock::now();
+    const bool printProgress = generatorIndex == 0;
+    generatorCount = std::max(generatorCount, 1);
     
-    // Duración de cada frame en microsegundos
-    const auto frameDuration = std::chrono::microseconds(1000000 / targetFPS);
+    // Instante programado para el siguiente fotograma. La primera llegada también la decide
+    // el perfil (un perfil que empieza a tasa 0 no genera nada en t=0); con varios
+    // generadores, el i-ésimo atiende la llegada i+1 y las siguientes de N en N
+    auto nextFrameTime = endTime;
+    const auto first = profile.nextInterval(0.0);
+    if (first != std::chrono::microseconds::max()) nextFrameTime = startTime + first * (generatorIndex + 1);
     
-    std::cout << "Iniciando generador de imágenes a " << targetFPS << " FPS durante " 
-              << runDuration.count() << " segundos." << std::endl;
+    if (printProgress) {
+        std::cout << "Iniciando generador de imágenes a " << profile.describe() << " durante " 
+                  << runDuration.count() << " segundos";
+        if (generatorCount > 1) std::cout << " (repartido entre " << generatorCount << " generadores)";
+        std::cout << "." << std::endl;
+    }
              
     long lastPrintedSecond = -1;
+    size_t framesAtLastPrint = 0;
+    auto lastPrintTime = startTime;
 
-    while (std::chrono::steady_clock::now() < endTime) {
-        auto frameStartTime = std::chrono::steady_clock::now();
+    while (clock.now() < endTime) {
+        // Esperar la siguiente llegada según el perfil
+        if (clock.now() < nextFrameTime) {
+            clock.settle();
+            clock.sleepUntil(std::min(nextFrameTime, endTime));
+            continue;
+        }
+
+        // Retraso de activación respecto a la llegada programada
+        const auto frameStartTime = clock.now();
+        const int64_t wakeupLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            frameStartTime - nextFrameTime).count();
+        int64_t maxLatency = stats.maxWakeupLatencyUs.load(std::memory_order_relaxed);
+        while (wakeupLatencyUs > maxLatency &&
+               !stats.maxWakeupLatencyUs.compare_exchange_weak(maxLatency, wakeupLatencyUs)) {
+        }
 
-        // Generar imagen
-        cv::Mat img = generateRandomImage(width, height);
+        // Obtener imagen
+        Frame img = source.next();
 
         // Encolar imagen para ser grabada
-        if (queue.push(ImageData(img, statsImageCount))) {
-            imagesEnqueued++;
+        const int64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            (wallStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(frameStartTime - startTime))
+                .time_since_epoch()).count();
+        // El contador global reparte los números de secuencia entre generadores
+        const uint64_t sequence = firstSequence + stats.imagesGenerated.fetch_add(1);
+        if (queue.push(ImageData(img, sequence, timestampNs))) {
+            stats.imagesEnqueued++;
         }
 
-        // Actualizar estadísticas
-        frameCount++;
-        statsImageCount++;
+        // Programar la siguiente llegada
+        const double scheduledSeconds = std::chrono::duration<double>(nextFrameTime - startTime).count();
+        const auto profileInterval = profile.nextInterval(scheduledSeconds);
+        const auto frameEndTime = clock.now();
 
-        // Regular FPS
-        auto frameEndTime = std::chrono::steady_clock::now();
-        auto processingTime = frameEndTime - frameStartTime;
-
-        if (processingTime < frameDuration) {
-            std::this_thread::sleep_for(frameDuration - processingTime);
+        if (profileInterval == std::chrono::microseconds::max()) {
+            nextFrameTime = endTime; // El perfil no tiene más llegadas
+        } else {
+            // Con N generadores cada uno atiende una de cada N llegadas
+            const auto interval = profileInterval * generatorCount;
+            nextFrameTime += interval;
+            // Plazo incumplido: el fotograma terminó después de la llegada siguiente
+            if (frameEndTime > nextFrameTime) {
+                stats.deadlineMisses++;
+            }
+            // Si la generación se retrasó más de un intervalo, no acumular atraso
+            if (nextFrameTime + interval < frameEndTime) {
+                nextFrameTime = frameEndTime;
+            }
         }
 
         //una vez por segundo (10 sec 10 mesajes mensaje)
         auto elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now() - startTime).count();
+            frameEndTime - startTime).count();
 
-        if (elapsedSeconds != lastPrintedSecond) {
+        if (printProgress && elapsedSeconds != lastPrintedSecond) {
+            const size_t frameCount = stats.imagesGenerated.load(std::memory_order_relaxed);
             lastPrintedSecond = elapsedSeconds;
             if (elapsedSeconds > 0) {
-                float currentFPS = static_cast<float>(frameCount) / elapsedSeconds;
+                // FPS del último intervalo, para observar los transitorios del perfil
+                const double window = std::chrono::duration<double>(frameEndTime - lastPrintTime).count();
+                float currentFPS = static_cast<float>((frameCount - framesAtLastPrint) / window);
                 std::cout << "Generando: " << std::fixed << std::setprecision(2) 
-                        << currentFPS << " FPS (Cola: " << queue.size() << ")" << std::endl;
+                        << currentFPS << " FPS (";
+                if (!profile.isConstant()) {
+                    std::cout << "Objetivo: " << profile.rateAt(scheduledSeconds) << ", ";
+                }
+                std::cout << "Cola: " << queue.size() << ")" << std::endl;
             }
+            framesAtLastPrint = frameCount;
+            lastPrintTime = frameEndTime;
         }
     }
 }
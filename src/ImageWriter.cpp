@@ -1,69 +1,264 @@
 /**
  * @file ImageWriter.cpp
- * @brief Hilo encargado de escribir imágenes desde una cola en archivos JPEG usando TurboJPEG.
+ * @brief Hilo encargado de codificar imágenes desde una cola y guardarlas en el destino configurado.
  */
 
 #include "ImageWriter.h"
-#include "TurboJPEGWriter.h"
-#include <opencv2/imgcodecs.hpp>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <sstream>
-#include <filesystem>
 #include <vector>
 
 /**
- * @brief Función para el hilo que escribe imágenes JPEG desde una cola segura.
+ * @brief Instante actual del reloj monotónico en nanosegundos.
+ */
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void WriterHeartbeat::enter(Stage stage, uint64_t sequence) {
+    currentSequence.store(sequence, std::memory_order_relaxed);
+    stageStartNs.store(steadyNowNs(), std::memory_order_relaxed);
+    currentStage.store(static_cast<int>(stage), std::memory_order_release);
+}
+
+void WriterHeartbeat::setFile(const std::string& name) {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    currentFile = name;
+}
+
+void WriterHeartbeat::idle() {
+    currentStage.store(static_cast<int>(Stage::Idle), std::memory_order_release);
+}
+
+double WriterHeartbeat::stageSeconds() const {
+    return (steadyNowNs() - stageStartNs.load(std::memory_order_relaxed)) / 1e9;
+}
+
+std::string WriterHeartbeat::file() const {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    return currentFile;
+}
+
+const char* WriterHeartbeat::stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Encode: return "codificación";
+        case Stage::Cipher: return "cifrado";
+        case Stage::Throttle: return "limitador";
+        case Stage::Write: return "escritura";
+        case Stage::Idle:
+        default: return "inactivo";
+    }
+}
+
+/**
+ * @brief Crea el codificador y, si se pidió, el contexto de cifrado del hilo.
+ * @param encoderSettings Formato del codificador.
+ * @param quality Calidad vigente.
+ * @param cipherSettings Cifrado en reposo.
+ * @param stats Contadores compartidos.
+ * @param threadId Identificador para los nombres de archivo y los mensajes.
+ */
+FrameProcessor::FrameProcessor(const EncoderSettings& encoderSettings, const std::atomic<int>& quality,
+                               const CipherSettings& cipherSettings, PipelineStats& stats, int threadId)
+    : quality(quality), cipherSettings(cipherSettings), stats(stats), threadId(threadId),
+      currentQuality(encoderSettings.quality) {
+    encoder = createEncoder(encoderSettings);
+    if (!encoder) {
+        std::cerr << "Hilo #" << threadId << ": no se pudo crear el codificador '" 
+                  << encoderSettings.format << "'" << std::endl;
+        return;
+    }
+    // Buffer compartido: los destinos asíncronos (espejo) pueden conservarlo tras escribir
+    buffer = std::make_shared<std::vector<unsigned char>>();
+
+    // Cifrado opcional entre el codificador y el almacenamiento, en el propio buffer
+    if (cipherSettings.enabled) {
+        cipher = std::make_unique<FrameCipher>(cipherSettings);
+        if (!cipher->isValid()) {
+            std::cerr << "Hilo #" << threadId << ": no se pudo inicializar el cifrado "
+                      << cipherSettings.algorithm << std::endl;
+            return;
+        }
+    }
+    valid = true;
+}
+
+/**
+ * @brief Codifica y cifra un fotograma en el buffer del hilo.
+ * @param data Imagen a codificar.
+ * @param frame Nombre, buffer, metadatos y nonce del resultado.
+ * @param heartbeat Latido con la etapa y el archivo en curso (opcional).
+ * @return true si el fotograma está listo; false si falló la codificación o el cifrado.
+ */
+bool FrameProcessor::encode(const ImageData& data, EncodedFrame& frame, WriterHeartbeat* heartbeat) {
+    if (heartbeat) heartbeat->enter(WriterHeartbeat::Stage::Encode, data.sequenceNumber);
+
+    // Aplicar cambios de calidad hechos en ejecución
+    const int requestedQuality = quality.load(std::memory_order_relaxed);
+    if (requestedQuality != currentQuality) {
+        encoder->setQuality(requestedQuality);
+        currentQuality = requestedQuality;
+    }
+
+    // Crear nombre de archivo
+    std::ostringstream filename;
+    filename << "img_" << std::setw(8) << std::setfill('0') 
+            << data.sequenceNumber << "_t" << threadId << "." << encoder->extension();
+    if (cipher) filename << ".enc";
+    frame.name = filename.str();
+    frame.meta.sequence = data.sequenceNumber;
+    frame.meta.timestampNs = data.timestampNs;
+    frame.encrypted = false;
+    frame.writer = threadId;
+    if (heartbeat) heartbeat->setFile(frame.name);
+
+    // Si algún destino (o una escritura pendiente) sigue usando el buffer anterior, codificar en uno nuevo
+    frame.buffer.reset();
+    if (buffer.use_count() > 1) {
+        const size_t capacity = buffer->capacity();
+        buffer = std::make_shared<std::vector<unsigned char>>();
+        buffer->reserve(capacity);
+    }
+    frame.buffer = buffer;
+
+    const int64_t encodeStart = steadyNowNs();
+    if (!encoder->encode(data.image, *buffer)) {
+        std::cerr << "Error al codificar imagen: " << frame.name << std::endl;
+        return false;
+    }
+    stats.encodeLatency.record(steadyNowNs() - encodeStart);
+
+    // Cifrar con un nonce único por fotograma (sal de la ejecución + secuencia)
+    if (cipher) {
+        if (heartbeat) heartbeat->enter(WriterHeartbeat::Stage::Cipher, data.sequenceNumber);
+        frame.nonce = makeCipherNonce(cipherSettings.salt, data.sequenceNumber);
+        const size_t plainSize = buffer->size();
+        const auto cipherStart = std::chrono::steady_clock::now();
+        if (!cipher->encrypt(*buffer, frame.nonce, frame.name)) {
+            std::cerr << "Error al cifrar imagen: " << frame.name << std::endl;
+            return false;
+        }
+        stats.cipherNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - cipherStart).count();
+        stats.cipherBytes += plainSize;
+        frame.encrypted = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe un fotograma codificado en el destino.
+ *
+ * Respeta el limitador compartido (la espera se contabiliza aparte). Si la escritura
+ * falla, el fotograma se entrega a la cola de reintentos y el llamador puede seguir;
+ * si no hay cola o está llena, se cuenta como perdido.
+ *
+ * @param frame Fotograma codificado.
+ * @param storage Destino.
+ * @param cipherSettings Cifrado; con índice de nonces se registra el fotograma.
+ * @param stats Contadores compartidos del pipeline.
+ * @param limiter Limitador de bytes/s e IOPS (opcional).
+ * @param retries Cola de reintentos (opcional).
+ * @param heartbeat Latido con la etapa en curso (opcional).
+ * @return true si el fotograma quedó guardado.
+ */
+bool storeFrame(const EncodedFrame& frame, Storage& storage, const CipherSettings& cipherSettings,
+                PipelineStats& stats, BandwidthLimiter* limiter, RetryQueue* retries,
+                WriterHeartbeat* heartbeat) {
+    const auto& buffer = frame.buffer;
+    if (limiter) {
+        if (heartbeat) heartbeat->enter(WriterHeartbeat::Stage::Throttle, frame.meta.sequence);
+        const auto waited = limiter->acquire(buffer->size());
+        if (waited > Clock::duration::zero()) {
+            stats.throttledWrites++;
+            stats.throttleWaitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count();
+        }
+    }
+    if (heartbeat) heartbeat->enter(WriterHeartbeat::Stage::Write, frame.meta.sequence);
+    setStorageError(0);
+    const int64_t writeStart = steadyNowNs();
+    const bool written = storage.writeFrame(frame.name, buffer, frame.meta);
+    stats.writeLatency.record(steadyNowNs() - writeStart);
+    if (written) {
+        countSavedFrame(stats, buffer->size(), frame.writer);
+        if (frame.encrypted && cipherSettings.index) {
+            cipherSettings.index->record(frame.name, frame.nonce, buffer->size());
+        }
+        return true;
+    }
+
+    const int error = lastStorageError();
+    // Con el fotograma en la cola de reintentos, el nonce lo registra ella si llega a guardarse
+    if (!retries || !retries->submit(frame.name, buffer, frame.meta, error, frame.encrypted ? &frame.nonce : nullptr)) {
+        stats.writeFailures++;
+        std::cerr << "Error al escribir imagen: " << storage.describe() << "/" << frame.name
+                  << (error != 0 ? std::string(" (") + std::strerror(error) + ")" : std::string())
+                  << (retries ? " [cola de reintentos llena]" : "") << std::endl;
+    }
+    return false;
+}
+
+/**
+ * @brief Función para el hilo que codifica y guarda imágenes desde una cola segura.
  * 
- * Este hilo extrae imágenes de una cola segura (`queue`), las guarda en disco en el directorio
- * `output` con un nombre basado en el número de secuencia y el ID del hilo. Usa TurboJPEG
- * para la compresión con calidad fija. Actualiza estadísticas atómicas del total de bytes escritos.
+ * Este hilo extrae imágenes de una cola segura (`queue`), las codifica con el formato
+ * configurado y las guarda en `storage` con un nombre basado en el número de secuencia
+ * y el ID del hilo. Actualiza estadísticas atómicas del total de bytes escritos.
  * 
  * @param queue Cola segura de imágenes a escribir.
- * @param outputDir Directorio donde se guardarán las imágenes JPEG.
- * @param statsBytesWritten Contador atómico para el total de bytes escritos.
+ * @param storage Destino donde se guardarán las imágenes codificadas.
+ * @param encoderSettings Formato del codificador (cada hilo crea el suyo).
+ * @param quality Calidad vigente; se aplica al codificador cuando cambia.
+ * @param cipherSettings Cifrado en reposo; si está activo, cada hilo crea su contexto.
+ * @param stats Contadores compartidos del pipeline (imágenes y bytes guardados).
+ * @param limiter Limitador compartido de bytes/s e IOPS; nullptr si no hay límite.
  * @param threadId Identificador del hilo para diferenciar archivos y logs.
+ * @param retire Al activarse, el hilo termina tras el fotograma en curso.
+ * @param heartbeat Latido con la etapa, el fotograma y el archivo en curso (opcional).
+ * @param retries Cola de reintentos: un fallo se entrega allí y el hilo sigue con la cola.
  */
 void imageWriterThread(
     ThreadSafeQueue& queue, 
-    const std::string& outputDir,
-    std::atomic<size_t>& statsBytesWritten,
-    std::atomic<size_t>& imagesSaved,
-    int threadId) {
+    Storage& storage,
+    const EncoderSettings& encoderSettings,
+    const std::atomic<int>& quality,
+    const CipherSettings& cipherSettings,
+    PipelineStats& stats,
+    BandwidthLimiter* limiter,
+    int threadId,
+    const std::atomic<bool>& retire,
+    WriterHeartbeat* heartbeat,
+    RetryQueue* retries) {
     
     size_t imagesWritten = 0;
-    ImageData data(cv::Mat(), 0);
+    ImageData data(Frame(), 0);
+    
+    // Cada hilo tiene su propio codificador para reutilizar manejadores y buffers
+    FrameProcessor processor(encoderSettings, quality, cipherSettings, stats, threadId);
+    if (!processor.isValid()) return;
+    EncodedFrame frame;
     
     std::cout << "Iniciando hilo escritor #" << threadId << std::endl;
     
-    while (queue.pop(data)) {
-        // Crear nombre de archivo
-        std::ostringstream filename;
-        filename << outputDir << "/img_" << std::setw(8) << std::setfill('0') 
-                << data.sequenceNumber << "_t" << threadId << ".bmp";
-
-        // Escribir imagen BMP
-        bool success = cv::imwrite(filename.str(), data.image);
-        
-        if (success) {
-            // Actualizar estadísticas
+    while (queue.pop(data, retire)) {
+        if (processor.encode(data, frame, heartbeat) &&
+            storeFrame(frame, storage, cipherSettings, stats, limiter, retries, heartbeat)) {
             imagesWritten++;
-            imagesSaved++;
-
-            
-            // Calcular tamaño del archivo y actualizar estadísticas
-            std::filesystem::path filePath(filename.str());
-            size_t fileSize = std::filesystem::file_size(filePath);
-            statsBytesWritten += fileSize;
             
             // Mostrar progreso periódicamente
             if (imagesWritten % 100 == 0) {
                 std::cout << "Hilo #" << threadId << " ha escrito " << imagesWritten << " imágenes" << std::endl;
             }
-        } else {
-            std::cerr << "Error al escribir imagen: " << filename.str() << std::endl;
         }
+        if (heartbeat) heartbeat->idle();
+        queue.taskDone();
     }
     
-    std::cout << "Hilo escritor #" << threadId << " finalizado. Total: " << imagesWritten << " imágenes" << std::endl;
+    std::cout << "Hilo escritor #" << threadId << (retire ? " retirado" : " finalizado")
+              << ". Total: " << imagesWritten << " imágenes" << std::endl;
 }
@@ -0,0 +1,66 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Histograma de latencias con cubetas log-lineales.
+ */
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+
+namespace {
+/// Cubetas lineales (una por microsegundo) y subcubetas por potencia de dos.
+constexpr uint64_t kLinear = 8;
+constexpr int kSubBits = 3;
+
+/**
+ * @brief Límite superior, en microsegundos, de una cubeta.
+ */
+uint64_t bucketUpperUs(size_t index) {
+    if (index < kLinear) return index + 1;
+    const size_t group = (index - kLinear) >> kSubBits;
+    const uint64_t sub = (index - kLinear) & (kLinear - 1);
+    const int exponent = static_cast<int>(group) + kSubBits;
+    return (1ull << exponent) + ((sub + 1) << (exponent - kSubBits));
+}
+} // namespace
+
+/**
+ * @brief Cubeta de una latencia: lineal hasta 8 µs, después exponente y tres bits de mantisa.
+ */
+size_t LatencyHistogram::bucketFor(int64_t ns) {
+    const uint64_t us = ns > 0 ? static_cast<uint64_t>(ns) / 1000 : 0;
+    if (us < kLinear) return static_cast<size_t>(us);
+    const int exponent = 63 - __builtin_clzll(us);
+    const uint64_t sub = (us >> (exponent - kSubBits)) & (kLinear - 1);
+    const size_t index = kLinear + (static_cast<size_t>(exponent - kSubBits) << kSubBits) + sub;
+    return std::min(index, kBuckets - 1);
+}
+
+LatencyHistogram::Counts LatencyHistogram::counts() const {
+    Counts snapshot{};
+    for (size_t i = 0; i < kBuckets; i++) {
+        snapshot[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+double LatencyHistogram::percentileUs(const Counts& counts, double fraction) {
+    uint64_t total = 0;
+    for (uint64_t count : counts) total += count;
+    if (total == 0) return 0.0;
+    // Rango de la muestra (redondeado hacia arriba) que marca el percentil
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * total + 0.999999));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; i++) {
+        seen += counts[i];
+        if (seen >= rank) return static_cast<double>(bucketUpperUs(i));
+    }
+    return static_cast<double>(bucketUpperUs(kBuckets - 1));
+}
+
+LatencyHistogram::Counts LatencyHistogram::difference(const Counts& now, const Counts& before) {
+    Counts delta{};
+    for (size_t i = 0; i < kBuckets; i++) {
+        delta[i] = now[i] - before[i];
+    }
+    return delta;
+}
@@ -0,0 +1,338 @@
+/**
+ * @file LibjpegEncoder.cpp
+ * @brief Codificador JPEG con la API de libjpeg y tablas Huffman optimizadas o en caché.
+ */
+
+#include "LibjpegEncoder.h"
+#include <turbojpeg.h>
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+#ifdef FASTCAP_HAVE_LIBJPEG
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+/**
+ * @brief Construye la tabla con el procedimiento del Anexo K.2 (Figuras K.1 a K.4).
+ */
+HuffmanTable optimalHuffmanTable(const std::array<long, 256>& frequencies) {
+    // Huffman sin límite puede dar códigos muy largos; se cuentan hasta 64 bits y se ajustan a 16
+    constexpr int kMaxUnlimited = 64;
+    std::array<long, 257> freq{};
+    std::copy(frequencies.begin(), frequencies.end(), freq.begin());
+    freq[256] = 1;  // símbolo reservado: ningún código real será todo unos
+    std::array<int, 257> codeSize{};
+    std::array<int, 257> others;
+    others.fill(-1);
+
+    // K.1: une repetidamente los dos nodos de menor frecuencia (en empate, el de índice mayor)
+    for (;;) {
+        int c1 = -1, c2 = -1;
+        long v = LONG_MAX;
+        for (int i = 0; i <= 256; i++) {
+            if (freq[i] && freq[i] <= v) { v = freq[i]; c1 = i; }
+        }
+        v = LONG_MAX;
+        for (int i = 0; i <= 256; i++) {
+            if (freq[i] && freq[i] <= v && i != c1) { v = freq[i]; c2 = i; }
+        }
+        if (c2 < 0) break;
+
+        freq[c1] += freq[c2];
+        freq[c2] = 0;
+        codeSize[c1]++;
+        while (others[c1] >= 0) {
+            c1 = others[c1];
+            codeSize[c1]++;
+        }
+        others[c1] = c2;
+        codeSize[c2]++;
+        while (others[c2] >= 0) {
+            c2 = others[c2];
+            codeSize[c2]++;
+        }
+    }
+
+    // K.2: códigos por longitud
+    std::array<int, kMaxUnlimited + 1> bits{};
+    for (int i = 0; i <= 256; i++) {
+        if (codeSize[i]) bits[std::min(codeSize[i], kMaxUnlimited)]++;
+    }
+
+    // K.3: limita las longitudes a 16 bits conservando un código de prefijos
+    for (int i = kMaxUnlimited; i > 16; i--) {
+        while (bits[i] > 0) {
+            int j = i - 2;
+            while (bits[j] == 0) j--;
+            bits[i] -= 2;
+            bits[i - 1]++;
+            bits[j + 1] += 2;
+            bits[j]--;
+        }
+    }
+    // Quita el código del símbolo reservado (uno de los más largos)
+    int longest = 16;
+    while (longest > 0 && bits[longest] == 0) longest--;
+    if (longest > 0) bits[longest]--;
+
+    HuffmanTable table;
+    for (int i = 1; i <= 16; i++) table.bits[i] = static_cast<uint8_t>(bits[i]);
+    // K.4: símbolos ordenados por longitud de código
+    size_t position = 0;
+    for (int length = 1; length <= kMaxUnlimited; length++) {
+        for (int symbol = 0; symbol < 256; symbol++) {
+            if (codeSize[symbol] == length) table.values[position++] = static_cast<uint8_t>(symbol);
+        }
+    }
+    return table;
+}
+
+#ifdef FASTCAP_HAVE_LIBJPEG
+namespace {
+
+/// Gestor de errores que vuelve a encode() con longjmp en lugar de terminar el proceso.
+struct ErrorManager {
+    jpeg_error_mgr base;
+    std::jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void onError(j_common_ptr info) {
+    auto* errors = reinterpret_cast<ErrorManager*>(info->err);
+    (*info->err->format_message)(info, errors->message);
+    std::longjmp(errors->jump, 1);
+}
+
+/// Destino que escribe directamente en el buffer de salida del escritor.
+struct VectorDestination {
+    jpeg_destination_mgr base;
+    std::vector<unsigned char>* out;
+    size_t initialSize;
+};
+
+void initDestination(j_compress_ptr info) {
+    auto* destination = reinterpret_cast<VectorDestination*>(info->dest);
+    std::vector<unsigned char>& out = *destination->out;
+    out.resize(std::max({out.capacity(), destination->initialSize, size_t(4096)}));
+    destination->base.next_output_byte = out.data();
+    destination->base.free_in_buffer = out.size();
+}
+
+boolean growDestination(j_compress_ptr info) {
+    auto* destination = reinterpret_cast<VectorDestination*>(info->dest);
+    std::vector<unsigned char>& out = *destination->out;
+    const size_t used = out.size();
+    out.resize(used * 2);
+    destination->base.next_output_byte = out.data() + used;
+    destination->base.free_in_buffer = out.size() - used;
+    return TRUE;
+}
+
+void termDestination(j_compress_ptr info) {
+    auto* destination = reinterpret_cast<VectorDestination*>(info->dest);
+    destination->out->resize(destination->out->size() - destination->base.free_in_buffer);
+}
+
+/// Objeto de compresión y lo que se reutiliza con él entre fotogramas.
+struct LibjpegState {
+    jpeg_compress_struct info;
+    ErrorManager errors;
+    VectorDestination destination;
+    std::vector<JSAMPROW> rows;
+};
+
+JHUFF_TBL** tableSlot(jpeg_compress_struct& info, size_t index) {
+    return index < 2 ? &info.dc_huff_tbl_ptrs[index] : &info.ac_huff_tbl_ptrs[index - 2];
+}
+
+/**
+ * @brief Completa una tabla optimizada para que todo símbolo válido tenga código.
+ *
+ * La tabla de un fotograma de muestra solo codifica los símbolos que aparecieron en él;
+ * un fotograma posterior con otro símbolo no se podría codificar. Las longitudes de la
+ * tabla se convierten en frecuencias (2^-L) y los símbolos válidos ausentes reciben la
+ * mínima, de modo que obtienen códigos largos y los presentes conservan su longitud
+ * (o pierden un bit como mucho).
+ *
+ * @param ac Tabla AC (run/size) o DC (categorías 0-11).
+ */
+HuffmanTable completeTable(const JHUFF_TBL& table, bool ac) {
+    std::array<long, 256> freq{};
+    int position = 0;
+    for (int length = 1; length <= 16; length++) {
+        for (int i = 0; i < table.bits[length]; i++) {
+            freq[table.huffval[position++]] = 1L << (18 - length);
+        }
+    }
+    auto ensure = [&](int symbol) { freq[symbol] = std::max(freq[symbol], 1L); };
+    if (ac) {
+        ensure(0x00);  // EOB
+        ensure(0xF0);  // ZRL
+        for (int run = 0; run < 16; run++) {
+            for (int size = 1; size <= 10; size++) ensure((run << 4) | size);
+        }
+    } else {
+        for (int category = 0; category <= 11; category++) ensure(category);
+    }
+    return optimalHuffmanTable(freq);
+}
+
+} // namespace
+#endif
+
+/**
+ * @brief Crea el objeto de compresión y fija lo que no cambia entre fotogramas.
+ * @param quality Calidad JPEG entre 0 y 100.
+ * @param kernels Núcleos del formato de los fotogramas.
+ * @param options Submuestreo, DCT y modo Huffman.
+ */
+LibjpegEncoder::LibjpegEncoder(int quality, const PixelKernels& kernels, const JpegOptions& options)
+    : kernels(kernels), huffman(options.huffman), refreshInterval(std::max<size_t>(options.huffmanRefresh, 1)),
+      quality(quality), pendingQuality(quality) {
+#ifdef FASTCAP_HAVE_LIBJPEG
+    auto* state = new LibjpegState();
+    jpeg_compress_struct& info = state->info;
+    info.err = jpeg_std_error(&state->errors.base);
+    state->errors.base.error_exit = onError;
+    if (setjmp(state->errors.jump)) {
+        std::cerr << "Error inicializando libjpeg: " << state->errors.message << std::endl;
+        jpeg_destroy_compress(&info);
+        delete state;
+        return;
+    }
+    jpeg_create_compress(&info);
+    state->destination.base.init_destination = initDestination;
+    state->destination.base.empty_output_buffer = growDestination;
+    state->destination.base.term_destination = termDestination;
+    state->destination.initialSize = 0;
+    info.dest = &state->destination.base;
+
+    // Mismo submuestreo que TurboJPEGEncoder: un canal siempre en gris
+    const int subsampling = (options.subsampling < 0 || kernels.tjSubsampling == TJSAMP_GRAY)
+        ? kernels.tjSubsampling : options.subsampling;
+    switch (kernels.tjPixelFormat) {
+        case TJPF_GRAY: info.in_color_space = JCS_GRAYSCALE; info.input_components = 1; break;
+        case TJPF_BGRX: info.in_color_space = JCS_EXT_BGRX; info.input_components = 4; break;
+        case TJPF_BGR:
+        default: info.in_color_space = JCS_EXT_BGR; info.input_components = 3; break;
+    }
+    jpeg_set_defaults(&info);
+    if (subsampling == TJSAMP_GRAY) {
+        jpeg_set_colorspace(&info, JCS_GRAYSCALE);
+    } else {
+        info.comp_info[0].h_samp_factor = subsampling == TJSAMP_444 ? 1 : 2;
+        info.comp_info[0].v_samp_factor = subsampling == TJSAMP_420 ? 2 : 1;
+    }
+    info.dct_method = options.accurateDct ? JDCT_ISLOW : JDCT_IFAST;
+    jpeg_set_quality(&info, quality, TRUE);
+    compressor = state;
+#else
+    (void)quality;
+    std::cerr << "Error: Compilado sin libjpeg; las tablas Huffman optimizadas no están disponibles" << std::endl;
+#endif
+}
+
+LibjpegEncoder::~LibjpegEncoder() {
+#ifdef FASTCAP_HAVE_LIBJPEG
+    auto* state = static_cast<LibjpegState*>(compressor);
+    if (state) {
+        jpeg_destroy_compress(&state->info);
+        delete state;
+    }
+#endif
+}
+
+/**
+ * @brief Aplica la nueva calidad en el siguiente fotograma, que recalcula las tablas en caché.
+ */
+void LibjpegEncoder::setQuality(int newQuality) {
+    pendingQuality = newQuality;
+}
+
+bool LibjpegEncoder::available() {
+#ifdef FASTCAP_HAVE_LIBJPEG
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Comprime un fotograma.
+ *
+ * En modo en caché, el primer fotograma y uno de cada `refreshInterval` se comprimen
+ * con optimize_coding (dos pasadas) y sus tablas, completadas, se guardan; el resto se
+ * comprime en una pasada con las tablas guardadas, que van en su segmento DHT.
+ *
+ * @param image Fotograma a comprimir.
+ * @param out Buffer de salida con el JPEG comprimido.
+ * @return true si la compresión fue exitosa.
+ */
+bool LibjpegEncoder::encode(const Frame& image, std::vector<unsigned char>& out) {
+#ifdef FASTCAP_HAVE_LIBJPEG
+    auto* state = static_cast<LibjpegState*>(compressor);
+    if (!state || image.empty()) return false;
+    jpeg_compress_struct& info = state->info;
+    const Frame& input = kernels.encoderInput(image, scratch);
+
+    state->rows.resize(input.height());
+    for (int y = 0; y < input.height(); y++) {
+        state->rows[y] = const_cast<JSAMPROW>(input.row(y));
+    }
+    state->destination.out = &out;
+    state->destination.initialSize = input.rowSize() * input.height() / 4;
+
+    if (pendingQuality != quality) {
+        quality = pendingQuality;
+        jpeg_set_quality(&info, quality, TRUE);
+        tablesReady = false;
+    }
+    const bool refresh = huffman == JpegHuffman::Cached && (!tablesReady || sinceRefresh >= refreshInterval);
+    const int tableCount = info.num_components == 1 ? 1 : 2;
+
+    if (setjmp(state->errors.jump)) {
+        jpeg_abort_compress(&info);
+        std::cerr << "Error al comprimir: " << state->errors.message << std::endl;
+        return false;
+    }
+    info.image_width = static_cast<JDIMENSION>(input.width());
+    info.image_height = static_cast<JDIMENSION>(input.height());
+    info.optimize_coding = (huffman == JpegHuffman::PerFrame || refresh) ? TRUE : FALSE;
+    if (huffman == JpegHuffman::Cached && !refresh) {
+        for (int t = 0; t < tableCount; t++) {
+            for (size_t kind : {size_t(0), size_t(2)}) {
+                JHUFF_TBL* table = *tableSlot(info, kind + t);
+                const HuffmanTable& source = cached[kind + t];
+                std::copy(source.bits.begin(), source.bits.end(), table->bits);
+                std::copy(source.values.begin(), source.values.end(), table->huffval);
+            }
+        }
+    }
+
+    jpeg_start_compress(&info, TRUE);
+    while (info.next_scanline < info.image_height) {
+        jpeg_write_scanlines(&info, state->rows.data() + info.next_scanline, info.image_height - info.next_scanline);
+    }
+    jpeg_finish_compress(&info);
+
+    if (refresh) {
+        // libjpeg deja en las tablas del objeto las óptimas de este fotograma
+        for (int t = 0; t < tableCount; t++) {
+            cached[t] = completeTable(**tableSlot(info, t), false);
+            cached[2 + t] = completeTable(**tableSlot(info, 2 + t), true);
+        }
+        tablesReady = true;
+        sinceRefresh = 0;
+        refreshes++;
+    }
+    sinceRefresh++;
+    return true;
+#else
+    (void)image;
+    (void)out;
+    return false;
+#endif
+}
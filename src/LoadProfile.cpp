@@ -0,0 +1,335 @@
+/**
+ * @file LoadProfile.cpp
+ * @brief Implementación de los perfiles de carga con tasa de generación variable en el tiempo.
+ */
+
+#include "LoadProfile.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+/**
+ * @brief Crea un perfil de un único tramo constante.
+ * @param fps Tasa objetivo en fotogramas por segundo.
+ */
+LoadProfile::LoadProfile(double fps) : rng(42) {
+    Segment segment;
+    segment.type = SegmentType::Step;
+    segment.duration = std::numeric_limits<double>::infinity();
+    segment.fps = fps;
+    segments.push_back(segment);
+}
+
+/**
+ * @brief Interpreta un guion de carga con un tramo por línea (o separado por `;`).
+ * @param script Texto del guion.
+ * @param profile Perfil donde se almacenará el resultado.
+ * @return true si el guion es válido, false en caso contrario.
+ */
+bool LoadProfile::parse(const std::string& script, LoadProfile& profile) {
+    std::vector<Segment> parsed;
+    bool repeat = false;
+
+    std::string normalized = script;
+    std::replace(normalized.begin(), normalized.end(), ';', '\n');
+    std::istringstream lines(normalized);
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        // Descarta comentarios
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        std::string type;
+        if (!(fields >> type)) continue; // Línea vacía
+
+        if (type == "repeat") {
+            repeat = true;
+            continue;
+        }
+
+        Segment segment;
+        bool ok = static_cast<bool>(fields >> segment.duration);
+        if (type == "step") {
+            segment.type = SegmentType::Step;
+            ok = ok && (fields >> segment.fps);
+        } else if (type == "ramp") {
+            segment.type = SegmentType::Ramp;
+            ok = ok && (fields >> segment.fps >> segment.fpsEnd);
+        } else if (type == "burst") {
+            segment.type = SegmentType::Burst;
+            ok = ok && (fields >> segment.fps >> segment.peakFPS >> segment.peakDuration >> segment.period);
+            ok = ok && segment.period > 0 && segment.peakDuration >= 0 && segment.peakDuration <= segment.period;
+        } else if (type == "poisson") {
+            segment.type = SegmentType::Poisson;
+            ok = ok && (fields >> segment.fps);
+        } else {
+            std::cerr << "Perfil de carga, línea " << lineNumber << ": tipo desconocido '" << type << "'" << std::endl;
+            return false;
+        }
+
+        ok = ok && segment.duration > 0 && segment.fps >= 0 && segment.fpsEnd >= 0 && segment.peakFPS >= 0;
+        if (!ok) {
+            std::cerr << "Perfil de carga, línea " << lineNumber << ": parámetros inválidos para '" << type << "'" << std::endl;
+            return false;
+        }
+        parsed.push_back(segment);
+    }
+
+    if (parsed.empty()) {
+        std::cerr << "Perfil de carga vacío" << std::endl;
+        return false;
+    }
+
+    profile.segments = parsed;
+    profile.repeat = repeat;
+    return true;
+}
+
+/**
+ * @brief Carga un perfil desde un archivo o, si no existe, desde el texto recibido.
+ * @param spec Ruta de un archivo de guion o guion en línea.
+ * @param profile Perfil donde se almacenará el resultado.
+ * @return true si el perfil es válido, false en caso contrario.
+ */
+bool LoadProfile::load(const std::string& spec, LoadProfile& profile) {
+    if (!std::filesystem::is_regular_file(spec)) {
+        return parse(spec, profile);
+    }
+
+    std::ifstream in(spec);
+    if (!in) {
+        std::cerr << "Error: No se pudo abrir el perfil de carga " << spec << std::endl;
+        return false;
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    return parse(content.str(), profile);
+}
+
+/**
+ * @brief Fija la semilla usada para las llegadas de Poisson.
+ * @param seed Semilla del generador pseudoaleatorio.
+ */
+void LoadProfile::setSeed(uint64_t seed) {
+    rng.seed(seed);
+}
+
+/**
+ * @brief Fija una tasa constante que sustituye al guion, o vuelve a él.
+ * @param fps Tasa constante en FPS; 0 o negativo vuelve a seguir el guion.
+ */
+void LoadProfile::overrideRate(double fps) {
+    overrideFPS.store(fps > 0.0 ? fps : 0.0);
+}
+
+/**
+ * @brief Duración total del guion en segundos.
+ * @return Suma de las duraciones de los tramos (infinito para perfiles constantes).
+ */
+double LoadProfile::duration() const {
+    double total = 0.0;
+    for (const auto& segment : segments) {
+        total += segment.duration;
+    }
+    return total;
+}
+
+/**
+ * @brief Indica si el perfil es una tasa constante sin variación.
+ */
+bool LoadProfile::isConstant() const {
+    if (overrideFPS.load() > 0.0) return true;
+    return segments.size() == 1 && segments[0].type == SegmentType::Step;
+}
+
+/**
+ * @brief Localiza el tramo activo en el instante `t`.
+ *
+ * Con `repeat` el tiempo se reduce módulo la duración del guion; sin él, el último
+ * tramo se extiende indefinidamente.
+ *
+ * @param t Segundos transcurridos desde el inicio.
+ * @param local Tiempo relativo al inicio del tramo.
+ * @param remaining Tiempo restante hasta el fin del tramo (infinito si es el último sin repetición).
+ * @return Índice del tramo activo.
+ */
+size_t LoadProfile::locate(double t, double& local, double& remaining) const {
+    const double total = duration();
+    if (repeat && std::isfinite(total)) {
+        t = std::fmod(t, total);
+    }
+
+    double start = 0.0;
+    for (size_t i = 0; i < segments.size(); i++) {
+        const double end = start + segments[i].duration;
+        if (t < end || i + 1 == segments.size()) {
+            local = t - start;
+            remaining = (i + 1 == segments.size() && !repeat)
+                ? std::numeric_limits<double>::infinity()
+                : end - t;
+            return i;
+        }
+        start = end;
+    }
+    local = 0.0;
+    remaining = std::numeric_limits<double>::infinity();
+    return 0;
+}
+
+/**
+ * @brief Calcula la tasa objetivo en el instante `t`.
+ * @param t Segundos transcurridos desde el inicio.
+ * @return FPS objetivo (media en tramos de Poisson).
+ */
+double LoadProfile::rateAt(double t) const {
+    const double fixed = overrideFPS.load();
+    if (fixed > 0.0) return fixed;
+
+    double local = 0.0, remaining = 0.0;
+    const Segment& segment = segments[locate(t, local, remaining)];
+
+    switch (segment.type) {
+        case SegmentType::Ramp: {
+            const double progress = std::min(1.0, local / segment.duration);
+            return segment.fps + (segment.fpsEnd - segment.fps) * progress;
+        }
+        case SegmentType::Burst:
+            return std::fmod(local, segment.period) < segment.peakDuration ? segment.peakFPS : segment.fps;
+        case SegmentType::Step:
+        case SegmentType::Poisson:
+        default:
+            return segment.fps;
+    }
+}
+
+/**
+ * @brief Mayor tasa que alcanza algún tramo del guion, o la fijada en tiempo de ejecución.
+ */
+double LoadProfile::peakRate() const {
+    const double fixed = overrideFPS.load();
+    if (fixed > 0.0) return fixed;
+
+    double peak = 0.0;
+    for (const auto& segment : segments) {
+        peak = std::max(peak, segment.fps);
+        if (segment.type == SegmentType::Ramp) peak = std::max(peak, segment.fpsEnd);
+        if (segment.type == SegmentType::Burst) peak = std::max(peak, segment.peakFPS);
+    }
+    return peak;
+}
+
+/**
+ * @brief Calcula el intervalo hasta el siguiente fotograma a partir del instante `t`.
+ *
+ * En escalones y ráfagas el intervalo es el inverso de la tasa y en rampas el tiempo
+ * en que la tasa integrada llega a una llegada; en tramos de Poisson se muestrea una
+ * distribución exponencial. Los periodos con tasa nula se saltan hasta que la tasa
+ * vuelve a ser positiva.
+ *
+ * @param t Segundos transcurridos desde el inicio.
+ * @return Espera hasta la siguiente llegada, o `microseconds::max()` si no habrá más llegadas.
+ */
+std::chrono::microseconds LoadProfile::nextInterval(double t) {
+    const double fixed = overrideFPS.load();
+    if (fixed > 0.0) {
+        return std::chrono::microseconds(static_cast<int64_t>(1e6 / fixed));
+    }
+
+    double wait = 0.0;
+
+    // Cota de seguridad para guiones con largos periodos sin llegadas
+    for (int attempt = 0; attempt < 100000; attempt++) {
+        double local = 0.0, remaining = 0.0;
+        const Segment& segment = segments[locate(t + wait, local, remaining)];
+        const double rate = rateAt(t + wait);
+
+        // En una rampa la llegada es el instante en que la integral de la tasa alcanza 1:
+        // rate·dt + slope·dt²/2 = 1. Con 1/rate, una rampa desde 0 esperaría 1/rate con
+        // la tasa casi nula del primer paso (p. ej. 100 s) en lugar de sqrt(2/slope)
+        if (segment.type == SegmentType::Ramp && local < segment.duration) {
+            const double slope = (segment.fpsEnd - segment.fps) / segment.duration;
+            const double discriminant = rate * rate + 2.0 * slope;
+            if (discriminant >= 0.0 && std::sqrt(discriminant) + rate > 0.0) {
+                // Forma estable de (sqrt(discriminant) - rate) / slope, válida también con slope = 0
+                const double dt = 2.0 / (std::sqrt(discriminant) + rate);
+                if (dt <= segment.duration - local) {
+                    wait += dt;
+                    return std::chrono::microseconds(static_cast<int64_t>(wait * 1e6));
+                }
+            }
+        }
+
+        if (rate > 0.0) {
+            if (segment.type == SegmentType::Poisson) {
+                std::exponential_distribution<double> arrivals(rate);
+                wait += arrivals(rng);
+            } else {
+                wait += 1.0 / rate;
+            }
+            return std::chrono::microseconds(static_cast<int64_t>(wait * 1e6));
+        }
+
+        // Tasa nula: avanzar hasta el siguiente cambio de tasa
+        double hold = remaining;
+        if (segment.type == SegmentType::Burst) {
+            const double phase = std::fmod(local, segment.period);
+            hold = std::min(remaining, phase < segment.peakDuration
+                ? segment.peakDuration - phase
+                : segment.period - phase);
+        } else if (segment.type == SegmentType::Ramp) {
+            hold = std::min(remaining, 0.001);
+        }
+
+        if (!std::isfinite(hold)) break;
+        wait += std::max(hold, 1e-6);
+    }
+    return std::chrono::microseconds::max();
+}
+
+/**
+ * @brief Descripción legible del perfil para mostrar en la configuración.
+ * @return Texto con los tramos del perfil.
+ */
+std::string LoadProfile::describe() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    const double fixed = overrideFPS.load();
+    if (fixed > 0.0) {
+        oss << fixed << " FPS constantes (fijados en ejecución)";
+        return oss.str();
+    }
+    if (isConstant()) {
+        oss << segments[0].fps << " FPS constantes";
+        return oss.str();
+    }
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        const Segment& s = segments[i];
+        if (i > 0) oss << "; ";
+        switch (s.type) {
+            case SegmentType::Step:
+                oss << "step " << s.duration << "s " << s.fps;
+                break;
+            case SegmentType::Ramp:
+                oss << "ramp " << s.duration << "s " << s.fps << "->" << s.fpsEnd;
+                break;
+            case SegmentType::Burst:
+                oss << "burst " << s.duration << "s " << s.fps << "/" << s.peakFPS
+                    << " (" << s.peakDuration << "s cada " << s.period << "s)";
+                break;
+            case SegmentType::Poisson:
+                oss << "poisson " << s.duration << "s media " << s.fps;
+                break;
+        }
+    }
+    if (repeat) oss << "; repeat";
+    return oss.str();
+}
@@ -0,0 +1,232 @@
+/**
+ * @file MirrorStorage.cpp
+ * @brief Escritura espejo en dos destinos con un único buffer codificado.
+ */
+
+#include "MirrorStorage.h"
+#include "Utils.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief Registra el resultado de un destino.
+ * @param success true si el destino guardó el fotograma.
+ */
+void MirrorStorage::Ticket::complete(bool success) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished++;
+        if (success) succeeded++;
+    }
+    done.notify_all();
+}
+
+/**
+ * @brief Crea el espejo e inicia un hilo por destino.
+ * @param primary Primer destino.
+ * @param secondary Segundo destino.
+ * @param maxBacklog Fotogramas pendientes máximos por destino (al menos 1).
+ */
+MirrorStorage::MirrorStorage(std::unique_ptr<Storage> primary, std::unique_ptr<Storage> secondary,
+                             size_t maxBacklog)
+    : maxBacklog(std::max<size_t>(maxBacklog, 1)) {
+    destinations[0].storage = std::move(primary);
+    destinations[1].storage = std::move(secondary);
+    for (auto& destination : destinations) {
+        destination.thread = std::thread(&MirrorStorage::serve, this, std::ref(destination));
+    }
+}
+
+/**
+ * @brief Termina lo pendiente y detiene los hilos.
+ */
+MirrorStorage::~MirrorStorage() {
+    drain();
+}
+
+/**
+ * @brief Encola el trabajo si el destino no supera el retraso permitido.
+ * @param destination Destino.
+ * @param job Trabajo a encolar.
+ * @return false si la cola está llena o el destino se está deteniendo.
+ */
+bool MirrorStorage::submit(Destination& destination, const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(destination.mutex);
+        if (destination.stopping || destination.jobs.size() >= maxBacklog) {
+            return false;
+        }
+        destination.jobs.push_back(job);
+    }
+    destination.workAvailable.notify_one();
+    return true;
+}
+
+/**
+ * @brief Atiende la cola de un destino hasta que se pida parar y quede vacía.
+ * @param destination Destino a atender.
+ */
+void MirrorStorage::serve(Destination& destination) {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(destination.mutex);
+            destination.workAvailable.wait(lock, [&] { return destination.stopping || !destination.jobs.empty(); });
+            if (destination.jobs.empty()) return;
+            job = std::move(destination.jobs.front());
+            destination.jobs.pop_front();
+        }
+
+        const bool success = destination.storage->writeFrame(job.name, job.data, job.meta);
+        if (success) {
+            const int64_t lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - job.submitted).count();
+            destination.files++;
+            destination.bytes += job.data->size();
+            destination.totalLagNs += lag;
+            int64_t peak = destination.maxLagNs.load();
+            while (lag > peak && !destination.maxLagNs.compare_exchange_weak(peak, lag)) {
+            }
+        } else {
+            destination.failures++;
+        }
+        // Soltar el buffer antes de avisar, para que el escritor pueda reutilizarlo
+        job.data.reset();
+        job.ticket->complete(success);
+    }
+}
+
+/**
+ * @brief Envía el fotograma a ambos destinos y espera al primero que lo guarde.
+ *
+ * Si ninguno lo guarda, espera a ambos para informar el fallo.
+ *
+ * @param name Nombre del archivo.
+ * @param data Buffer compartido; se libera cuando ambos destinos terminan.
+ * @param meta Metadatos del fotograma, que reciben ambos destinos.
+ * @return true si al menos un destino lo guardó.
+ */
+bool MirrorStorage::writeFrame(const std::string& name, const SharedBuffer& data, const FrameMeta& meta) {
+    Job job;
+    job.name = name;
+    job.data = data;
+    job.meta = meta;
+    job.ticket = std::make_shared<Ticket>();
+    job.submitted = std::chrono::steady_clock::now();
+
+    int submitted = 0;
+    for (auto& destination : destinations) {
+        if (submit(destination, job)) {
+            submitted++;
+        } else {
+            destination.skipped++;
+        }
+    }
+    if (submitted == 0) return false;
+
+    Ticket& ticket = *job.ticket;
+    std::unique_lock<std::mutex> lock(ticket.mutex);
+    ticket.done.wait(lock, [&] { return ticket.succeeded > 0 || ticket.finished == submitted; });
+    return ticket.succeeded > 0;
+}
+
+/**
+ * @brief Reparte el buffer compartido sin metadatos.
+ */
+bool MirrorStorage::writeShared(const std::string& name, const SharedBuffer& data) {
+    return writeFrame(name, data, FrameMeta());
+}
+
+/**
+ * @brief Copia el buffer una sola vez y lo reparte entre ambos destinos.
+ */
+bool MirrorStorage::write(const std::string& name, const std::vector<unsigned char>& data) {
+    return writeShared(name, std::make_shared<const std::vector<unsigned char>>(data));
+}
+
+/**
+ * @brief Cierra el segmento activo en ambos destinos.
+ * @return true si algún destino usa segmentos.
+ */
+bool MirrorStorage::rollover() {
+    const bool first = destinations[0].storage->rollover();
+    const bool second = destinations[1].storage->rollover();
+    return first || second;
+}
+
+/**
+ * @brief Revisa ambos destinos; la numeración sigue a la mayor secuencia de los dos.
+ */
+bool MirrorStorage::recover(uint64_t& nextSequence) {
+    const bool first = destinations[0].storage->recover(nextSequence);
+    const bool second = destinations[1].storage->recover(nextSequence);
+    return first || second;
+}
+
+/**
+ * @brief Espera a que ambos destinos terminen y detiene sus hilos.
+ */
+void MirrorStorage::drain() {
+    for (auto& destination : destinations) {
+        {
+            std::lock_guard<std::mutex> lock(destination.mutex);
+            destination.stopping = true;
+        }
+        destination.workAvailable.notify_all();
+    }
+    for (auto& destination : destinations) {
+        if (destination.thread.joinable()) {
+            destination.thread.join();
+        }
+    }
+}
+
+/**
+ * @brief Fotogramas pendientes en el destino más retrasado.
+ */
+size_t MirrorStorage::backlog() const {
+    size_t worst = 0;
+    for (auto& destination : destinations) {
+        std::lock_guard<std::mutex> lock(destination.mutex);
+        worst = std::max(worst, destination.jobs.size());
+    }
+    return worst;
+}
+
+/**
+ * @brief Descripción de ambos destinos.
+ */
+std::vector<VolumeUsage> MirrorStorage::volumeUsage() const {
+    std::vector<VolumeUsage> usage;
+    for (const auto& destination : destinations) {
+        std::vector<VolumeUsage> own = destination.storage->volumeUsage();
+        if (own.empty()) own.push_back({destination.storage->describe(), destination.bytes.load()});
+        usage.insert(usage.end(), own.begin(), own.end());
+    }
+    return usage;
+}
+
+std::string MirrorStorage::describe() const {
+    return "espejo [" + destinations[0].storage->describe() + "] + [" + destinations[1].storage->describe() + "]";
+}
+
+/**
+ * @brief Informe por destino para los resultados finales.
+ */
+std::string MirrorStorage::report() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    for (int i = 0; i < 2; i++) {
+        const Destination& destination = destinations[i];
+        const size_t files = destination.files.load();
+        if (i > 0) oss << "\n";
+        oss << "Espejo " << (i + 1) << " (" << destination.storage->describe() << "): "
+            << files << " archivos, " << formatByteSize(destination.bytes.load())
+            << ", fallos " << destination.failures.load()
+            << ", omitidos por retraso " << destination.skipped.load()
+            << ", retraso medio " << (files > 0 ? destination.totalLagNs.load() / 1e6 / files : 0.0)
+            << " ms, máximo " << destination.maxLagNs.load() / 1e6 << " ms";
+    }
+    return oss.str();
+}
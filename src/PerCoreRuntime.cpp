@@ -0,0 +1,97 @@
+/**
+ * @file PerCoreRuntime.cpp
+ * @brief Modo por núcleo: cada hilo genera, codifica y escribe sus fotogramas sin colas compartidas.
+ */
+
+#include "PerCoreRuntime.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+CoreFrameSink::CoreFrameSink(Storage& storage, const EncoderSettings& encoderSettings,
+                             const std::atomic<int>& quality, const CipherSettings& cipherSettings,
+                             PipelineStats& stats, BandwidthLimiter* limiter, RetryQueue* retries, int core)
+    : processor(encoderSettings, quality, cipherSettings, stats, core + 1), storage(storage),
+      cipherSettings(cipherSettings), stats(stats), limiter(limiter), retries(retries) {}
+
+/**
+ * @brief Codifica y escribe el fotograma en el hilo del generador.
+ * @return true si el fotograma se procesó (aunque la escritura vaya a la cola de reintentos).
+ */
+bool CoreFrameSink::push(const ImageData& data) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool encoded = processor.encode(data, frame);
+    if (encoded) {
+        storeFrame(frame, storage, cipherSettings, stats, limiter, retries);
+        processed++;
+    }
+    busy += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    return encoded;
+}
+
+/**
+ * @param cores Número de hilos; se fijan a los núcleos permitidos en orden.
+ * @param tuning Prioridades de los escritores, aplicadas en cada hilo.
+ */
+PerCoreRuntime::PerCoreRuntime(int cores, const ThreadTuning& tuning)
+    : cores(std::max(cores, 1)), tuning(tuning) {}
+
+/**
+ * @brief Crea el destino (codificador y cifrado) de cada núcleo.
+ * @return true si todos se inicializaron.
+ */
+bool PerCoreRuntime::prepare(Storage& storage, const EncoderSettings& encoderSettings,
+                             const std::atomic<int>& quality, const CipherSettings& cipherSettings,
+                             PipelineStats& stats, BandwidthLimiter* limiter, RetryQueue* retries) {
+    sinks.clear();
+    for (int core = 0; core < cores; core++) {
+        sinks.push_back(std::make_unique<CoreFrameSink>(storage, encoderSettings, quality, cipherSettings, stats,
+                                                        limiter, retries, core));
+        if (!sinks.back()->isValid()) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Lanza los hilos por núcleo y espera a que terminen.
+ *
+ * Cada hilo se fija a su núcleo antes de ejecutar `body`, así las reservas del origen
+ * de fotogramas y del codificador quedan en la memoria local del núcleo.
+ */
+void PerCoreRuntime::run(const CoreBody& body) {
+    std::vector<std::thread> threads;
+    for (int core = 0; core < cores; core++) {
+        threads.emplace_back([this, core, &body] {
+            pinCurrentThread(core);
+            applyWriterTuning(tuning);
+            body(core, *sinks[core]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Reparto de fotogramas y ocupación de cada núcleo.
+ */
+std::string PerCoreRuntime::report(double seconds) const {
+    seconds = std::max(seconds, 1e-9);
+    size_t minFrames = SIZE_MAX, maxFrames = 0;
+    int64_t busy = 0;
+    for (const auto& sink : sinks) {
+        minFrames = std::min(minFrames, sink->frames());
+        maxFrames = std::max(maxFrames, sink->frames());
+        busy += sink->busyNs();
+    }
+    if (sinks.empty()) minFrames = 0;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1)
+        << "Runtime por núcleo: " << cores << " núcleos, " << minFrames << "-" << maxFrames
+        << " fotogramas por núcleo; ocupación media "
+        << 100.0 * busy / 1e9 / seconds / std::max<size_t>(sinks.size(), 1) << "%";
+    return oss.str();
+}
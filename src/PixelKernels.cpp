@@ -0,0 +1,254 @@
+/**
+ * @file PixelKernels.cpp
+ * @brief Núcleos de generación y conversión de píxeles instanciados por formato y resolución.
+ */
+
+#include "PixelKernels.h"
+#include <turbojpeg.h>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+/**
+ * @brief Propiedades de cada formato de píxel soportado, conocidas en compilación.
+ */
+template <PixelFormat Format> struct PixelTraits;
+
+template <> struct PixelTraits<PixelFormat::Bgr8> {
+    using Channel = uint8_t;
+    static constexpr int channels = 3;
+    static constexpr int tjPixelFormat = TJPF_BGR;
+    static constexpr int tjSubsampling = TJSAMP_420;
+};
+
+template <> struct PixelTraits<PixelFormat::Bgra8> {
+    using Channel = uint8_t;
+    static constexpr int channels = 4;
+    static constexpr int tjPixelFormat = TJPF_BGRX;  // JPEG no guarda el alfa
+    static constexpr int tjSubsampling = TJSAMP_420;
+};
+
+template <> struct PixelTraits<PixelFormat::Gray8> {
+    using Channel = uint8_t;
+    static constexpr int channels = 1;
+    static constexpr int tjPixelFormat = TJPF_GRAY;
+    static constexpr int tjSubsampling = TJSAMP_GRAY;
+};
+
+template <> struct PixelTraits<PixelFormat::Gray16> {
+    using Channel = uint16_t;
+    static constexpr int channels = 1;
+    static constexpr int tjPixelFormat = TJPF_GRAY;  // tras reducir a 8 bits
+    static constexpr int tjSubsampling = TJSAMP_GRAY;
+    static constexpr PixelFormat narrowFormat = PixelFormat::Gray8;
+};
+
+inline uint64_t xorshift(uint64_t& x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+/**
+ * @brief Rellena `size` bytes de ruido con los cuatro carriles, 32 bytes por vuelta.
+ *
+ * Se inlinea en cada núcleo: con `size` constante desaparecen el cálculo de vueltas y la cola.
+ */
+inline void fillBytes(uint8_t* out, size_t size, NoiseState& state) {
+    uint64_t lanes[4];
+    std::memcpy(lanes, state.lanes, sizeof(lanes));
+    size_t i = 0;
+    for (; i + sizeof(lanes) <= size; i += sizeof(lanes)) {
+        for (auto& lane : lanes) xorshift(lane);
+        std::memcpy(out + i, lanes, sizeof(lanes));
+    }
+    if (i < size) {
+        for (auto& lane : lanes) xorshift(lane);
+        std::memcpy(out + i, lanes, size - i);
+    }
+    std::memcpy(state.lanes, lanes, sizeof(lanes));
+}
+
+/**
+ * @brief Núcleos de un formato; con Width y Height distintos de 0, de una resolución fija.
+ */
+template <PixelFormat Format, int Width = 0, int Height = 0>
+struct Kernels {
+    using Traits = PixelTraits<Format>;
+    using Channel = typename Traits::Channel;
+
+    /// Valores (canales) por fila; constante con ancho fijo.
+    static size_t rowValues(const Frame& image) {
+        if constexpr (Width > 0) {
+            return static_cast<size_t>(Width) * Traits::channels;
+        } else {
+            return static_cast<size_t>(image.width()) * Traits::channels;
+        }
+    }
+
+    static int rows(const Frame& image) {
+        if constexpr (Height > 0) {
+            return Height;
+        } else {
+            return image.height();
+        }
+    }
+
+    static void fillNoise(Frame& image, NoiseState& state) {
+        const size_t rowBytes = rowValues(image) * sizeof(Channel);
+        if (image.isContinuous()) {
+            fillBytes(image.data(), rowBytes * rows(image), state);
+            return;
+        }
+        for (int y = 0; y < rows(image); y++) {
+            fillBytes(image.row(y), rowBytes, state);
+        }
+    }
+
+    static const Frame& encoderInput(const Frame& image, Frame& scratch) {
+        if constexpr (sizeof(Channel) == 1) {
+            return image;
+        } else {
+            scratch.create(static_cast<int>(rowValues(image) / Traits::channels), rows(image), Traits::narrowFormat);
+            if (image.isContinuous()) {
+                narrow(image.template row<Channel>(0), scratch.data(), rowValues(image) * rows(image));
+            } else {
+                for (int y = 0; y < rows(image); y++) {
+                    narrow(image.template row<Channel>(y), scratch.row(y), rowValues(image));
+                }
+            }
+            return scratch;
+        }
+    }
+
+    /// Bits altos de cada valor de 16 bits.
+    static void narrow(const Channel* source, uint8_t* target, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            target[i] = static_cast<uint8_t>(source[i] >> 8);
+        }
+    }
+
+    static constexpr PixelKernels table(const char* variant) {
+        return PixelKernels{Format, Width, Height, variant, Traits::tjPixelFormat, Traits::tjSubsampling,
+                            &fillNoise, &encoderInput};
+    }
+};
+
+/**
+ * @brief Relleno genérico: cv::randu con los límites del tipo, o fila a fila sin OpenCV.
+ */
+void genericFillNoise(Frame& image, NoiseState& state) {
+#ifdef FASTCAP_HAVE_OPENCV
+    (void)state;
+    cv::Mat view = toMat(image);
+    const double upper = image.format() == PixelFormat::Gray16 ? 65536.0 : 256.0;
+    cv::randu(view, cv::Scalar::all(0), cv::Scalar::all(upper));
+#else
+    for (int y = 0; y < image.height(); y++) {
+        fillBytes(image.row(y), image.rowSize(), state);
+    }
+#endif
+}
+
+/**
+ * @brief Conversión genérica: comprueba el formato en cada llamada.
+ */
+const Frame& genericEncoderInput(const Frame& image, Frame& scratch) {
+    if (image.format() != PixelFormat::Gray16) return image;
+    scratch.create(image.width(), image.height(), PixelFormat::Gray8);
+    const size_t values = static_cast<size_t>(image.width()) * pixelChannels(image.format());
+    for (int y = 0; y < image.height(); y++) {
+        const uint16_t* source = image.row<uint16_t>(y);
+        uint8_t* target = scratch.row(y);
+        for (size_t x = 0; x < values; x++) {
+            target[x] = static_cast<uint8_t>(source[x] >> 8);
+        }
+    }
+    return scratch;
+}
+
+template <PixelFormat Format>
+constexpr PixelKernels genericTable() {
+    return PixelKernels{Format, 0, 0, "genérico", PixelTraits<Format>::tjPixelFormat, PixelTraits<Format>::tjSubsampling,
+                        &genericFillNoise, &genericEncoderInput};
+}
+
+/// Resoluciones con instancia propia.
+constexpr int kFullHdWidth = 1920, kFullHdHeight = 1080;
+constexpr int kUhdWidth = 3840, kUhdHeight = 2160;
+
+/**
+ * @brief Las cuatro variantes de un formato.
+ */
+struct FormatKernels {
+    PixelKernels generic;
+    PixelKernels specialized;
+    PixelKernels fullHd;
+    PixelKernels uhd;
+};
+
+template <PixelFormat Format>
+constexpr FormatKernels formatKernels() {
+    return FormatKernels{
+        genericTable<Format>(),
+        Kernels<Format>::table("especializado"),
+        Kernels<Format, kFullHdWidth, kFullHdHeight>::table("especializado 1920x1080"),
+        Kernels<Format, kUhdWidth, kUhdHeight>::table("especializado 3840x2160"),
+    };
+}
+
+const FormatKernels kBgr = formatKernels<PixelFormat::Bgr8>();
+const FormatKernels kBgra = formatKernels<PixelFormat::Bgra8>();
+const FormatKernels kGray = formatKernels<PixelFormat::Gray8>();
+const FormatKernels kGray16 = formatKernels<PixelFormat::Gray16>();
+
+const FormatKernels* findFormat(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::Bgr8: return &kBgr;
+        case PixelFormat::Bgra8: return &kBgra;
+        case PixelFormat::Gray8: return &kGray;
+        case PixelFormat::Gray16: return &kGray16;
+        default: return nullptr;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Siembra los carriles con splitmix64 para que no partan de estados parecidos.
+ */
+NoiseState::NoiseState(uint64_t seed) {
+    for (auto& lane : lanes) {
+        seed += 0x9E3779B97F4A7C15ull;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        lane = (z ^ (z >> 31)) | 1;  // xorshift no admite el estado 0
+    }
+}
+
+/**
+ * @brief Elige la instancia de resolución fija si coincide; si no, la de ancho variable.
+ */
+const PixelKernels* selectPixelKernels(PixelFormat format, int width, int height, bool fixedResolution) {
+    const FormatKernels* kernels = findFormat(format);
+    if (!kernels) return nullptr;
+    if (fixedResolution) {
+        if (width == kFullHdWidth && height == kFullHdHeight) return &kernels->fullHd;
+        if (width == kUhdWidth && height == kUhdHeight) return &kernels->uhd;
+    }
+    return &kernels->specialized;
+}
+
+const PixelKernels* genericPixelKernels(PixelFormat format) {
+    const FormatKernels* kernels = findFormat(format);
+    return kernels ? &kernels->generic : nullptr;
+}
+
+std::string describePixelKernels(const PixelKernels& kernels) {
+    std::ostringstream oss;
+    oss << pixelFormatName(kernels.format) << ", núcleos " << kernels.variant;
+    return oss.str();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file RateLimiter.cpp
+ * @brief Cubetas de fichas para limitar el ancho de banda y las IOPS de los escritores.
+ */
+
+#include "RateLimiter.h"
+#include "Utils.h"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @brief Crea una cubeta llena.
+ * @param rate Fichas por segundo (0 = sin límite).
+ * @param burst Capacidad máxima acumulable.
+ */
+TokenBucket::TokenBucket(double rate, double burst) : rate(rate), burst(burst), tokens(burst) {}
+
+/**
+ * @brief Repone las fichas acumuladas desde la última reserva y descuenta `tokens`.
+ * @param requested Fichas a consumir.
+ * @param now Instante actual.
+ * @return Segundos de espera hasta que el saldo vuelva a ser no negativo.
+ */
+double TokenBucket::reserve(double requested, Clock::time_point now) {
+    if (!enabled()) return 0.0;
+
+    if (!started) {
+        lastRefill = now;
+        started = true;
+    }
+    const double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+    if (elapsed > 0.0) {
+        tokens = std::min(burst, tokens + elapsed * rate);
+        lastRefill = now;
+    }
+
+    tokens -= requested;
+    return tokens >= 0.0 ? 0.0 : -tokens / rate;
+}
+
+/**
+ * @brief Crea el limitador con ambas cubetas llenas.
+ * @param clock Reloj usado para reponer fichas y esperar.
+ * @param bytesPerSecond Límite de ancho de banda (0 = sin límite).
+ * @param operationsPerSecond Límite de IOPS (0 = sin límite).
+ * @param burstSeconds Ráfaga permitida, en segundos de tasa acumulada.
+ */
+BandwidthLimiter::BandwidthLimiter(Clock& clock, double bytesPerSecond, double operationsPerSecond,
+                                   double burstSeconds)
+    : clock(clock),
+      bytes(bytesPerSecond, bytesPerSecond * burstSeconds),
+      // Al menos una operación de ráfaga, para que una IOPS baja no bloquee siempre
+      operations(operationsPerSecond, std::max(1.0, operationsPerSecond * burstSeconds)) {}
+
+/**
+ * @brief Reserva la escritura en ambas cubetas y espera lo necesario fuera del mutex.
+ * @param size Tamaño de la escritura en bytes.
+ * @return Tiempo esperado por el limitador.
+ */
+Clock::duration BandwidthLimiter::acquire(size_t size) {
+    if (!enabled()) return Clock::duration::zero();
+
+    double waitSeconds = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto now = clock.now();
+        waitSeconds = std::max(bytes.reserve(static_cast<double>(size), now),
+                               operations.reserve(1.0, now));
+    }
+
+    if (waitSeconds <= 0.0) return Clock::duration::zero();
+    const auto wait = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(waitSeconds));
+    clock.sleepFor(wait);
+    return wait;
+}
+
+/**
+ * @brief Descripción legible de los límites configurados.
+ */
+std::string BandwidthLimiter::describe() const {
+    if (!enabled()) return "sin límite";
+    std::ostringstream oss;
+    if (bytes.enabled()) {
+        oss << formatByteSize(static_cast<size_t>(bytes.getRate())) << "/s (ráfaga "
+            << formatByteSize(static_cast<size_t>(bytes.getBurst())) << ")";
+    }
+    if (operations.enabled()) {
+        if (bytes.enabled()) oss << ", ";
+        oss << operations.getRate() << " IOPS (ráfaga " << operations.getBurst() << ")";
+    }
+    return oss.str();
+}
@@ -0,0 +1,167 @@
+/**
+ * @file RetryQueue.cpp
+ * @brief Reintentos de escritura con espera exponencial y destino alternativo.
+ */
+
+#include "RetryQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Crea la cola e inicia su hilo.
+ */
+RetryQueue::RetryQueue(Storage& storage, const RetryPolicy& policy, Storage* spill, PipelineStats& stats,
+                       CipherIndex* cipherIndex, BandwidthLimiter* limiter)
+    : storage(storage), policy(policy), spill(spill), stats(stats), cipherIndex(cipherIndex), limiter(limiter) {
+    worker = std::thread(&RetryQueue::loop, this);
+}
+
+RetryQueue::~RetryQueue() {
+    drain();
+}
+
+/**
+ * @brief Programa el primer reintento; un error permanente pasa directamente al destino alternativo.
+ */
+bool RetryQueue::submit(const std::string& name, const Storage::SharedBuffer& data, const FrameMeta& meta, int error,
+                        const CipherNonce* nonce) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping || items.size() + inFlight >= policy.capacity) {
+        return false;
+    }
+    Item item;
+    item.name = name;
+    item.data = data;
+    item.meta = meta;
+    item.lastError = error;
+    if (nonce) {
+        item.encrypted = true;
+        item.nonce = *nonce;
+    }
+    auto due = std::chrono::steady_clock::now();
+    if (isTransientStorageError(error)) {
+        due += backoffLocked(0);
+    } else {
+        item.attempts = policy.maxAttempts;
+    }
+    items.emplace(due, std::move(item));
+    wake.notify_one();
+    return true;
+}
+
+/**
+ * @brief `baseDelay * 2^attempts`, limitado a `maxDelay`, con variación entre la mitad y el total.
+ */
+std::chrono::steady_clock::duration RetryQueue::backoffLocked(int attempts) {
+    const double limit = std::min(policy.maxDelay, policy.baseDelay * std::ldexp(1.0, std::min(attempts, 30)));
+    std::uniform_real_distribution<double> jitter(0.5, 1.0);
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(limit * jitter(rng)));
+}
+
+/**
+ * @brief Reintenta cada fotograma al vencer su espera.
+ */
+void RetryQueue::loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        if (items.empty()) {
+            idle.notify_all();
+            if (stopping) break;
+            wake.wait(lock);
+            continue;
+        }
+        const auto due = items.begin()->first;
+        if (std::chrono::steady_clock::now() < due) {
+            wake.wait_until(lock, due);
+            continue;
+        }
+
+        Item item = std::move(items.begin()->second);
+        items.erase(items.begin());
+        inFlight++;
+        lock.unlock();
+
+        bool done = false;
+        if (item.attempts < policy.maxAttempts) {
+            item.attempts++;
+            stats.writeRetries++;
+            throttle(item);
+            setStorageError(0);
+            if (storage.writeFrame(item.name, item.data, item.meta)) {
+                stats.writeRecoveries++;
+                saved(item);
+                done = true;
+            } else {
+                item.lastError = lastStorageError();
+                if (!isTransientStorageError(item.lastError)) item.attempts = policy.maxAttempts;
+            }
+        }
+        if (!done && item.attempts >= policy.maxAttempts) {
+            giveUp(item);
+            done = true;
+        }
+
+        lock.lock();
+        inFlight--;
+        if (!done) {
+            const auto next = std::chrono::steady_clock::now() + backoffLocked(item.attempts);
+            items.emplace(next, std::move(item));
+        }
+    }
+}
+
+/**
+ * @brief Guarda el fotograma en el destino alternativo o lo da por perdido.
+ */
+void RetryQueue::giveUp(const Item& item) {
+    if (spill) throttle(item);
+    if (spill && spill->writeFrame(item.name, item.data, item.meta)) {
+        stats.writeSpills++;
+        saved(item);
+        return;
+    }
+    stats.writeFailures++;
+    std::cerr << "Error al escribir imagen tras " << item.attempts << " reintentos: " << item.name
+              << " (" << (item.lastError != 0 ? std::strerror(item.lastError) : "error desconocido") << ")" << std::endl;
+}
+
+/**
+ * @brief Cuenta la espera en los mismos contadores que los escritores.
+ */
+void RetryQueue::throttle(const Item& item) {
+    if (!limiter) return;
+    const auto waited = limiter->acquire(item.data->size());
+    if (waited > Clock::duration::zero()) {
+        stats.throttledWrites++;
+        stats.throttleWaitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count();
+    }
+}
+
+void RetryQueue::saved(const Item& item) {
+    countSavedFrame(stats, item.data->size());
+    if (item.encrypted && cipherIndex) {
+        cipherIndex->record(item.name, item.nonce, item.data->size());
+    }
+}
+
+/**
+ * @brief Espera a que la cola se vacíe (reintentos incluidos) y detiene el hilo.
+ */
+void RetryQueue::drain() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!worker.joinable()) return;
+        stopping = true;
+        wake.notify_one();
+        idle.wait(lock, [this] { return items.empty() && inFlight == 0; });
+    }
+    worker.join();
+}
+
+size_t RetryQueue::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return items.size() + inFlight;
+}
@@ -0,0 +1,648 @@
+/**
+ * @file SegmentStorage.cpp
+ * @brief Segmentos de registros con CRC32C, checkpoints periódicos y recuperación en paralelo.
+ */
+
+#include "SegmentStorage.h"
+#include "Crc32c.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+/// Longitud máxima del nombre de un registro.
+constexpr size_t kMaxNameSize = 1024;
+
+/// Desorden máximo previsto entre las marcas de tiempo de los registros: lo que puede
+/// retrasarse un fotograma en la cola y en los escritores respecto a los siguientes.
+constexpr int64_t kTimeIndexSlackNs = 5'000'000'000;
+
+/**
+ * @brief Escribe todos los bytes de un vector de E/S, reintentando escrituras parciales.
+ */
+bool writeAll(int fd, struct iovec* parts, int count) {
+    while (count > 0) {
+        const ssize_t written = writev(fd, parts, count);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        size_t remaining = static_cast<size_t>(written);
+        while (count > 0 && remaining >= parts->iov_len) {
+            remaining -= parts->iov_len;
+            parts++;
+            count--;
+        }
+        if (count > 0) {
+            parts->iov_base = static_cast<char*>(parts->iov_base) + remaining;
+            parts->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Lee exactamente `size` bytes en `offset`.
+ */
+bool readAt(int fd, void* target, size_t size, uint64_t offset) {
+    auto* bytes = static_cast<char*>(target);
+    while (size > 0) {
+        const ssize_t got = pread(fd, bytes, size, static_cast<off_t>(offset));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        bytes += got;
+        size -= static_cast<size_t>(got);
+        offset += static_cast<uint64_t>(got);
+    }
+    return true;
+}
+
+/**
+ * @brief CRC de la cabecera (con headerCrc a cero) seguida del nombre.
+ */
+uint32_t headerChecksum(SegmentRecordHeader header, const char* name) {
+    header.headerCrc = 0;
+    return crc32c(name, header.nameSize, crc32c(&header, sizeof(header)));
+}
+
+/**
+ * @brief Sincroniza un directorio para que un rename sobreviva a un corte.
+ */
+void syncDirectory(const std::string& directory) {
+    const int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief Número de segmento de un nombre `seg_NNNNNNNN.dat`.
+ */
+bool parseSegmentName(const std::string& file, uint64_t& number) {
+    unsigned long long value = 0;
+    if (file.size() < 8 || file.compare(file.size() - 4, 4, ".dat") != 0) return false;
+    if (std::sscanf(file.c_str(), "seg_%llu.dat", &value) != 1) return false;
+    number = value;
+    return true;
+}
+} // namespace
+
+/**
+ * @brief Prepara el directorio y el índice temporal.
+ *
+ * Cada ejecución empieza un segmento nuevo tras el mayor existente, sin reabrir los
+ * anteriores. El hilo de checkpoint se lanza después, cuando la tabla es válida.
+ */
+SegmentStorage::SegmentStorage(const std::string& directory, size_t segmentSize, double checkpointInterval,
+                               double timeIndexInterval)
+    : directory(directory), segmentSize(segmentSize), checkpointInterval(checkpointInterval) {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        uint64_t number = 0;
+        if (parseSegmentName(entry.path().filename().string(), number)) {
+            nextSegment = std::max(nextSegment, number + 1);
+        }
+    }
+    if (timeIndexInterval > 0.0) {
+        const auto interval = static_cast<int64_t>(timeIndexInterval * 1e9);
+        if (!timeIndex.open(directory + "/time.idx", interval, kTimeIndexSlackNs)) {
+            std::cerr << "Aviso: no se pudo abrir el índice temporal en " << directory << std::endl;
+        }
+    }
+}
+
+SegmentStorage::~SegmentStorage() {
+    close();
+}
+
+std::string SegmentStorage::segmentPath(uint64_t number) const {
+    std::ostringstream oss;
+    oss << directory << "/seg_" << std::setw(8) << std::setfill('0') << number << ".dat";
+    return oss.str();
+}
+
+/**
+ * @brief Abre el segmento siguiente; el anterior queda pendiente de sincronizar.
+ */
+bool SegmentStorage::openNextLocked() {
+    if (activeFd >= 0) {
+        closing.push_back(activeFd);
+        activeFd = -1;
+    }
+    const uint64_t number = nextSegment;
+    const int fd = open(segmentPath(number).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        const int error = errno;
+        std::cerr << "Error al crear el segmento " << segmentPath(number) << ": " << std::strerror(error) << std::endl;
+        setStorageError(error);
+        return false;
+    }
+    nextSegment++;
+    activeFd = fd;
+    activeNumber = number;
+    segments[number] = SegmentInfo();
+    return true;
+}
+
+/**
+ * @brief Añade un registro al segmento activo, rotando si no cabe.
+ *
+ * Si la escritura falla a medias, el segmento se recorta a la última longitud válida.
+ */
+bool SegmentStorage::appendLocked(const std::string& name, const unsigned char* data, size_t size,
+                                  uint64_t sequence, int64_t timestampNs) {
+    if (name.size() > kMaxNameSize || size > UINT32_MAX) {
+        setStorageError(EINVAL);
+        return false;
+    }
+    const uint64_t recordSize = sizeof(SegmentRecordHeader) + name.size() + size;
+
+    if (activeFd < 0 || (segments[activeNumber].length > 0 &&
+                         segments[activeNumber].length + recordSize > segmentSize)) {
+        if (!openNextLocked()) return false;
+    }
+    // Sin recover() previo, la tabla pasa a ser válida con el primer registro
+    if (!tableReady) {
+        tableReady = true;
+        startCheckpoints();
+    }
+
+    SegmentRecordHeader header{};
+    header.magic = kSegmentRecordMagic;
+    header.payloadSize = static_cast<uint32_t>(size);
+    header.sequence = sequence;
+    header.nameSize = static_cast<uint16_t>(name.size());
+    header.timestampNs = timestampNs;
+    header.payloadCrc = crc32c(data, size);
+    header.headerCrc = headerChecksum(header, name.data());
+
+    struct iovec parts[3];
+    parts[0].iov_base = &header;
+    parts[0].iov_len = sizeof(header);
+    parts[1].iov_base = const_cast<char*>(name.data());
+    parts[1].iov_len = name.size();
+    parts[2].iov_base = const_cast<unsigned char*>(data);
+    parts[2].iov_len = size;
+
+    SegmentInfo& info = segments[activeNumber];
+    errno = 0;
+    if (!writeAll(activeFd, parts, 3)) {
+        setStorageError(errno != 0 ? errno : ENOSPC);
+        if (ftruncate(activeFd, static_cast<off_t>(info.length)) != 0 ||
+            lseek(activeFd, static_cast<off_t>(info.length), SEEK_SET) < 0) {
+            // El segmento queda inservible: los siguientes registros van a uno nuevo
+            openNextLocked();
+        }
+        return false;
+    }
+
+    if (timeIndex.isOpen()) {
+        timeIndex.add(activeNumber, info.length, recordSize, timestampNs);
+    }
+    info.length += recordSize;
+    info.maxSequence = info.records == 0 ? sequence : std::max(info.maxSequence, sequence);
+    info.records++;
+    nextSequence = std::max(nextSequence, sequence + 1);
+    recordsWritten++;
+    return true;
+}
+
+bool SegmentStorage::writeFrame(const std::string& name, const SharedBuffer& data, const FrameMeta& meta) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendLocked(name, data->data(), data->size(), meta.sequence, meta.timestampNs);
+}
+
+/**
+ * @brief Escritura sin metadatos: la secuencia se toma del nombre si es posible y la
+ * marca de tiempo es la de la escritura.
+ */
+bool SegmentStorage::write(const std::string& name, const std::vector<unsigned char>& data) {
+    uint64_t sequence = 0;
+    parseFrameSequence(name, sequence);
+    const int64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendLocked(name, data.data(), data.size(), sequence, timestampNs);
+}
+
+/**
+ * @brief Cierra el segmento activo; el siguiente registro abre uno nuevo.
+ */
+bool SegmentStorage::rollover() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (activeFd >= 0 && segments[activeNumber].length > 0) {
+        closing.push_back(activeFd);
+        activeFd = -1;
+        timeIndex.flush();
+    }
+    return true;
+}
+
+/**
+ * @brief Lanza el hilo de checkpoint una sola vez, salvo que ya se haya cerrado.
+ */
+void SegmentStorage::startCheckpoints() {
+    std::lock_guard<std::mutex> lock(checkpointMutex);
+    if (stopping || checkpointThread.joinable()) return;
+    checkpointThread = std::thread(&SegmentStorage::checkpointLoop, this);
+}
+
+/**
+ * @brief Guarda un checkpoint cada `checkpointInterval` segundos hasta que se detenga.
+ */
+void SegmentStorage::checkpointLoop() {
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(checkpointInterval));
+    std::unique_lock<std::mutex> lock(checkpointMutex);
+    while (!stopping) {
+        if (wake.wait_for(lock, interval, [this] { return stopping; })) break;
+        lock.unlock();
+        checkpoint();
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Sincroniza los datos y guarda el checkpoint con las longitudes ya durables.
+ *
+ * Las longitudes se toman antes del `fdatasync`, así que todo lo que registra el
+ * checkpoint está en disco cuando se escribe.
+ */
+bool SegmentStorage::checkpoint() {
+    std::lock_guard<std::mutex> serialLock(checkpointSerial);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::map<uint64_t, SegmentInfo> snapshot;
+    std::vector<int> closed;
+    int fd = -1;
+    uint64_t next = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = segments;
+        closed.swap(closing);
+        fd = activeFd;
+        next = nextSequence;
+    }
+
+    // Solo este método cierra descriptores, así que `fd` sigue abierto aunque se rote
+    bool synced = true;
+    for (int closedFd : closed) {
+        synced = fdatasync(closedFd) == 0 && synced;
+        ::close(closedFd);
+    }
+    if (fd >= 0) {
+        synced = fdatasync(fd) == 0 && synced;
+    }
+    // Las entradas del índice que queden por delante de los datos se recortan al recuperar
+    timeIndex.sync();
+    if (!synced) {
+        std::cerr << "Aviso: fdatasync falló en " << directory << "; se omite el checkpoint" << std::endl;
+        return false;
+    }
+
+    const bool saved = saveCheckpoint(snapshot, next);
+    if (saved) {
+        checkpoints++;
+        const int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        int64_t peak = maxCheckpointNs.load();
+        while (elapsed > peak && !maxCheckpointNs.compare_exchange_weak(peak, elapsed)) {
+        }
+    }
+    return saved;
+}
+
+/**
+ * @brief Escribe `segments.ckpt`: una línea por segmento y el CRC32C del contenido.
+ */
+bool SegmentStorage::saveCheckpoint(const std::map<uint64_t, SegmentInfo>& table, uint64_t next) const {
+    std::ostringstream oss;
+    oss << "fastcap-segments 1\n";
+    for (const auto& [number, info] : table) {
+        oss << "segment " << number << " " << info.length << " " << info.records << " " << info.maxSequence << "\n";
+    }
+    oss << "next " << next << "\n";
+    std::string content = oss.str();
+    char crcLine[32];
+    std::snprintf(crcLine, sizeof(crcLine), "crc %08x\n", crc32c(content.data(), content.size()));
+    content += crcLine;
+
+    const std::string path = directory + "/segments.ckpt";
+    const std::string partial = path + ".tmp";
+    const int fd = open(partial.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    struct iovec part{const_cast<char*>(content.data()), content.size()};
+    const bool ok = writeAll(fd, &part, 1) && fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || std::rename(partial.c_str(), path.c_str()) != 0) {
+        std::remove(partial.c_str());
+        return false;
+    }
+    syncDirectory(directory);
+    return true;
+}
+
+/**
+ * @brief Lee `segments.ckpt` y comprueba su CRC.
+ */
+bool SegmentStorage::loadCheckpoint(std::map<uint64_t, SegmentInfo>& table, uint64_t& next) const {
+    std::ifstream in(directory + "/segments.ckpt", std::ios::binary);
+    if (!in) return false;
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    const size_t crcPos = content.rfind("crc ");
+    if (crcPos == std::string::npos) return false;
+    unsigned expected = 0;
+    if (std::sscanf(content.c_str() + crcPos, "crc %x", &expected) != 1 ||
+        crc32c(content.data(), crcPos) != expected) {
+        return false;
+    }
+
+    std::istringstream lines(content.substr(0, crcPos));
+    std::string tag;
+    int version = 0;
+    if (!(lines >> tag >> version) || tag != "fastcap-segments" || version != 1) return false;
+    while (lines >> tag) {
+        if (tag == "segment") {
+            uint64_t number = 0;
+            SegmentInfo info;
+            if (!(lines >> number >> info.length >> info.records >> info.maxSequence)) return false;
+            table[number] = info;
+        } else if (tag == "next") {
+            if (!(lines >> next)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Verifica los registros posteriores a la parte confirmada por el checkpoint.
+ *
+ * Se detiene en el primer registro incompleto o con CRC erróneo y trunca el segmento
+ * ahí: con escrituras solo por el final, lo que sigue es la cola rota de un corte.
+ */
+SegmentStorage::ScanResult SegmentStorage::scanSegment(uint64_t number, const SegmentInfo& trusted) const {
+    ScanResult result;
+    const int fd = open(segmentPath(number).c_str(), O_RDWR | O_CLOEXEC);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        if (fd >= 0) ::close(fd);
+        result.ok = false;
+        return result;
+    }
+    const uint64_t size = static_cast<uint64_t>(status.st_size);
+
+    result.info = size >= trusted.length ? trusted : SegmentInfo();
+    if (size == result.info.length) {
+        ::close(fd);
+        return result;
+    }
+
+    result.scanned = true;
+    uint64_t offset = result.info.length;
+    std::vector<char> buffer;
+    while (offset + sizeof(SegmentRecordHeader) <= size) {
+        SegmentRecordHeader header;
+        if (!readAt(fd, &header, sizeof(header), offset) || header.magic != kSegmentRecordMagic ||
+            header.nameSize > kMaxNameSize) {
+            break;
+        }
+        const uint64_t recordSize = sizeof(header) + header.nameSize + header.payloadSize;
+        if (offset + recordSize > size) break;
+
+        buffer.resize(header.nameSize + static_cast<size_t>(header.payloadSize));
+        if (!readAt(fd, buffer.data(), buffer.size(), offset + sizeof(header)) ||
+            headerChecksum(header, buffer.data()) != header.headerCrc ||
+            crc32c(buffer.data() + header.nameSize, header.payloadSize) != header.payloadCrc) {
+            break;
+        }
+
+        offset += recordSize;
+        result.info.length = offset;
+        result.info.maxSequence = result.info.records == 0 ? header.sequence
+                                                           : std::max(result.info.maxSequence, header.sequence);
+        result.info.records++;
+    }
+
+    if (offset < size) {
+        result.truncatedBytes = size - offset;
+        result.ok = ftruncate(fd, static_cast<off_t>(offset)) == 0 && fdatasync(fd) == 0;
+    }
+    ::close(fd);
+    return result;
+}
+
+/**
+ * @brief Recupera el estado de los segmentos existentes en paralelo.
+ *
+ * Los segmentos cuyo tamaño coincide con el checkpoint no se leen; el resto se
+ * verifica desde la última longitud confirmada, repartidos entre varios hilos. Todo
+ * se hace con `checkpointSerial` tomado, así ningún checkpoint puede escribir una
+ * tabla a medias ni pisar el temporal; el hilo de checkpoint arranca al terminar.
+ */
+bool SegmentStorage::recover(uint64_t& nextSequenceOut) {
+    const bool recovered = recoverSegments(nextSequenceOut);
+    startCheckpoints();
+    return recovered;
+}
+
+/**
+ * @brief Reconstruye la tabla de segmentos y guarda un checkpoint con ella.
+ */
+bool SegmentStorage::recoverSegments(uint64_t& nextSequenceOut) {
+    std::lock_guard<std::mutex> serialLock(checkpointSerial);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::map<uint64_t, SegmentInfo> trusted;
+    uint64_t checkpointNext = 0;
+    const bool haveCheckpoint = loadCheckpoint(trusted, checkpointNext);
+
+    std::vector<uint64_t> numbers;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        uint64_t number = 0;
+        if (parseSegmentName(entry.path().filename().string(), number)) {
+            numbers.push_back(number);
+        }
+    }
+    if (numbers.empty()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tableReady = true;
+        return false;
+    }
+    std::sort(numbers.begin(), numbers.end());
+
+    std::vector<ScanResult> results(numbers.size());
+    std::atomic<size_t> cursor{0};
+    const size_t threadCount = std::min<size_t>(numbers.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> scanners;
+    for (size_t t = 0; t < threadCount; t++) {
+        scanners.emplace_back([&] {
+            for (size_t i = cursor++; i < numbers.size(); i = cursor++) {
+                const auto known = trusted.find(numbers[i]);
+                results[i] = scanSegment(numbers[i], known != trusted.end() ? known->second : SegmentInfo());
+            }
+        });
+    }
+    for (auto& scanner : scanners) scanner.join();
+
+    size_t scanned = 0, truncatedSegments = 0;
+    uint64_t truncatedBytes = 0, records = 0, bytes = 0;
+    uint64_t recovered = checkpointNext;
+    size_t reindexed = 0;
+    std::map<uint64_t, SegmentInfo> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < numbers.size(); i++) {
+            const ScanResult& result = results[i];
+            segments[numbers[i]] = result.info;
+            if (result.scanned) scanned++;
+            if (result.truncatedBytes > 0) {
+                truncatedSegments++;
+                truncatedBytes += result.truncatedBytes;
+            }
+            if (!result.ok) {
+                std::cerr << "Aviso: no se pudo recuperar " << segmentPath(numbers[i]) << std::endl;
+            }
+            records += result.info.records;
+            bytes += result.info.length;
+            if (result.info.records > 0) recovered = std::max(recovered, result.info.maxSequence + 1);
+        }
+        nextSegment = std::max(nextSegment, numbers.back() + 1);
+        nextSequence = std::max(nextSequence, recovered);
+        if (timeIndex.isOpen()) {
+            reindexed = reindexTail();
+        }
+        tableReady = true;
+        snapshot = segments;
+    }
+    saveCheckpoint(snapshot, recovered);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(3)
+            << numbers.size() << " segmentos (" << formatByteSize(bytes) << ", " << records << " registros), "
+            << scanned << " verificados " << (haveCheckpoint ? "tras el checkpoint" : "sin checkpoint")
+            << " con " << threadCount << " hilos, " << truncatedSegments << " truncados ("
+            << formatByteSize(truncatedBytes) << "), siguiente secuencia " << recovered;
+    if (timeIndex.isOpen()) {
+        summary << ", índice temporal de " << timeIndex.entries() << " entradas (" << reindexed << " registros reindexados)";
+    }
+    summary << ", " << seconds << " s";
+    recoverySummary = summary.str();
+    std::cout << "Recuperación: " << recoverySummary << std::endl;
+
+    nextSequenceOut = std::max(nextSequenceOut, recovered);
+    return true;
+}
+
+/**
+ * @brief Completa el índice temporal con los registros recuperados que no tienen entrada.
+ *
+ * Recorta las entradas que apuntan más allá de los datos válidos y recorre solo las
+ * cabeceras de los registros posteriores a la última entrada conservada.
+ */
+size_t SegmentStorage::reindexTail() {
+    uint64_t segment = 0, offset = 0;
+    const auto lengthOf = [this](uint64_t number) {
+        const auto found = segments.find(number);
+        return found != segments.end() ? found->second.length : 0;
+    };
+    if (!timeIndex.trim(lengthOf, segment, offset)) {
+        segment = segments.empty() ? 0 : segments.begin()->first;
+        offset = 0;
+    }
+
+    size_t indexed = 0;
+    for (auto it = segments.lower_bound(segment); it != segments.end(); ++it) {
+        uint64_t position = it->first == segment ? offset : 0;
+        if (position >= it->second.length) continue;
+        const int fd = open(segmentPath(it->first).c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+        SegmentRecordHeader header;
+        while (position + sizeof(header) <= it->second.length &&
+               readAt(fd, &header, sizeof(header), position) && header.magic == kSegmentRecordMagic) {
+            const uint64_t recordSize = sizeof(header) + header.nameSize + header.payloadSize;
+            timeIndex.add(it->first, position, recordSize, header.timestampNs);
+            position += recordSize;
+            indexed++;
+        }
+        ::close(fd);
+    }
+    timeIndex.flush();
+    return indexed;
+}
+
+/**
+ * @brief Detiene el hilo de checkpoint, guarda el último checkpoint y cierra los segmentos.
+ *
+ * Si la tabla nunca llegó a ser válida (sin recover() ni registros) se conserva el
+ * checkpoint existente en lugar de sustituirlo por una tabla vacía.
+ */
+void SegmentStorage::close() {
+    {
+        std::lock_guard<std::mutex> lock(checkpointMutex);
+        if (stopping) return;
+        stopping = true;
+    }
+    wake.notify_all();
+    if (checkpointThread.joinable()) {
+        checkpointThread.join();
+    }
+    bool ready = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (activeFd >= 0) {
+            closing.push_back(activeFd);
+            activeFd = -1;
+        }
+        timeIndex.close();
+        ready = tableReady;
+    }
+    if (ready) checkpoint();
+}
+
+/**
+ * @brief Descripción del destino.
+ */
+std::string SegmentStorage::describe() const {
+    std::ostringstream oss;
+    oss << "segmentos en " << directory << " (hasta " << formatByteSize(segmentSize)
+        << ", checkpoint cada " << checkpointInterval << " s)";
+    return oss.str();
+}
+
+/**
+ * @brief Informe para los resultados finales.
+ */
+std::string SegmentStorage::report() const {
+    size_t count = 0;
+    uint64_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        count = segments.size();
+        for (const auto& entry : segments) bytes += entry.second.length;
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "Segmentos: " << count << " (" << formatByteSize(bytes) << "), registros en esta ejecución: "
+        << recordsWritten.load();
+    if (timeIndex.entries() > 0) oss << ", entradas del índice temporal: " << timeIndex.entries();
+    oss << "\nCheckpoints: " << checkpoints.load() << ", el más lento " << maxCheckpointNs.load() / 1e6 << " ms";
+    if (!recoverySummary.empty()) oss << "\nRecuperación al arrancar: " << recoverySummary;
+    return oss.str();
+}
@@ -0,0 +1,171 @@
+/**
+ * @file Startup.cpp
+ * @brief Inicialización en paralelo y medida del tiempo hasta el primer fotograma.
+ */
+
+#include "Startup.h"
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+/// Intervalo de muestreo de los contadores.
+constexpr auto kSampleInterval = std::chrono::milliseconds(10);
+
+/// Ventana en la que se compara lo guardado con lo generado.
+constexpr auto kSteadyWindow = std::chrono::seconds(1);
+
+/// Fracción de lo generado que deben guardar los escritores en la ventana.
+constexpr double kSteadyRatio = 0.95;
+
+std::string formatDuration(double seconds) {
+    std::ostringstream oss;
+    oss << std::fixed;
+    if (seconds < 1.0) {
+        oss << std::setprecision(1) << seconds * 1000.0 << " ms";
+    } else {
+        oss << std::setprecision(2) << seconds << " s";
+    }
+    return oss.str();
+}
+
+/**
+ * @brief Instante de steady_clock a partir de los ns guardados en PipelineStats.
+ */
+StartupMonitor::TimePoint toTimePoint(int64_t steadyNs) {
+    return StartupMonitor::TimePoint(
+        std::chrono::duration_cast<StartupMonitor::TimePoint::duration>(std::chrono::nanoseconds(steadyNs)));
+}
+} // namespace
+
+void ParallelInit::add(const std::string& name, std::function<bool()> step) {
+    steps.push_back(Step{name, std::move(step)});
+}
+
+/**
+ * @brief Lanza un hilo por paso salvo el último, que corre en el hilo del llamador.
+ */
+bool ParallelInit::run() {
+    const auto start = std::chrono::steady_clock::now();
+    auto execute = [](Step& step) {
+        const auto begin = std::chrono::steady_clock::now();
+        step.ok = step.run();
+        step.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + 1 < steps.size(); i++) {
+        threads.emplace_back(execute, std::ref(steps[i]));
+    }
+    if (!steps.empty()) execute(steps.back());
+    for (auto& thread : threads) thread.join();
+    wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool ok = true;
+    for (const auto& step : steps) ok = ok && step.ok;
+    return ok;
+}
+
+std::string ParallelInit::describe() const {
+    std::ostringstream oss;
+    oss << formatDuration(wallSeconds);
+    if (!steps.empty()) {
+        oss << " (";
+        for (size_t i = 0; i < steps.size(); i++) {
+            if (i > 0) oss << ", ";
+            oss << steps[i].name << " " << formatDuration(steps[i].seconds);
+        }
+        oss << ")";
+    }
+    return oss.str();
+}
+
+StartupMonitor::StartupMonitor(const PipelineStats& stats, TimePoint processStart)
+    : stats(stats), processStart(processStart) {}
+
+StartupMonitor::~StartupMonitor() {
+    stop();
+}
+
+void StartupMonitor::initialized(const ParallelInit& init) {
+    initDoneSeconds = since(std::chrono::steady_clock::now());
+    initSummary = init.describe();
+}
+
+void StartupMonitor::generatorStarted(const FrameSource& source) {
+    generatorSeconds = since(std::chrono::steady_clock::now());
+    sampler = std::thread([this, &source] { sample(source); });
+}
+
+void StartupMonitor::stop() {
+    stopping = true;
+    if (sampler.joinable()) sampler.join();
+}
+
+/**
+ * @brief Muestrea los contadores hasta ver el origen listo y una ventana estable.
+ */
+void StartupMonitor::sample(const FrameSource& source) {
+    struct Sample {
+        TimePoint time;
+        size_t generated;
+        size_t saved;
+    };
+    std::deque<Sample> window;
+
+    while (!stopping.load()) {
+        const auto now = std::chrono::steady_clock::now();
+        if (sourceReadySeconds < 0.0 && source.ready()) {
+            sourceReadySeconds = since(now);
+        }
+        window.push_back(Sample{now, stats.imagesGenerated.load(), stats.imagesSaved.load()});
+
+        // Ventana más corta que cubre kSteadyWindow hasta la muestra actual
+        while (window.size() > 2 && now - window[1].time >= kSteadyWindow) {
+            window.pop_front();
+        }
+        const Sample& first = window.front();
+        const int64_t firstSaveNs = stats.firstSaveNs.load();
+        if (sourceReadySeconds >= 0.0 && firstSaveNs != 0 && now - first.time >= kSteadyWindow) {
+            const size_t generated = window.back().generated - first.generated;
+            const size_t saved = window.back().saved - first.saved;
+            if (generated > 0 && saved >= kSteadyRatio * generated) {
+                // El régimen no empieza antes del primer guardado ni con el origen a medio preparar
+                steadySeconds = std::max({since(first.time), since(toTimePoint(firstSaveNs)), sourceReadySeconds});
+                return;
+            }
+        }
+        std::this_thread::sleep_for(kSampleInterval);
+    }
+}
+
+double StartupMonitor::since(TimePoint point) const {
+    return std::chrono::duration<double>(point - processStart).count();
+}
+
+std::string StartupMonitor::report() const {
+    std::ostringstream oss;
+    oss << "Inicialización en paralelo: " << initSummary << ", lista a los " << formatDuration(initDoneSeconds) << std::endl;
+    oss << "Tiempo hasta el primer fotograma: ";
+    const int64_t firstSaveNs = stats.firstSaveNs.load();
+    if (firstSaveNs != 0) {
+        oss << formatDuration(since(toTimePoint(firstSaveNs)));
+    } else {
+        oss << "ninguno guardado";
+    }
+    oss << " (generador en marcha a los " << formatDuration(generatorSeconds) << ")" << std::endl;
+    if (sourceReadySeconds >= 0.0) {
+        oss << "Origen de fotogramas completo a los " << formatDuration(sourceReadySeconds) << std::endl;
+    } else {
+        oss << "Origen de fotogramas: preparación sin terminar al acabar la generación" << std::endl;
+    }
+    oss << "Tiempo hasta el régimen estable: ";
+    if (steadySeconds >= 0.0) {
+        oss << formatDuration(steadySeconds);
+    } else {
+        oss << "no alcanzado (los escritores no guardaron el " << kSteadyRatio * 100.0
+            << "% de lo generado durante " << kSteadyWindow.count() << " s)";
+    }
+    return oss.str();
+}
@@ -0,0 +1,188 @@
+/**
+ * @file Storage.cpp
+ * @brief Destinos de almacenamiento: directorio en disco y sistema de archivos en memoria.
+ */
+
+#include "Storage.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+/**
+ * @brief Extrae la secuencia de un nombre `img_NNNNNNNN_...`.
+ */
+bool parseFrameSequence(const std::string& name, uint64_t& sequence) {
+    if (name.compare(0, 4, "img_") != 0) return false;
+    size_t i = 4;
+    uint64_t value = 0;
+    while (i < name.size() && std::isdigit(static_cast<unsigned char>(name[i]))) {
+        value = value * 10 + static_cast<uint64_t>(name[i] - '0');
+        i++;
+    }
+    if (i == 4) return false;
+    sequence = value;
+    return true;
+}
+
+namespace {
+thread_local int storageError = 0;  ///< errno de la última escritura fallida del hilo.
+}
+
+int lastStorageError() {
+    return storageError;
+}
+
+void setStorageError(int error) {
+    storageError = error;
+}
+
+bool isTransientStorageError(int error) {
+    switch (error) {
+        case 0:
+        case EAGAIN:
+        case EINTR:
+        case ENOSPC:
+        case EIO:
+        case ETIMEDOUT:
+        case EBUSY:
+        case ESTALE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Borra los temporales huérfanos y busca la mayor secuencia del directorio.
+ *
+ * Solo lee los nombres de las entradas (sin stat), para que sea rápido incluso con
+ * millones de archivos.
+ */
+bool recoverFrameDirectory(const std::string& directory, uint64_t& nextSequence) {
+    std::error_code error;
+    bool found = false;
+    size_t removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const std::string file = entry.path().filename().string();
+        if (file.size() > 4 && file.compare(file.size() - 4, 4, ".tmp") == 0) {
+            std::filesystem::remove(entry.path(), error);
+            removed++;
+            continue;
+        }
+        uint64_t sequence = 0;
+        if (parseFrameSequence(file, sequence)) {
+            nextSequence = std::max(nextSequence, sequence + 1);
+            found = true;
+        }
+    }
+    if (removed > 0) {
+        std::cout << directory << ": " << removed << " escrituras incompletas descartadas" << std::endl;
+    }
+    return found;
+}
+
+/**
+ * @brief Crea un destino en disco.
+ * @param directory Directorio de salida.
+ */
+FileStorage::FileStorage(const std::string& directory) : directory(directory) {}
+
+/**
+ * @brief Escribe el fotograma en `directory/name` a través de un temporal.
+ * @param name Nombre del archivo.
+ * @param data Contenido codificado.
+ * @return true si se escribió completo.
+ */
+bool FileStorage::write(const std::string& name, const std::vector<unsigned char>& data) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        path = directory + "/" + name;
+    }
+    const std::string partial = path + ".tmp";
+    errno = 0;
+    std::ofstream out(partial, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    out.close();
+    if (!out || std::rename(partial.c_str(), path.c_str()) != 0) {
+        setStorageError(errno != 0 ? errno : EIO);
+        std::remove(partial.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Descripción del destino en disco.
+ */
+std::string FileStorage::describe() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return directory;
+}
+
+/**
+ * @brief Cambia el directorio de salida; las escrituras en curso terminan en el anterior.
+ * @param newDirectory Nuevo directorio (debe existir).
+ * @return Siempre true.
+ */
+bool FileStorage::setDirectory(const std::string& newDirectory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    directory = newDirectory;
+    return true;
+}
+
+/**
+ * @brief Revisa el directorio vigente.
+ */
+bool FileStorage::recover(uint64_t& nextSequence) {
+    std::string current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = directory;
+    }
+    return recoverFrameDirectory(current, nextSequence);
+}
+
+/**
+ * @brief Crea un sistema de archivos en memoria.
+ * @param capacity Capacidad en bytes (0 = ilimitada).
+ */
+MemoryStorage::MemoryStorage(size_t capacity) : capacity(capacity) {}
+
+/**
+ * @brief Contabiliza el fotograma sin conservar su contenido.
+ * @param name Nombre del archivo (no se usa).
+ * @param data Contenido codificado.
+ * @return false si se superaría la capacidad configurada.
+ */
+bool MemoryStorage::write(const std::string& /*name*/, const std::vector<unsigned char>& data) {
+    size_t current = used.load();
+    do {
+        if (capacity > 0 && current + data.size() > capacity) {
+            if (!fullReported.exchange(true)) {
+                std::cerr << "Almacenamiento en memoria lleno (" << formatByteSize(capacity) << ")" << std::endl;
+            }
+            setStorageError(ENOSPC);
+            return false;
+        }
+    } while (!used.compare_exchange_weak(current, current + data.size()));
+
+    files++;
+    return true;
+}
+
+/**
+ * @brief Descripción del sistema de archivos en memoria.
+ */
+std::string MemoryStorage::describe() const {
+    std::string text = "memoria (" + std::to_string(files.load()) + " archivos, " + formatByteSize(used.load());
+    if (capacity > 0) {
+        text += " de " + formatByteSize(capacity);
+    }
+    return text + ")";
+}
@@ -0,0 +1,106 @@
+/**
+ * @file TaskPipeline.cpp
+ * @brief Codificación y escritura de fotogramas como tareas con continuaciones.
+ */
+
+#include "TaskPipeline.h"
+
+/**
+ * @brief Crea un FrameProcessor por trabajador; los nombres de archivo llevan `_tN` con N = trabajador + 1.
+ */
+TaskPipeline::TaskPipeline(TaskScheduler& scheduler, Storage& storage, const EncoderSettings& encoderSettings,
+                           const std::atomic<int>& quality, const CipherSettings& cipherSettings,
+                           PipelineStats& stats, BandwidthLimiter* limiter, RetryQueue* retries,
+                           size_t maxInFlight)
+    : scheduler(scheduler), storage(storage), cipherSettings(cipherSettings), stats(stats), limiter(limiter),
+      retries(retries), maxInFlight(maxInFlight) {
+    for (int i = 0; i < scheduler.size(); i++) {
+        processors.push_back(std::make_unique<FrameProcessor>(encoderSettings, quality, cipherSettings, stats, i + 1));
+    }
+}
+
+bool TaskPipeline::isValid() const {
+    for (const auto& processor : processors) {
+        if (!processor->isValid()) return false;
+    }
+    return !processors.empty();
+}
+
+/**
+ * @brief Acepta un fotograma y envía su tarea de codificación.
+ *
+ * Con el máximo en curso alcanzado descarta el fotograma, o con `block` espera a que
+ * termine alguno.
+ */
+bool TaskPipeline::push(const ImageData& data) {
+    while (!done.load() && inFlight.load(std::memory_order_acquire) >= maxInFlight) {
+        if (fullPolicy.load() != QueuePolicy::Block) {
+            droppedCount++;
+            return false;
+        }
+        const EventCount::Key key = slots.prepareWait();
+        if (done.load() || fullPolicy.load() != QueuePolicy::Block ||
+            inFlight.load(std::memory_order_acquire) < maxInFlight) {
+            slots.cancelWait();
+            continue;
+        }
+        slots.wait(key);
+    }
+    if (done.load()) return false;
+
+    inFlight.fetch_add(1, std::memory_order_acq_rel);
+    scheduler.submit([this, data] { encodeTask(data); });
+    return true;
+}
+
+/**
+ * @brief Codifica con el FrameProcessor del trabajador actual y encadena la escritura.
+ */
+void TaskPipeline::encodeTask(const ImageData& data) {
+    FrameProcessor& processor = *processors[TaskScheduler::currentWorker()];
+    EncodedFrame frame;
+    if (!processor.encode(data, frame)) {
+        release();
+        return;
+    }
+    scheduler.submit([this, frame] { writeTask(frame); });
+}
+
+void TaskPipeline::writeTask(const EncodedFrame& frame) {
+    storeFrame(frame, storage, cipherSettings, stats, limiter, retries);
+    release();
+}
+
+void TaskPipeline::release() {
+    if (inFlight.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // Con el mutex tomado, un waitIdle() que acaba de ver inFlight > 0 no pierde el aviso
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idle.notify_all();
+    }
+    slots.notifyOne();
+}
+
+/**
+ * @brief Espera a que terminen todos los fotogramas aceptados, incluidas sus escrituras.
+ */
+bool TaskPipeline::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(idleMutex);
+    return idle.wait_for(lock, timeout, [this] { return inFlight.load(std::memory_order_acquire) == 0; });
+}
+
+/**
+ * @brief Cambia la política; un generador bloqueado la reevalúa.
+ */
+void TaskPipeline::setPolicy(QueuePolicy policy) {
+    fullPolicy = policy;
+    slots.notifyAll();
+}
+
+/**
+ * @brief Deja de aceptar fotogramas y espera a las tareas en curso y sus continuaciones.
+ */
+void TaskPipeline::finish() {
+    done = true;
+    slots.notifyAll();
+    scheduler.waitIdle();
+}
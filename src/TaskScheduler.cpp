@@ -0,0 +1,225 @@
+/**
+ * @file TaskScheduler.cpp
+ * @brief Pool de trabajadores con robo de tareas sobre deques de Chase-Lev.
+ */
+
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+/// Índice del trabajador del hilo actual (-1 fuera del pool).
+thread_local int currentWorkerIndex = -1;
+
+/// Pool al que pertenece el hilo actual, para no apilar en deques de otro pool.
+thread_local const void* currentScheduler = nullptr;
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t xorshift(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+} // namespace
+
+/**
+ * @brief Crea el pool y arranca los trabajadores.
+ * @param workerCount Número de trabajadores; 0 usa `hardware_concurrency`.
+ * @param tuning Prioridades de CPU y de E/S de los trabajadores.
+ */
+TaskScheduler::TaskScheduler(int workerCount, const ThreadTuning& tuning)
+    : tuning(tuning), startNs(steadyNowNs()) {
+    if (workerCount <= 0) {
+        workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    // Los deques deben existir todos antes de que algún trabajador intente robar
+    for (int i = 0; i < workerCount; i++) {
+        workers[i]->thread = std::thread([this, i] { run(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    shutdown();
+}
+
+int TaskScheduler::currentWorker() {
+    return currentWorkerIndex;
+}
+
+/**
+ * @brief Envía una tarea.
+ *
+ * Desde un trabajador de este pool la tarea va a su deque (LIFO para el dueño); desde
+ * otro hilo, a la cola de inyección. En ambos casos despierta a un trabajador dormido,
+ * si lo hay, para que la ejecute o la robe.
+ */
+void TaskScheduler::submit(Task task) {
+    TaskNode* node = new TaskNode{std::move(task)};
+    pendingTasks.fetch_add(1, std::memory_order_acq_rel);
+    if (currentScheduler == this && currentWorkerIndex >= 0) {
+        workers[currentWorkerIndex]->deque.push(node);
+    } else {
+        std::lock_guard<std::mutex> lock(injectMutex);
+        injected.push_back(node);
+        injectedCount.fetch_add(1, std::memory_order_release);
+    }
+    work.notifyOne();
+}
+
+/**
+ * @brief Busca una tarea: primero el deque propio, después la cola de inyección y por
+ * último los deques de los demás, empezando por una víctima aleatoria.
+ */
+TaskScheduler::TaskNode* TaskScheduler::findTask(Worker& self) {
+    TaskNode* node = nullptr;
+    if (self.deque.pop(node)) return node;
+
+    if (injectedCount.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(injectMutex);
+        if (!injected.empty()) {
+            node = injected.front();
+            injected.pop_front();
+            injectedCount.fetch_sub(1, std::memory_order_release);
+            return node;
+        }
+    }
+
+    const size_t count = workers.size();
+    const size_t first = static_cast<size_t>(xorshift(self.rng) % count);
+    for (size_t i = 0; i < count; i++) {
+        Worker& victim = *workers[(first + i) % count];
+        if (&victim == &self) continue;
+        // Un robo fallido por disputa se reintenta mientras la víctima tenga tareas
+        while (victim.deque.size() > 0) {
+            if (victim.deque.steal(node)) {
+                self.steals.fetch_add(1, std::memory_order_relaxed);
+                return node;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Ejecuta una tarea; al terminar la última pendiente avisa a waitIdle().
+ */
+void TaskScheduler::execute(Worker& self, TaskNode* node) {
+    const int64_t start = steadyNowNs();
+    node->fn();
+    delete node;
+    self.busyNs.fetch_add(steadyNowNs() - start, std::memory_order_relaxed);
+    self.tasks.fetch_add(1, std::memory_order_relaxed);
+    if (pendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        idle.notifyAll();
+    }
+}
+
+/**
+ * @brief Bucle de un trabajador: ejecuta tareas mientras las haya y duerme si no.
+ *
+ * Tras registrarse en `work` vuelve a buscar: una tarea enviada después del registro
+ * despierta al trabajador, y una enviada antes la encuentra la segunda búsqueda.
+ */
+void TaskScheduler::run(int index) {
+    currentWorkerIndex = index;
+    currentScheduler = this;
+    applyWriterTuning(tuning);
+    Worker& self = *workers[index];
+
+    while (true) {
+        if (TaskNode* node = findTask(self)) {
+            execute(self, node);
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire)) break;
+
+        const EventCount::Key key = work.prepareWait();
+        if (TaskNode* node = findTask(self)) {
+            work.cancelWait();
+            execute(self, node);
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire)) {
+            work.cancelWait();
+            break;
+        }
+        work.wait(key);
+    }
+}
+
+/**
+ * @brief Espera a que terminen todas las tareas enviadas, incluidas sus continuaciones.
+ */
+void TaskScheduler::waitIdle() {
+    while (pendingTasks.load(std::memory_order_acquire) > 0) {
+        const EventCount::Key key = idle.prepareWait();
+        if (pendingTasks.load(std::memory_order_acquire) == 0) {
+            idle.cancelWait();
+            break;
+        }
+        idle.wait(key);
+    }
+}
+
+/**
+ * @brief Ejecuta las tareas pendientes y termina los trabajadores.
+ */
+void TaskScheduler::shutdown() {
+    if (workers.empty() || !workers.front()->thread.joinable()) return;
+    waitIdle();
+    stopping.store(true, std::memory_order_release);
+    work.notifyAll();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+/**
+ * @brief Contadores de cada trabajador.
+ */
+std::vector<TaskScheduler::WorkerStats> TaskScheduler::workerStats() const {
+    std::vector<WorkerStats> result;
+    for (const auto& worker : workers) {
+        WorkerStats stats;
+        stats.tasks = worker->tasks.load();
+        stats.steals = worker->steals.load();
+        stats.busyNs = worker->busyNs.load();
+        result.push_back(stats);
+    }
+    return result;
+}
+
+/**
+ * @brief Resumen del pool.
+ * @return Tareas ejecutadas, robos y ocupación media y por trabajador desde el arranque.
+ */
+std::string TaskScheduler::report() const {
+    const double uptime = std::max(1e-9, (steadyNowNs() - startNs) / 1e9);
+    uint64_t tasks = 0, steals = 0;
+    int64_t busy = 0;
+    std::ostringstream perWorker;
+    perWorker << std::fixed << std::setprecision(0);
+    for (const auto& stats : workerStats()) {
+        tasks += stats.tasks;
+        steals += stats.steals;
+        busy += stats.busyNs;
+        perWorker << (perWorker.tellp() > 0 ? "/" : "") << 100.0 * stats.busyNs / 1e9 / uptime;
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1)
+        << "Runtime de tareas: " << workers.size() << " trabajadores, " << tasks << " tareas, " << steals
+        << " robadas; ocupación media " << 100.0 * busy / 1e9 / uptime / std::max<size_t>(workers.size(), 1)
+        << "% (por trabajador " << perWorker.str() << "%)";
+    return oss.str();
+}
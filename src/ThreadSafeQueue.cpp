@@ -4,6 +4,8 @@
  */
 
 #include "ThreadSafeQueue.h"
+#include <sstream>
+#include <stdexcept>
 
 /**
  * @brief Constructor de la cola segura.
@@ -11,18 +13,114 @@
  */
 ThreadSafeQueue::ThreadSafeQueue(size_t max_size) : max_size(max_size) {}
 
+/**
+ * @brief Interpreta el nombre de una política de cola.
+ * @param name "drop-oldest", "drop-newest" o "block".
+ * @param policy Resultado.
+ * @return true si el nombre es válido.
+ */
+bool parseQueuePolicy(const std::string& name, QueuePolicy& policy) {
+    if (name == "drop-oldest") policy = QueuePolicy::DropOldest;
+    else if (name == "drop-newest") policy = QueuePolicy::DropNewest;
+    else if (name == "block") policy = QueuePolicy::Block;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Nombre de una política de cola.
+ * @param policy Política.
+ * @return Nombre usado en la línea de comandos y en el canal de control.
+ */
+const char* queuePolicyName(QueuePolicy policy) {
+    switch (policy) {
+        case QueuePolicy::DropNewest: return "drop-newest";
+        case QueuePolicy::Block: return "block";
+        case QueuePolicy::DropOldest:
+        default: return "drop-oldest";
+    }
+}
+
+/**
+ * @brief Interpreta el giro por etapa.
+ * @param spec "writers=US,generator=US", cualquiera de las dos, o "US" para los escritores.
+ * @param spin Resultado; las etapas no indicadas conservan su valor.
+ * @return true si el texto es válido.
+ */
+bool parseQueueSpin(const std::string& spec, QueueSpin& spin) {
+    QueueSpin parsed = spin;
+    std::istringstream items(spec);
+    std::string item;
+    bool any = false;
+    while (std::getline(items, item, ',')) {
+        const size_t eq = item.find('=');
+        const std::string stage = eq == std::string::npos ? "writers" : item.substr(0, eq);
+        const std::string value = eq == std::string::npos ? item : item.substr(eq + 1);
+        SpinPolicy* target = stage == "writers" ? &parsed.writers
+                           : stage == "generator" ? &parsed.generator : nullptr;
+        if (!target) return false;
+        try {
+            size_t used = 0;
+            const double us = std::stod(value, &used);
+            if (used != value.size() || us < 0) return false;
+            target->budgetNs = static_cast<int64_t>(us * 1000.0);
+        } catch (const std::exception&) {
+            return false;
+        }
+        any = true;
+    }
+    if (!any) return false;
+    spin = parsed;
+    return true;
+}
+
+/**
+ * @brief Descripción legible del giro de las etapas.
+ * @param spin Giro de escritores y generador.
+ * @return Texto para la configuración.
+ */
+std::string describeQueueSpin(const QueueSpin& spin) {
+    std::ostringstream oss;
+    auto stage = [&oss](const char* name, const SpinPolicy& policy) {
+        oss << name << " " << policy.budgetNs / 1000.0 << " µs" << (policy.adaptive ? " adaptativo" : "");
+    };
+    stage("escritores", spin.writers);
+    oss << ", ";
+    stage("generador", spin.generator);
+    return oss.str();
+}
+
 /**
  * @brief Inserta un elemento en la cola.
+ *
+ * La notificación se hace tras soltar el mutex y solo cuesta una syscall si algún
+ * consumidor duerme en el futex.
+ *
  * @param data Objeto ImageData a insertar.
  * @return true si se encoló el dato, false si la cola está llena o finalizada.
  */
 bool ThreadSafeQueue::push(const ImageData& data) {
     std::unique_lock<std::mutex> lock(mutex); // Protege el acceso concurrente a la cola
 
-    // Si la cola está llena y no se ha finalizado, elimina el primer dato de la cola
-    // para generar un espacio para este nuevo dato
+    // Con política de bloqueo, espera a que haya espacio o a que se finalice la cola.
+    // El registro en notFull se hace con el mutex tomado: cualquier cambio posterior
+    // se notifica después de soltarlo y verá a este productor esperando.
+    while (fullPolicy == QueuePolicy::Block && queue.size() >= max_size && !done) {
+        const EventCount::Key key = notFull.prepareWait();
+        lock.unlock();
+        notFull.wait(key);
+        lock.lock();
+    }
+
+    // Si la cola está llena y no se ha finalizado, descarta según la política
     if (queue.size() >= max_size && !done) {
+        droppedCount++;
+        if (fullPolicy == QueuePolicy::DropNewest) {
+            return false;
+        }
+        // Elimina el primer dato de la cola para generar un espacio para este nuevo dato
         queue.pop();
+        unfinished--;
     }
 
     // Si la cola ya fue finalizada no encola el dato
@@ -30,37 +128,125 @@ bool ThreadSafeQueue::push(const ImageData& data) {
 
     // Encola el dato
     queue.push(data);
+    unfinished++;
+    lock.unlock();
 
     // Notifica a un consumidor de que hay un nuevo elemento
-    cv.notify_one();
+    notEmpty.notifyOne();
 
     return true; // El dato fue encolado correctamente
 }
 
+/**
+ * @brief Extrae el elemento del frente de la cola; requiere tener el mutex.
+ * @param result Referencia donde se almacenará el elemento extraído.
+ * @return true si había un elemento.
+ */
+bool ThreadSafeQueue::tryPopLocked(ImageData& result) {
+    if (queue.empty()) return false;
+    result = queue.front();
+    queue.pop();
+    return true;
+}
+
 /**
  * @brief Extrae un elemento de la cola.
  * @param result Referencia donde se almacenará el elemento extraído.
  * @return true si se extrajo un elemento, false si la cola está vacía y finalizada.
  */
 bool ThreadSafeQueue::pop(ImageData& result) {
+    static const std::atomic<bool> never{false};
+    return pop(result, never);
+}
+
+/**
+ * @brief Extrae un elemento de la cola, abandonando la espera si se activa `cancel`.
+ * @param result Referencia donde se almacenará el elemento extraído.
+ * @param cancel Indicador de cancelación del consumidor.
+ * @return true si se extrajo un elemento, false si se canceló o la cola está vacía y finalizada.
+ */
+bool ThreadSafeQueue::pop(ImageData& result, const std::atomic<bool>& cancel) {
     std::unique_lock<std::mutex> lock(mutex); // Protege el acceso concurrente a la cola
 
-    // Espera hasta que haya un elemento en la cola o la cola esté finalizada
-    cv.wait(lock, [this] { return !queue.empty() || done; });
+    // Espera hasta que haya un elemento, la cola esté finalizada o se cancele la espera
+    while (queue.empty() && !done && !cancel) {
+        const EventCount::Key key = notEmpty.prepareWait();
+        lock.unlock();
+        notEmpty.wait(key);
+        lock.lock();
+    }
 
-    // Si la cola está vacía y finalizada, no hay más datos por consumir
-    if (queue.empty() && done) {
+    if (cancel || !tryPopLocked(result)) {
         return false;
     }
+    lock.unlock();
 
-    // Extrae el elemento del frente de la cola
-    result = queue.front();
-    queue.pop();
+    // Notifica a un posible productor bloqueado; sin productores esperando no hace syscall
+    notFull.notifyOne();
 
-    // Notifica a un posible productor que hay espacio disponible en la cola
-    cv_full.notify_one();
+    return true;
+}
 
-    return true; // Se extrajo un elemento correctamente
+/**
+ * @brief Marca como terminado un dato extraído con pop().
+ *
+ * Avisa a quien espera en waitIdle() cuando ya no queda nada pendiente.
+ */
+void ThreadSafeQueue::taskDone() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (unfinished > 0 && --unfinished == 0) {
+        idle.notify_all();
+    }
+}
+
+/**
+ * @brief Espera a que no quede ningún dato en la cola ni en proceso.
+ * @param timeout Espera máxima en tiempo real.
+ * @return true si todos los datos encolados están terminados.
+ */
+bool ThreadSafeQueue::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return idle.wait_for(lock, timeout, [this] { return unfinished == 0; });
+}
+
+/**
+ * @brief Despierta a todos los consumidores para que revisen su indicador de cancelación.
+ *
+ * Toma el mutex antes de notificar para que un consumidor que acaba de evaluar su
+ * condición quede registrado en notEmpty y no pierda la notificación.
+ */
+void ThreadSafeQueue::wakeAll() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+    }
+    notEmpty.notifyAll();
+}
+
+/**
+ * @brief Cambia la política aplicada cuando la cola está llena.
+ * @param policy Nueva política.
+ */
+void ThreadSafeQueue::setPolicy(QueuePolicy policy) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        fullPolicy = policy;
+    }
+    // Un productor bloqueado debe reevaluar su espera con la nueva política
+    notFull.notifyAll();
+}
+
+/**
+ * @brief Política actual de la cola.
+ */
+QueuePolicy ThreadSafeQueue::policy() const {
+    return fullPolicy.load();
+}
+
+/**
+ * @brief Número de elementos descartados por la política de cola llena.
+ */
+size_t ThreadSafeQueue::dropped() const {
+    return droppedCount.load();
 }
 
 /**
@@ -72,7 +258,8 @@ void ThreadSafeQueue::finish() {
         std::unique_lock<std::mutex> lock(mutex); // Protege el acceso concurrente
         done = true; // Marca la cola como finalizada
     }
-    cv.notify_all(); // Despierta a todos los consumidores que puedan estar esperando
+    notEmpty.notifyAll(); // Despierta a todos los consumidores que puedan estar esperando
+    notFull.notifyAll(); // Y a un productor bloqueado por la política de bloqueo
 }
 
 /**
@@ -83,6 +270,14 @@ bool ThreadSafeQueue::isDone() const {
     return done;
 }
 
+/**
+ * @brief Obtiene la capacidad máxima de la cola.
+ * @return Número máximo de elementos que admite la cola.
+ */
+size_t ThreadSafeQueue::capacity() const {
+    return max_size;
+}
+
 /**
  * @brief Obtiene el tamaño actual de la cola.
  * @return Número de elementos en la cola.
@@ -91,3 +286,36 @@ size_t ThreadSafeQueue::size() {
     std::unique_lock<std::mutex> lock(mutex); // Protege el acceso concurrente
     return queue.size();
 }
+
+/**
+ * @brief Contadores de espera de la cola.
+ * @return Suma de los contadores de consumidores (notEmpty) y productores (notFull).
+ */
+EventCountStats ThreadSafeQueue::waitStats() const {
+    EventCountStats total = notEmpty.stats();
+    total += notFull.stats();
+    return total;
+}
+
+/**
+ * @brief Contadores de espera de los consumidores.
+ */
+EventCountStats ThreadSafeQueue::consumerWaitStats() const {
+    return notEmpty.stats();
+}
+
+/**
+ * @brief Contadores de espera del productor.
+ */
+EventCountStats ThreadSafeQueue::producerWaitStats() const {
+    return notFull.stats();
+}
+
+/**
+ * @brief Giro antes de dormir de consumidores y productor.
+ * @param spin Giro de cada etapa; se aplica desde la siguiente espera.
+ */
+void ThreadSafeQueue::setSpin(const QueueSpin& spin) {
+    notEmpty.setSpin(spin.writers);
+    notFull.setSpin(spin.generator);
+}
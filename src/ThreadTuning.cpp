@@ -0,0 +1,229 @@
+/**
+ * @file ThreadTuning.cpp
+ * @brief Políticas de planificación, nice, prioridad de E/S y bloqueo de memoria por hilo.
+ */
+
+#include "ThreadTuning.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+// Constantes de ioprio_set (linux/ioprio.h no siempre está disponible)
+constexpr int kIoprioClassShift = 13;
+constexpr int kIoprioWhoProcess = 1;
+
+/**
+ * @brief Identificador del hilo actual para las llamadas por hilo (setpriority, ioprio_set).
+ */
+pid_t currentThreadId() {
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+
+/**
+ * @brief Nombre de una clase de E/S.
+ */
+const char* ioClassName(int ioClass) {
+    switch (ioClass) {
+        case 1: return "rt";
+        case 2: return "be";
+        case 3: return "idle";
+        default: return "sin cambio";
+    }
+}
+}
+
+/**
+ * @brief Interpreta una política de tiempo real ("fifo:N" o "rr:N").
+ * @param spec Texto a interpretar.
+ * @param tuning Opciones donde se guarda el resultado.
+ * @return true si el texto es válido.
+ */
+bool parseRealtimeSpec(const std::string& spec, ThreadTuning& tuning) {
+    const size_t colon = spec.find(':');
+    const std::string policy = spec.substr(0, colon);
+    int priority = 50;
+    if (colon != std::string::npos) {
+        try { priority = std::stoi(spec.substr(colon + 1)); } catch (const std::exception&) { return false; }
+    }
+
+    if (policy == "fifo") tuning.realtimePolicy = SCHED_FIFO;
+    else if (policy == "rr") tuning.realtimePolicy = SCHED_RR;
+    else return false;
+
+    if (priority < sched_get_priority_min(tuning.realtimePolicy) ||
+        priority > sched_get_priority_max(tuning.realtimePolicy)) {
+        return false;
+    }
+    tuning.realtimePriority = priority;
+    return true;
+}
+
+/**
+ * @brief Interpreta una clase de prioridad de E/S ("rt:N", "be:N" o "idle").
+ * @param spec Texto a interpretar.
+ * @param tuning Opciones donde se guarda el resultado.
+ * @return true si el texto es válido.
+ */
+bool parseIoPrioritySpec(const std::string& spec, ThreadTuning& tuning) {
+    const size_t colon = spec.find(':');
+    const std::string ioClass = spec.substr(0, colon);
+    int level = 4;
+    if (colon != std::string::npos) {
+        try { level = std::stoi(spec.substr(colon + 1)); } catch (const std::exception&) { return false; }
+    }
+
+    if (ioClass == "rt") tuning.ioClass = 1;
+    else if (ioClass == "be") tuning.ioClass = 2;
+    else if (ioClass == "idle") { tuning.ioClass = 3; level = 0; }
+    else return false;
+
+    if (level < 0 || level > 7) return false;
+    tuning.ioLevel = level;
+    return true;
+}
+
+/**
+ * @brief Aplica al hilo actual la política de tiempo real del generador.
+ * @param tuning Opciones de planificación.
+ * @return true si se aplicó o no había nada que aplicar.
+ */
+bool applyGeneratorTuning(const ThreadTuning& tuning) {
+    if (tuning.realtimePolicy == 0) return true;
+
+    sched_param param{};
+    param.sched_priority = tuning.realtimePriority;
+    const int result = pthread_setschedparam(pthread_self(), tuning.realtimePolicy, &param);
+    if (result != 0) {
+        std::cerr << "Aviso: no se pudo aplicar la prioridad de tiempo real al generador: "
+                  << std::strerror(result) << " (requiere CAP_SYS_NICE)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Aplica al hilo actual SCHED_BATCH, nice y la clase de E/S de los escritores.
+ * @param tuning Opciones de planificación.
+ * @return true si todo se aplicó o no había nada que aplicar.
+ */
+bool applyWriterTuning(const ThreadTuning& tuning) {
+    bool ok = true;
+
+    if (tuning.writerBatch) {
+        sched_param param{};
+        const int result = pthread_setschedparam(pthread_self(), SCHED_BATCH, &param);
+        if (result != 0) {
+            std::cerr << "Aviso: no se pudo aplicar SCHED_BATCH: " << std::strerror(result) << std::endl;
+            ok = false;
+        }
+    }
+
+    // En Linux, setpriority sobre un TID afecta solo a ese hilo
+    if (tuning.writerNice != 0 && setpriority(PRIO_PROCESS, currentThreadId(), tuning.writerNice) != 0) {
+        std::cerr << "Aviso: no se pudo aplicar nice " << tuning.writerNice << ": " << std::strerror(errno) << std::endl;
+        ok = false;
+    }
+
+    if (tuning.ioClass != 0) {
+        const int value = (tuning.ioClass << kIoprioClassShift) | tuning.ioLevel;
+        if (syscall(SYS_ioprio_set, kIoprioWhoProcess, currentThreadId(), value) != 0) {
+            std::cerr << "Aviso: no se pudo aplicar la prioridad de E/S " << ioClassName(tuning.ioClass)
+                      << ": " << std::strerror(errno) << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Núcleos de la máscara de afinidad del proceso.
+ * @return Número de CPU permitidas (al menos 1).
+ */
+int availableCores() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return 1;
+    return std::max(1, CPU_COUNT(&allowed));
+}
+
+/**
+ * @brief Fija el hilo actual al núcleo `index` de la máscara de afinidad del proceso.
+ *
+ * Se usa la máscara del proceso (no la numeración absoluta) para respetar taskset y
+ * cgroups; con más hilos que núcleos se reparten en orden.
+ *
+ * @param index Índice del núcleo dentro de la máscara.
+ * @return true si se fijó la afinidad.
+ */
+bool pinCurrentThread(int index) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+    const int count = CPU_COUNT(&allowed);
+    if (count == 0) return false;
+
+    int remaining = index % count;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        if (remaining-- > 0) continue;
+        cpu_set_t target;
+        CPU_ZERO(&target);
+        CPU_SET(cpu, &target);
+        const int result = pthread_setaffinity_np(pthread_self(), sizeof(target), &target);
+        if (result != 0) {
+            std::cerr << "Aviso: no se pudo fijar el hilo al núcleo " << cpu << ": " << std::strerror(result) << std::endl;
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Bloquea en RAM la memoria actual y futura del proceso.
+ *
+ * Con MCL_FUTURE también quedan bloqueados el banco de fotogramas y los buffers que
+ * se reserven después, evitando fallos de página en el camino crítico.
+ *
+ * @param tuning Opciones de planificación.
+ * @return true si se aplicó o no había nada que aplicar.
+ */
+bool applyMemoryLock(const ThreadTuning& tuning) {
+    if (!tuning.lockMemory) return true;
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        std::cerr << "Aviso: mlockall falló: " << std::strerror(errno)
+                  << " (revise RLIMIT_MEMLOCK o CAP_IPC_LOCK)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Descripción legible de las opciones configuradas.
+ * @param tuning Opciones de planificación.
+ * @return Texto para la configuración mostrada al inicio.
+ */
+std::string describeThreadTuning(const ThreadTuning& tuning) {
+    std::ostringstream oss;
+    oss << "generador ";
+    if (tuning.realtimePolicy == SCHED_FIFO) oss << "SCHED_FIFO:" << tuning.realtimePriority;
+    else if (tuning.realtimePolicy == SCHED_RR) oss << "SCHED_RR:" << tuning.realtimePriority;
+    else oss << "normal";
+
+    oss << ", escritores ";
+    if (tuning.writerBatch) oss << "SCHED_BATCH ";
+    oss << "nice " << tuning.writerNice << " E/S " << ioClassName(tuning.ioClass);
+    if (tuning.ioClass == 1 || tuning.ioClass == 2) oss << ":" << tuning.ioLevel;
+
+    if (tuning.lockMemory) oss << ", memoria bloqueada";
+    return oss.str();
+}
@@ -0,0 +1,396 @@
+/**
+ * @file TieredStorage.cpp
+ * @brief Almacenamiento en dos niveles con migración en segundo plano al volumen masivo.
+ */
+
+#include "TieredStorage.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+/// Tamaño de bloque de la copia de respaldo cuando no hay copy_file_range.
+constexpr size_t kCopyChunk = 1 << 20;
+/// Espera antes del primer reintento de una migración fallida.
+constexpr std::chrono::milliseconds kRetryBaseDelay{100};
+/// Espera máxima entre reintentos de migración.
+constexpr std::chrono::milliseconds kRetryMaxDelay{5000};
+/// Fallos seguidos, una vez pedida la parada, tras los que se deja de migrar.
+constexpr int kDrainAttempts = 3;
+
+/**
+ * @brief Copia `size` bytes entre descriptores con read/write en bloques grandes.
+ */
+bool copyWithBuffer(int in, int out, size_t size) {
+    std::vector<char> chunk(kCopyChunk);
+    size_t remaining = size;
+    while (remaining > 0) {
+        const ssize_t got = read(in, chunk.data(), std::min(remaining, chunk.size()));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        for (ssize_t done = 0; done < got;) {
+            const ssize_t put = ::write(out, chunk.data() + done, got - done);
+            if (put < 0 && errno == EINTR) continue;
+            if (put <= 0) return false;
+            done += put;
+        }
+        remaining -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+/**
+ * @brief Copia un archivo completo, en el núcleo si es posible.
+ *
+ * `copy_file_range` evita pasar los datos por espacio de usuario y permite al sistema
+ * de archivos hacer copias grandes (o reflinks). Si no está disponible entre estos
+ * volúmenes se recurre a read/write con bloques de 1 MiB.
+ */
+bool copyFile(const std::string& source, const std::string& target) {
+    const int in = open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return false;
+    struct stat info;
+    if (fstat(in, &info) != 0) {
+        close(in);
+        return false;
+    }
+    const int out = open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        close(in);
+        return false;
+    }
+
+    size_t remaining = static_cast<size_t>(info.st_size);
+    bool ok = true;
+    while (remaining > 0) {
+        const ssize_t copied = copy_file_range(in, nullptr, out, nullptr, remaining, 0);
+        if (copied > 0) {
+            remaining -= static_cast<size_t>(copied);
+            continue;
+        }
+        if (copied < 0 && errno == EINTR) continue;
+        // Sin soporte entre estos volúmenes: continuar con la copia en espacio de usuario
+        const bool unsupported = copied < 0 &&
+            (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP);
+        ok = unsupported && copyWithBuffer(in, out, remaining);
+        break;
+    }
+
+    close(in);
+    // Sincronizar antes de publicar la copia: el original se borra justo después
+    if (ok && fsync(out) != 0) ok = false;
+    return close(out) == 0 && ok;
+}
+
+/**
+ * @brief Sincroniza un directorio para que sus entradas nuevas sobrevivan a un corte.
+ */
+bool syncDirectory(const std::string& directory) {
+    const int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return false;
+    const bool synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+}
+} // namespace
+
+/**
+ * @brief Crea el almacenamiento en dos niveles e inicia el migrador.
+ * @param landingDirectory Directorio del nivel rápido.
+ * @param bulkDirectory Directorio del nivel masivo.
+ * @param watermark Bytes máximos pendientes en el aterrizaje (0 = sin límite).
+ */
+TieredStorage::TieredStorage(const std::string& landingDirectory, const std::string& bulkDirectory,
+                             size_t watermark)
+    : landingDirectory(landingDirectory), bulkDirectory(bulkDirectory), watermark(watermark) {
+    adoptLeftovers();
+    migrator = std::thread(&TieredStorage::migrateLoop, this);
+}
+
+/**
+ * @brief Vacía el aterrizaje y detiene el migrador.
+ */
+TieredStorage::~TieredStorage() {
+    drain();
+}
+
+/**
+ * @brief Encola los archivos que una ejecución anterior dejó sin migrar.
+ */
+void TieredStorage::adoptLeftovers() {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(landingDirectory, error)) {
+        if (!entry.is_regular_file(error)) continue;
+        const std::string file = entry.path().filename().string();
+        if (file.size() > 4 && file.compare(file.size() - 4, 4, ".tmp") == 0) continue;
+        Pending item;
+        item.name = entry.path().filename().string();
+        item.bulkDirectory = bulkDirectory;
+        item.size = static_cast<size_t>(entry.file_size(error));
+        item.landed = std::chrono::steady_clock::now();
+        pendingBytes += item.size;
+        pending.push_back(item);
+    }
+    if (!pending.empty()) {
+        std::cout << "Aterrizaje: " << pending.size() << " archivos de una ejecución anterior pendientes de migrar" << std::endl;
+    }
+}
+
+/**
+ * @brief Escribe el fotograma en el aterrizaje y lo encola para migrar.
+ *
+ * Espera si el aterrizaje está por encima de la marca de agua; un archivo mayor que
+ * la marca se admite cuando el aterrizaje está vacío.
+ *
+ * @param name Nombre del archivo.
+ * @param data Contenido codificado.
+ * @return true si se escribió completo en el aterrizaje.
+ */
+bool TieredStorage::write(const std::string& name, const std::vector<unsigned char>& data) {
+    std::string bulk;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto hasRoom = [&] {
+            return watermark == 0 || stopping || pendingBytes.load() == 0 ||
+                   pendingBytes.load() + data.size() <= watermark;
+        };
+        if (!hasRoom()) {
+            watermarkWaits++;
+            spaceAvailable.wait(lock, hasRoom);
+        }
+        // Reservar el espacio antes de escribir para que otros escritores lo vean
+        const size_t landed = pendingBytes += data.size();
+        size_t peak = peakLandingBytes.load();
+        while (landed > peak && !peakLandingBytes.compare_exchange_weak(peak, landed)) {
+        }
+        bulk = bulkDirectory;
+    }
+
+    // Temporal + rename: el migrador y la recuperación nunca ven archivos a medias
+    const std::string path = landingDirectory + "/" + name;
+    const std::string partial = path + ".tmp";
+    errno = 0;
+    std::ofstream out(partial, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    out.close();
+    if (!out || std::rename(partial.c_str(), path.c_str()) != 0) {
+        setStorageError(errno != 0 ? errno : EIO);
+        std::remove(partial.c_str());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingBytes -= data.size();
+        }
+        spaceAvailable.notify_all();
+        return false;
+    }
+
+    Pending item;
+    item.name = name;
+    item.bulkDirectory = bulk;
+    item.size = data.size();
+    item.landed = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(item));
+    }
+    workAvailable.notify_one();
+    return true;
+}
+
+/**
+ * @brief Mueve un archivo al volumen masivo: renombra si comparten sistema de archivos
+ * y, si no, copia a un temporal, lo renombra y borra el original.
+ *
+ * En la copia entre volúmenes el original solo se borra cuando la copia y la entrada
+ * del directorio masivo están sincronizadas; un corte nunca deja el fotograma sin
+ * ninguna copia completa.
+ *
+ * @param item Archivo a mover.
+ * @return true si el archivo quedó completo en el destino.
+ */
+bool TieredStorage::migrate(const Pending& item) {
+    const std::string source = landingDirectory + "/" + item.name;
+    const std::string target = item.bulkDirectory + "/" + item.name;
+
+    if (std::rename(source.c_str(), target.c_str()) == 0) return true;
+    if (errno != EXDEV) return false;
+
+    // El temporal evita que un lector vea un archivo a medio copiar en el destino
+    const std::string partial = target + ".part";
+    if (!copyFile(source, partial) || std::rename(partial.c_str(), target.c_str()) != 0) {
+        const int error = errno;
+        std::remove(partial.c_str());
+        errno = error;
+        return false;
+    }
+    if (!syncDirectory(item.bulkDirectory)) return false;
+    std::remove(source.c_str());
+    return true;
+}
+
+/**
+ * @brief Migra archivos en orden de llegada hasta que se pida parar y la cola quede vacía.
+ *
+ * Un archivo que no se puede migrar vuelve al final de la cola y conserva su reserva en
+ * el aterrizaje, donde sigue ocupando espacio. Tras cada fallo el migrador espera el
+ * doble que en el anterior (hasta `kRetryMaxDelay`), así que un volumen masivo caído
+ * no se reintenta en bucle. Pedida la parada, tras `kDrainAttempts` fallos seguidos los
+ * archivos que faltan se quedan en el aterrizaje para la próxima ejecución.
+ */
+void TieredStorage::migrateLoop() {
+    int consecutiveFailures = 0;
+    while (true) {
+        Pending item;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) return;
+            item = std::move(pending.front());
+            pending.pop_front();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool moved = migrate(item);
+        const int migrateError = errno;
+        const auto end = std::chrono::steady_clock::now();
+        busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        if (moved) {
+            consecutiveFailures = 0;
+            migratedFiles++;
+            migratedBytes += item.size;
+            const int64_t lag = std::chrono::duration_cast<std::chrono::nanoseconds>(end - item.landed).count();
+            totalLagNs += lag;
+            int64_t peak = maxLagNs.load();
+            while (lag > peak && !maxLagNs.compare_exchange_weak(peak, lag)) {
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pendingBytes -= item.size;
+            }
+            spaceAvailable.notify_all();
+            continue;
+        }
+
+        item.attempts++;
+        consecutiveFailures++;
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping && consecutiveFailures >= kDrainAttempts) {
+            failedFiles += pending.size() + 1;
+            pending.clear();
+            std::cerr << "Error al migrar " << item.name << " a " << item.bulkDirectory
+                      << ": " << std::strerror(migrateError) << "; se deja de migrar" << std::endl;
+            return;
+        }
+        migrateRetries++;
+        if (item.attempts == 1) {
+            std::cerr << "Aviso: no se pudo migrar " << item.name << " a " << item.bulkDirectory
+                      << " (" << std::strerror(migrateError) << "); se reintentará" << std::endl;
+        }
+        pending.push_back(std::move(item));
+
+        const auto delay = std::min<std::chrono::milliseconds>(
+            kRetryMaxDelay, kRetryBaseDelay * (1 << std::min(consecutiveFailures - 1, 10)));
+        // La petición de parada interrumpe la espera una vez; durante el vaciado se espera completa
+        const bool wasStopping = stopping;
+        workAvailable.wait_for(lock, delay, [&] { return stopping != wasStopping; });
+    }
+}
+
+/**
+ * @brief Espera a que se migre todo lo aterrizado y detiene el migrador.
+ */
+void TieredStorage::drain() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    spaceAvailable.notify_all();
+    if (migrator.joinable()) {
+        migrator.join();
+        if (failedFiles.load() > 0) {
+            std::cerr << "Aviso: " << failedFiles.load() << " archivos (" << formatByteSize(pendingBytes.load())
+                      << ") quedan en el aterrizaje sin migrar; se migrarán en la próxima ejecución" << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Cambia el directorio masivo de las siguientes escrituras.
+ * @param directory Nuevo directorio (debe existir).
+ * @return Siempre true.
+ */
+bool TieredStorage::setDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bulkDirectory = directory;
+    return true;
+}
+
+/**
+ * @brief Revisa ambos niveles; los temporales del aterrizaje se descartan.
+ */
+bool TieredStorage::recover(uint64_t& nextSequence) {
+    std::string bulk;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bulk = bulkDirectory;
+    }
+    const bool landed = recoverFrameDirectory(landingDirectory, nextSequence);
+    const bool migrated = recoverFrameDirectory(bulk, nextSequence);
+    return landed || migrated;
+}
+
+/**
+ * @brief Descripción de ambos niveles.
+ */
+std::vector<VolumeUsage> TieredStorage::volumeUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return {{landingDirectory, migratedBytes.load() + pendingBytes.load()}, {bulkDirectory, migratedBytes.load()}};
+}
+
+std::string TieredStorage::describe() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string text = landingDirectory + " -> " + bulkDirectory;
+    if (watermark > 0) {
+        text += " (marca de agua " + formatByteSize(watermark) + ")";
+    }
+    return text;
+}
+
+/**
+ * @brief Informe de la migración para los resultados finales.
+ */
+std::string TieredStorage::report() const {
+    const size_t files = migratedFiles.load();
+    const size_t bytes = migratedBytes.load();
+    const double busySeconds = busyNs.load() / 1e9;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "Migrados al volumen masivo: " << files << " archivos, " << formatByteSize(bytes);
+    if (failedFiles.load() > 0) {
+        oss << " (" << failedFiles.load() << " sin migrar, " << formatByteSize(pendingBytes.load())
+            << " en el aterrizaje)";
+    }
+    if (migrateRetries.load() > 0) oss << ", " << migrateRetries.load() << " reintentos";
+    oss << "\nRetraso de migración: medio "
+        << (files > 0 ? totalLagNs.load() / 1e6 / files : 0.0) << " ms, máximo "
+        << maxLagNs.load() / 1e6 << " ms";
+    oss << "\nThroughput del migrador: "
+        << formatByteSize(static_cast<size_t>(busySeconds > 0 ? bytes / busySeconds : 0.0)) << "/s"
+        << " (ocupado " << busySeconds << " s)";
+    oss << "\nPico del aterrizaje: " << formatByteSize(peakLandingBytes.load())
+        << ", esperas por marca de agua: " << watermarkWaits.load();
+    return oss.str();
+}
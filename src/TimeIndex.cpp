@@ -0,0 +1,187 @@
+/**
+ * @file TimeIndex.cpp
+ * @brief Índice temporal disperso de las grabaciones en segmentos.
+ */
+
+#include "TimeIndex.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+bool writeAll(int fd, const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool validHeader(const TimeIndexHeader& header) {
+    return header.magic == kTimeIndexMagic && header.version == 1 && header.entrySize == sizeof(TimeIndexEntry);
+}
+} // namespace
+
+TimeIndexWriter::~TimeIndexWriter() {
+    close();
+}
+
+/**
+ * @brief Abre el índice, creando la cabecera si el archivo es nuevo.
+ */
+bool TimeIndexWriter::open(const std::string& path, int64_t interval, int64_t slackNs) {
+    close();
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    intervalNs = interval;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close();
+        return false;
+    }
+    if (static_cast<size_t>(status.st_size) < sizeof(TimeIndexHeader)) {
+        TimeIndexHeader header{kTimeIndexMagic, 1, sizeof(TimeIndexEntry), 0, interval, slackNs};
+        if (ftruncate(fd, 0) != 0 || !writeAll(fd, &header, sizeof(header))) {
+            close();
+            return false;
+        }
+        count = 0;
+        return true;
+    }
+
+    TimeIndexHeader header;
+    if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) || !validHeader(header)) {
+        close();
+        return false;
+    }
+    // Una entrada a medias es la cola de un corte
+    count = (static_cast<size_t>(status.st_size) - sizeof(header)) / sizeof(TimeIndexEntry);
+    const off_t end = static_cast<off_t>(sizeof(header) + count * sizeof(TimeIndexEntry));
+    if (ftruncate(fd, end) != 0 || lseek(fd, end, SEEK_SET) < 0) {
+        close();
+        return false;
+    }
+    if (count > 0) {
+        TimeIndexEntry last;
+        if (pread(fd, &last, sizeof(last), end - static_cast<off_t>(sizeof(last))) == static_cast<ssize_t>(sizeof(last))) {
+            upTo = last.upToTs;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Recorta las entradas finales cuyos bloques no están completos en los segmentos.
+ */
+bool TimeIndexWriter::trim(const std::function<uint64_t(uint64_t)>& segmentLength,
+                           uint64_t& segment, uint64_t& offset) {
+    if (fd < 0) return false;
+    blockOpen = false;
+    upTo = INT64_MIN;
+    TimeIndexEntry last{};
+    while (count > 0) {
+        const off_t position = static_cast<off_t>(sizeof(TimeIndexHeader) + (count - 1) * sizeof(TimeIndexEntry));
+        if (pread(fd, &last, sizeof(last), position) == static_cast<ssize_t>(sizeof(last)) &&
+            last.offset + last.length <= segmentLength(last.segment)) {
+            break;
+        }
+        count--;
+    }
+    const off_t end = static_cast<off_t>(sizeof(TimeIndexHeader) + count * sizeof(TimeIndexEntry));
+    if (ftruncate(fd, end) != 0 || lseek(fd, end, SEEK_SET) < 0 || count == 0) return false;
+    upTo = last.upToTs;
+    segment = last.segment;
+    offset = last.offset + last.length;
+    return true;
+}
+
+/**
+ * @brief Incorpora un registro al bloque abierto.
+ */
+bool TimeIndexWriter::add(uint64_t segment, uint64_t offset, uint64_t size, int64_t timestampNs) {
+    if (fd < 0) return false;
+    bool ok = true;
+    if (blockOpen) {
+        const bool contiguous = segment == block.segment && offset == block.offset + block.length;
+        const int64_t span = std::max(block.maxTs, timestampNs) - std::min(block.minTs, timestampNs);
+        if (!contiguous || span >= intervalNs) {
+            ok = flush();
+        }
+    }
+    if (!blockOpen) {
+        block = TimeIndexEntry{segment, offset, 0, timestampNs, timestampNs, 0};
+        blockOpen = true;
+    }
+    block.length += size;
+    block.minTs = std::min(block.minTs, timestampNs);
+    block.maxTs = std::max(block.maxTs, timestampNs);
+    return ok;
+}
+
+bool TimeIndexWriter::flush() {
+    if (!blockOpen) return true;
+    blockOpen = false;
+    upTo = std::max(upTo, block.maxTs);
+    block.upToTs = upTo;
+    return append(block);
+}
+
+bool TimeIndexWriter::append(const TimeIndexEntry& entry) {
+    if (!writeAll(fd, &entry, sizeof(entry))) return false;
+    count++;
+    return true;
+}
+
+bool TimeIndexWriter::sync() {
+    return fd < 0 || fdatasync(fd) == 0;
+}
+
+void TimeIndexWriter::close() {
+    if (fd < 0) return;
+    flush();
+    ::close(fd);
+    fd = -1;
+}
+
+TimeIndexReader::~TimeIndexReader() {
+    if (mapping) munmap(mapping, mappingSize);
+}
+
+/**
+ * @brief Proyecta el archivo; las entradas añadidas después no se ven.
+ */
+bool TimeIndexReader::open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(TimeIndexHeader)) {
+        ::close(fd);
+        return false;
+    }
+    mappingSize = static_cast<size_t>(status.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        return false;
+    }
+    header = static_cast<const TimeIndexHeader*>(mapping);
+    if (!validHeader(*header)) return false;
+    entries = reinterpret_cast<const TimeIndexEntry*>(static_cast<const char*>(mapping) + sizeof(TimeIndexHeader));
+    count = (mappingSize - sizeof(TimeIndexHeader)) / sizeof(TimeIndexEntry);
+    return true;
+}
+
+size_t TimeIndexReader::lowerBound(int64_t timestampNs) const {
+    const TimeIndexEntry* found = std::lower_bound(entries, entries + count, timestampNs,
+        [](const TimeIndexEntry& entry, int64_t value) { return entry.upToTs < value; });
+    return static_cast<size_t>(found - entries);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file TimeSeries.cpp
+ * @brief Registro periódico de los contadores del pipeline en un CSV.
+ */
+
+#include "TimeSeries.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+/// Con reloj virtual el tiempo salta: se consulta a menudo en tiempo real.
+constexpr auto kVirtualPoll = std::chrono::milliseconds(1);
+} // namespace
+
+TimeSeriesRecorder::TimeSeriesRecorder(const std::string& path, double intervalSeconds,
+                                       const PipelineStats& stats, FrameSink& sink, Clock& clock)
+    : path(path),
+      interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(intervalSeconds))),
+      stats(stats), sink(sink), clock(clock) {}
+
+TimeSeriesRecorder::~TimeSeriesRecorder() {
+    stop();
+}
+
+bool TimeSeriesRecorder::start() {
+    out.open(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: No se pudo abrir la serie temporal " << path << std::endl;
+        return false;
+    }
+    out << "t_s,generadas,encoladas,descartadas,guardadas,bytes,cola,"
+           "p99_codificacion_us,p99_escritura_us,fps_por_escritor\n";
+    out.flush();
+    origin = clock.now();
+    previous = capture(origin);
+    sampler = std::thread(&TimeSeriesRecorder::run, this);
+    return true;
+}
+
+void TimeSeriesRecorder::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) return;
+        stopping = true;
+    }
+    wake.notify_all();
+    if (sampler.joinable()) {
+        sampler.join();
+        // Intervalo parcial hasta el final (vaciado de la cola incluido), si hubo actividad
+        const Snapshot last = capture(clock.now());
+        if (last.generated != previous.generated || last.saved != previous.saved ||
+            last.dropped != previous.dropped) {
+            writeRow(last);
+        }
+    }
+}
+
+std::string TimeSeriesRecorder::describe() const {
+    std::ostringstream oss;
+    oss << path << " cada " << std::chrono::duration<double>(interval).count() << " s";
+    return oss.str();
+}
+
+/**
+ * @brief Escribe una fila al cumplirse cada intervalo del reloj hasta stop().
+ */
+void TimeSeriesRecorder::run() {
+    Clock::time_point next = origin + interval;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        // El reloj real coincide con steady_clock; el virtual no se puede esperar sin adelantarlo
+        if (clock.isVirtual()) {
+            wake.wait_for(lock, kVirtualPoll);
+        } else {
+            wake.wait_until(lock, next);
+        }
+        if (stopping) break;
+        const Clock::time_point now = clock.now();
+        if (now < next) continue;
+        lock.unlock();
+        writeRow(capture(now));
+        lock.lock();
+        // Con reloj virtual pueden haber pasado varios intervalos: una sola fila los cubre
+        while (next <= now) next += interval;
+    }
+}
+
+TimeSeriesRecorder::Snapshot TimeSeriesRecorder::capture(Clock::time_point now) const {
+    Snapshot snapshot;
+    snapshot.time = now;
+    snapshot.generated = stats.imagesGenerated.load();
+    snapshot.enqueued = stats.imagesEnqueued.load();
+    snapshot.dropped = sink.dropped();
+    snapshot.saved = stats.imagesSaved.load();
+    snapshot.bytes = stats.bytesWritten.load();
+    snapshot.encode = stats.encodeLatency.counts();
+    snapshot.write = stats.writeLatency.counts();
+    for (int writer = 0; writer < kMaxWriterStats; writer++) {
+        snapshot.byWriter[writer] = stats.savedByWriter[writer].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Escribe las diferencias respecto a la fila anterior y la toma como referencia.
+ */
+void TimeSeriesRecorder::writeRow(const Snapshot& current) {
+    const double seconds = std::chrono::duration<double>(current.time - previous.time).count();
+    out << std::fixed << std::setprecision(3)
+        << std::chrono::duration<double>(current.time - origin).count() << ","
+        << current.generated - previous.generated << ","
+        << current.enqueued - previous.enqueued << ","
+        << current.dropped - previous.dropped << ","
+        << current.saved - previous.saved << ","
+        << current.bytes - previous.bytes << ","
+        << sink.size() << ","
+        << std::setprecision(0)
+        << LatencyHistogram::percentileUs(LatencyHistogram::difference(current.encode, previous.encode), 0.99) << ","
+        << LatencyHistogram::percentileUs(LatencyHistogram::difference(current.write, previous.write), 0.99) << ",";
+    bool first = true;
+    out << std::setprecision(1);
+    for (int writer = 1; writer < kMaxWriterStats; writer++) {
+        if (current.byWriter[writer] == 0) continue;
+        out << (first ? "" : ";") << writer << ":"
+            << (seconds > 0.0 ? (current.byWriter[writer] - previous.byWriter[writer]) / seconds : 0.0);
+        first = false;
+    }
+    out << "\n";
+    out.flush();
+    previous = current;
+    rowCount++;
+}
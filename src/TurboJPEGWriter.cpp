@@ -5,10 +5,13 @@
 
 #include "TurboJPEGWriter.h"
 #include <turbojpeg.h>
-#include <opencv2/opencv.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
+#ifdef FASTCAP_HAVE_OPENCV
+#include <opencv2/opencv.hpp>
+
 /**
  * @brief Comprime y guarda una imagen OpenCV en formato JPEG usando TurboJPEG.
  * 
@@ -106,3 +109,210 @@ bool writeJPEG_turbo(const cv::Mat& image, const std::string& filename, int qual
     tjDestroy(compressor);
     return true;
 }
+#endif
+
+/**
+ * @brief Crea el codificador e inicializa el manejador TurboJPEG.
+ * @param quality Calidad JPEG entre 0 y 100.
+ * @param kernels Núcleos del formato de los fotogramas (nullptr = BGR de 8 bits).
+ * @param options Submuestreo, DCT y codificación JPEG.
+ */
+TurboJPEGEncoder::TurboJPEGEncoder(int quality, const PixelKernels* kernels, const JpegOptions& options)
+    : quality(quality), kernels(kernels ? *kernels : *selectPixelKernels(PixelFormat::Bgr8, 0, 0)) {
+    // Una entrada de un canal no admite submuestreo cromático
+    subsampling = (options.subsampling < 0 || this->kernels.tjSubsampling == TJSAMP_GRAY)
+        ? this->kernels.tjSubsampling : options.subsampling;
+    flags = (options.accurateDct ? TJFLAG_ACCURATEDCT : TJFLAG_FASTDCT) | TJFLAG_NOREALLOC;
+    if (options.progressive) flags |= TJFLAG_PROGRESSIVE;
+    compressor = tjInitCompress();
+    if (!compressor) {
+        std::cerr << "Error inicializando TurboJPEG\n";
+    }
+}
+
+/**
+ * @brief Libera el buffer comprimido y el manejador TurboJPEG.
+ */
+TurboJPEGEncoder::~TurboJPEGEncoder() {
+    if (jpegBuf) tjFree(jpegBuf);
+    if (compressor) tjDestroy(compressor);
+}
+
+/**
+ * @brief Comprime un fotograma en el buffer de salida.
+ *
+ * El buffer interno se dimensiona con `tjBufSize` para el peor caso y se usa con
+ * `TJFLAG_NOREALLOC`, de modo que TurboJPEG no reserva memoria en cada fotograma. El
+ * fotograma debe tener el formato de la tabla de núcleos del codificador.
+ *
+ * @param image Fotograma a comprimir.
+ * @param out Buffer de salida con el JPEG comprimido.
+ * @return true si la compresión fue exitosa.
+ */
+bool TurboJPEGEncoder::encode(const Frame& image, std::vector<unsigned char>& out) {
+    if (!compressor || image.empty()) return false;
+    const Frame& input = kernels.encoderInput(image, scratch);
+
+    const unsigned long required = tjBufSize(input.width(), input.height(), subsampling);
+    if (required > jpegBufSize) {
+        if (jpegBuf) tjFree(jpegBuf);
+        jpegBuf = tjAlloc(static_cast<int>(required));
+        jpegBufSize = jpegBuf ? required : 0;
+        if (!jpegBuf) {
+            std::cerr << "Error reservando buffer JPEG\n";
+            return false;
+        }
+    }
+
+    unsigned long jpegSize = jpegBufSize;
+    int success = tjCompress2(
+        compressor,
+        input.data(),
+        input.width(),
+        static_cast<int>(input.stride()),
+        input.height(),
+        kernels.tjPixelFormat,
+        &jpegBuf,
+        &jpegSize,
+        subsampling,
+        quality,
+        flags
+    );
+
+    if (success != 0) {
+        std::cerr << "Error al comprimir: " << tjGetErrorStr() << std::endl;
+        return false;
+    }
+
+    out.assign(jpegBuf, jpegBuf + jpegSize);
+    return true;
+}
+
+/**
+ * @brief Crea el manejador tj3 y fija los parámetros que no cambian entre fotogramas.
+ * @param quality Calidad JPEG entre 1 y 100 (se ignora sin pérdida).
+ * @param kernels Núcleos del formato de los fotogramas.
+ * @param options Precisión, sin pérdida, submuestreo, DCT y codificación.
+ */
+TurboJPEG3Encoder::TurboJPEG3Encoder(int quality, const PixelKernels& kernels, const JpegOptions& options)
+    : kernels(kernels), precision(options.precision), lossless(options.lossless) {
+#ifdef FASTCAP_HAVE_TJ3
+    if (precision != 8 && kernels.format != PixelFormat::Gray16) {
+        std::cerr << "Error: La precisión de " << precision << " bits requiere fotogramas gray16" << std::endl;
+        return;
+    }
+    tjhandle handle = tj3Init(TJINIT_COMPRESS);
+    if (!handle) {
+        std::cerr << "Error inicializando TurboJPEG 3\n";
+        return;
+    }
+    int subsampling = (options.subsampling < 0 || kernels.tjSubsampling == TJSAMP_GRAY)
+        ? kernels.tjSubsampling : options.subsampling;
+    // Sin pérdida no hay submuestreo cromático ni conversión a gris
+    if (lossless) subsampling = kernels.tjSubsampling == TJSAMP_GRAY ? TJSAMP_GRAY : TJSAMP_444;
+    const bool configured = tj3Set(handle, TJPARAM_QUALITY, quality) == 0
+        && tj3Set(handle, TJPARAM_SUBSAMP, subsampling) == 0
+        && tj3Set(handle, TJPARAM_FASTDCT, options.accurateDct ? 0 : 1) == 0
+        && tj3Set(handle, TJPARAM_PROGRESSIVE, options.progressive ? 1 : 0) == 0
+        && tj3Set(handle, TJPARAM_LOSSLESS, lossless ? 1 : 0) == 0;
+    if (!configured) {
+        std::cerr << "Error configurando TurboJPEG 3: " << tj3GetErrorStr(handle) << std::endl;
+        tj3Destroy(handle);
+        return;
+    }
+    compressor = handle;
+#else
+    (void)quality;
+    (void)options;
+    std::cerr << "Error: Compilado sin TurboJPEG 3; '12bit', '16bit' y 'lossless' no están disponibles" << std::endl;
+#endif
+}
+
+/**
+ * @brief Libera el buffer comprimido y el manejador tj3.
+ */
+TurboJPEG3Encoder::~TurboJPEG3Encoder() {
+#ifdef FASTCAP_HAVE_TJ3
+    if (jpegBuf) tj3Free(jpegBuf);
+    if (compressor) tj3Destroy(compressor);
+#endif
+}
+
+/**
+ * @brief Cambia la calidad de los siguientes fotogramas (sin efecto sin pérdida).
+ */
+void TurboJPEG3Encoder::setQuality(int newQuality) {
+#ifdef FASTCAP_HAVE_TJ3
+    if (compressor) tj3Set(compressor, TJPARAM_QUALITY, newQuality);
+#else
+    (void)newQuality;
+#endif
+}
+
+bool TurboJPEG3Encoder::available() {
+#ifdef FASTCAP_HAVE_TJ3
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Comprime un fotograma con la variante tj3 de su precisión.
+ *
+ * El buffer comprimido se reserva una vez con `tj3JPEGBufSize` y TurboJPEG lo amplía si
+ * un fotograma no cabe (los JPEG sin pérdida pueden superar esa cota); la capacidad
+ * conocida se conserva para los siguientes.
+ *
+ * @param image Fotograma a comprimir.
+ * @param out Buffer de salida con el JPEG comprimido.
+ * @return true si la compresión fue exitosa.
+ */
+bool TurboJPEG3Encoder::encode(const Frame& image, std::vector<unsigned char>& out) {
+#ifdef FASTCAP_HAVE_TJ3
+    if (!compressor || image.empty()) return false;
+    const int width = image.width();
+    const int height = image.height();
+    if (!jpegBuf) {
+        jpegBufSize = tj3JPEGBufSize(width, height, TJSAMP_444);
+        jpegBuf = static_cast<unsigned char*>(tj3Alloc(jpegBufSize));
+        if (!jpegBuf) {
+            jpegBufSize = 0;
+            std::cerr << "Error reservando buffer JPEG\n";
+            return false;
+        }
+    }
+
+    // En tj3 el pitch se cuenta en muestras, no en bytes
+    size_t jpegSize = jpegBufSize;
+    int result;
+    if (precision == 16) {
+        result = tj3Compress16(compressor, image.row<uint16_t>(0), width,
+                               static_cast<int>(image.stride() / sizeof(uint16_t)), height, TJPF_GRAY,
+                               &jpegBuf, &jpegSize);
+    } else if (precision == 12) {
+        samples12.resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; y++) {
+            const uint16_t* row = image.row<uint16_t>(y);
+            short* samples = samples12.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; x++) samples[x] = static_cast<short>(row[x] >> 4);
+        }
+        result = tj3Compress12(compressor, samples12.data(), width, width, height, TJPF_GRAY, &jpegBuf, &jpegSize);
+    } else {
+        const Frame& input = kernels.encoderInput(image, scratch);
+        result = tj3Compress8(compressor, input.data(), width, static_cast<int>(input.stride()), height,
+                              kernels.tjPixelFormat, &jpegBuf, &jpegSize);
+    }
+    if (result != 0) {
+        std::cerr << "Error al comprimir: " << tj3GetErrorStr(compressor) << std::endl;
+        return false;
+    }
+    jpegBufSize = std::max(jpegBufSize, jpegSize);
+    out.assign(jpegBuf, jpegBuf + jpegSize);
+    return true;
+#else
+    (void)image;
+    (void)out;
+    return false;
+#endif
+}
@@ -4,10 +4,13 @@
  */
 
 #include "Utils.h"
+#include "Encoder.h"
 #include <iostream>
 #include <filesystem>
 #include <iomanip>
 #include <sstream>
+#include <cctype>
+#include <sys/resource.h>
 
 /**
  * @brief Muestra la ayuda y uso del programa con sus opciones.
@@ -20,9 +23,55 @@ void showUsage(const std::string& programName) {
     std::cout << "  -fps N      Velocidad de generación en fotogramas por segundo (por defecto: 50)" << std::endl;
     std::cout << "  -time N     Tiempo de ejecución en segundos (por defecto: 300 = 5 minutos)" << std::endl;
     std::cout << "  -writers N  Número de hilos escritores (por defecto: 4, máximo: 7)" << std::endl;
+    std::cout << "  -runtime R  threads (generador y escritores dedicados), tasks (pool con robo de tareas) o percore (un hilo fijado por núcleo genera, codifica y escribe) (por defecto: threads)" << std::endl;
+    std::cout << "  -cores N    Núcleos de los runtimes tasks y percore (por defecto: todos los permitidos)" << std::endl;
+    std::cout << "  -watchdog N Segundos en una etapa para considerar bloqueado a un escritor; 0 lo desactiva (por defecto: 10)" << std::endl;
+    std::cout << "  -retries N  Reintentos por escritura fallida, con espera exponencial; 0 los desactiva (por defecto: 5)" << std::endl;
+    std::cout << "  -retrydelay N Segundos antes del primer reintento (por defecto: 0.05)" << std::endl;
+    std::cout << "  -spill PATH Directorio alternativo para los fotogramas que no se pudieron guardar" << std::endl;
     std::cout << "  -dir PATH   Directorio de salida para las imágenes (por defecto: 'output')" << std::endl;
     std::cout << "  -width N    Ancho de las imágenes en píxeles (por defecto: 1920)" << std::endl;
     std::cout << "  -height N   Alto de las imágenes en píxeles (por defecto: 1280)" << std::endl;
+    std::cout << "  -format F   Formato de salida: bmp, jpg, raw o null (por defecto: " << kDefaultEncoderFormat << ")" << std::endl;
+    std::cout << "  -pixel P    Formato de píxel de los fotogramas: bgr, bgra, gray o gray16 (por defecto: bgr)" << std::endl;
+    std::cout << "  -quality N  Calidad JPEG entre 1 y 100 (por defecto: 90)" << std::endl;
+    std::cout << "  -jpegopts L Opciones JPEG: 444|422|420|gray, fast|accurate, baseline|progressive, optimize|cached[:N], 12bit|16bit, lossless (por defecto: 420,fast,baseline)" << std::endl;
+    std::cout << "  -bank N     Usa un banco de N fotogramas pregenerados en lugar de ruido nuevo" << std::endl;
+    std::cout << "  -storage S  Destino: disk, memory o segment (por defecto: disk)" << std::endl;
+    std::cout << "  -capacity S Capacidad del almacenamiento en memoria, p. ej. 50G (por defecto: ilimitada)" << std::endl;
+    std::cout << "  -segsize S  Tamaño máximo de cada segmento con -storage segment (por defecto: 1G)" << std::endl;
+    std::cout << "  -checkpoint N Segundos entre checkpoints de los segmentos (por defecto: 5)" << std::endl;
+    std::cout << "  -timeindex N Segundos por entrada del índice temporal de los segmentos; 0 lo desactiva (por defecto: 1)" << std::endl;
+    std::cout << "  -tier PATH  Aterrizaje rápido (NVMe/tmpfs); un migrador mueve los archivos a -dir" << std::endl;
+    std::cout << "  -tierlimit S Marca de agua del aterrizaje, p. ej. 4G (por defecto: 1G)" << std::endl;
+    std::cout << "  -ec K+M     Franjas con código de borrado en K volúmenes de datos y M de paridad" << std::endl;
+    std::cout << "  -volumes L  Directorios de los K+M volúmenes separados por comas (con -ec)" << std::endl;
+    std::cout << "  -stripe S   Bytes de fotogramas por franja con -ec (por defecto: 64M)" << std::endl;
+    std::cout << "  -mirror D   Copia espejo de cada fotograma en el directorio D (o 'memory')" << std::endl;
+    std::cout << "  -mirrorlag N Fotogramas que un destino espejo puede retrasarse (por defecto: 64)" << std::endl;
+    std::cout << "  -nullsize S Bytes por fotograma del codificador null (por defecto: 10% del fotograma)" << std::endl;
+    std::cout << "  -policy P   Cola llena: drop-oldest, drop-newest o block (por defecto: drop-oldest)" << std::endl;
+    std::cout << "  -busypoll   Escritores en espera activa (pause) con giro adaptativo antes de dormir; para núcleos dedicados" << std::endl;
+    std::cout << "  -spin S     Giro máximo antes de dormir en µs por etapa: writers=US,generator=US (por defecto: 2; 2000/200 con -busypoll)" << std::endl;
+    std::cout << "  -control S  Abre un canal de control en el socket Unix S (ver 'help' en el canal)" << std::endl;
+    std::cout << "  -dashboard  Panel en la terminal (throughput, cola, latencias, escritores, volúmenes); silencia el resto de la salida" << std::endl;
+    std::cout << "  -timeseries F Añade al CSV F una fila por intervalo con contadores, p99 de latencias y FPS por escritor" << std::endl;
+    std::cout << "  -tsinterval S Segundos por fila de -timeseries (por defecto: 1)" << std::endl;
+    std::cout << "  -bwlimit S  Límite de escritura compartido en bytes/s, p. ej. 200M (por defecto: sin límite)" << std::endl;
+    std::cout << "  -iopslimit N Límite de escrituras por segundo entre todos los escritores" << std::endl;
+    std::cout << "  -burst S    Ráfaga permitida por los límites, en segundos de tasa (por defecto: 1)" << std::endl;
+    std::cout << "  -encrypt K  Cifra cada fotograma con la clave del archivo K (32 bytes o 64 dígitos hex)" << std::endl;
+    std::cout << "  -cipher A   Algoritmo: aes-256-gcm o chacha20-poly1305 (por defecto: aes-256-gcm)" << std::endl;
+    std::cout << "  -cipherindex P Índice de nonces (por defecto: DIR/cipher.idx)" << std::endl;
+    std::cout << "  -rt P:N     Generador en tiempo real: fifo:N o rr:N (requiere CAP_SYS_NICE)" << std::endl;
+    std::cout << "  -nice N     Valor nice de los escritores (-20 a 19)" << std::endl;
+    std::cout << "  -batch      Escritores con SCHED_BATCH" << std::endl;
+    std::cout << "  -ioprio C   Clase de E/S de los escritores: rt:N, be:N o idle" << std::endl;
+    std::cout << "  -mlock      Bloquea en RAM la memoria del proceso (mlockall)" << std::endl;
+    std::cout << "  -sim        Simulación con reloj virtual (por defecto: -bank 8 -format null -storage memory)" << std::endl;
+    std::cout << "  -profile S  Perfil de carga: archivo o guion en línea, p. ej. \"step 10 30; ramp 20 30 120\"" << std::endl;
+    std::cout << "              Tramos: step D F | ramp D F0 F1 | burst D BASE PICO DURPICO PERIODO | poisson D F | repeat" << std::endl;
+    std::cout << "  -seed N     Semilla para las llegadas de Poisson del perfil (por defecto: 42)" << std::endl;
     std::cout << "  -h          Muestra esta ayuda" << std::endl;
 }
 
@@ -75,3 +124,65 @@ std::string formatByteSize(size_t bytes) {
     oss << std::fixed << std::setprecision(2) << size << " " << units[unitIndex];
     return oss.str();
 }
+
+/**
+ * @brief Interpreta un tamaño con sufijo opcional de unidad binaria.
+ * 
+ * Acepta números enteros o decimales seguidos de K, M, G o T (opcionalmente con "B"
+ * o "iB"), p. ej. "4096", "200M", "1.5GB".
+ * 
+ * @param text Texto a interpretar.
+ * @param bytes Resultado en bytes.
+ * @return true si el texto es un tamaño válido, false en caso contrario.
+ */
+bool parseByteSize(const std::string& text, size_t& bytes) {
+    size_t consumed = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &consumed);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (value < 0) return false;
+
+    std::string suffix = text.substr(consumed);
+    for (auto& c : suffix) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    if (suffix.size() > 1 && suffix.back() == 'B') suffix.pop_back();
+    if (suffix.size() > 1 && suffix.back() == 'I') suffix.pop_back();
+
+    double multiplier = 1.0;
+    if (suffix.empty() || suffix == "B") multiplier = 1.0;
+    else if (suffix == "K") multiplier = 1024.0;
+    else if (suffix == "M") multiplier = 1024.0 * 1024.0;
+    else if (suffix == "G") multiplier = 1024.0 * 1024.0 * 1024.0;
+    else if (suffix == "T") multiplier = 1024.0 * 1024.0 * 1024.0 * 1024.0;
+    else return false;
+
+    bytes = static_cast<size_t>(value * multiplier);
+    return true;
+}
+
+/**
+ * @brief Comprueba que un nombre sea un único componente de ruta.
+ *
+ * Las herramientas que extraen fotogramas usan el nombre guardado en la grabación como
+ * nombre de archivo; uno manipulado no debe poder escribir fuera del directorio de destino.
+ *
+ * @param name Nombre a comprobar.
+ * @return true si puede usarse como nombre de archivo dentro de un directorio.
+ */
+bool isPlainFileName(const std::string& name) {
+    return !name.empty() && name != "." && name != ".." &&
+           name.find('/') == std::string::npos && name.find('\0') == std::string::npos;
+}
+
+/**
+ * @brief Tiempo de CPU consumido por el proceso.
+ * @return Segundos de usuario más sistema de todos los hilos (getrusage).
+ */
+double processCpuSeconds() {
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+         + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file WriterPool.cpp
+ * @brief Gestión del conjunto de hilos escritores con tamaño ajustable en ejecución.
+ */
+
+#include "WriterPool.h"
+#include "ImageWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Crea un conjunto vacío de escritores.
+ */
+WriterPool::WriterPool(ThreadSafeQueue& queue, Storage& storage, const EncoderSettings& encoderSettings,
+                       const std::atomic<int>& quality, const CipherSettings& cipherSettings,
+                       PipelineStats& stats, const ThreadTuning& tuning, BandwidthLimiter* limiter,
+                       RetryQueue* retries)
+    : queue(queue), storage(storage), encoderSettings(encoderSettings), quality(quality),
+      cipherSettings(cipherSettings), stats(stats),
+      tuning(tuning), limiter(limiter), retries(retries) {}
+
+/**
+ * @brief Espera a los escritores pendientes.
+ */
+WriterPool::~WriterPool() {
+    joinAll();
+}
+
+/**
+ * @brief Ajusta el número de escritores activos.
+ *
+ * Los escritores sobrantes (los más recientes) reciben la orden de retiro y se
+ * despiertan si estaban esperando datos; su join se hace en joinAll() para no
+ * bloquear a quien pidió el cambio.
+ *
+ * @param count Número deseado de escritores (al menos 1).
+ */
+void WriterPool::resize(int count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    count = std::max(count, 1);
+
+    while (static_cast<int>(active.size()) < count) {
+        spawnLocked();
+    }
+
+    bool retiredAny = false;
+    while (static_cast<int>(active.size()) > count) {
+        active.back().retire->store(true);
+        retired.push_back(std::move(active.back()));
+        active.pop_back();
+        retiredAny = true;
+    }
+    if (retiredAny) {
+        queue.wakeAll();
+    }
+}
+
+/**
+ * @brief Lanza un escritor con un identificador nuevo y su latido.
+ */
+void WriterPool::spawnLocked() {
+    Worker worker;
+    worker.id = nextId++;
+    worker.retire = std::make_unique<std::atomic<bool>>(false);
+    worker.heartbeat = std::make_unique<WriterHeartbeat>();
+    const std::atomic<bool>& retire = *worker.retire;
+    WriterHeartbeat* heartbeat = worker.heartbeat.get();
+    const int id = worker.id;
+    worker.thread = std::thread([this, &retire, heartbeat, id] {
+        // Las prioridades por hilo (nice, ioprio) solo pueden aplicarse desde el propio hilo
+        applyWriterTuning(tuning);
+        imageWriterThread(queue, storage, encoderSettings, quality, cipherSettings, stats, limiter, id, retire,
+                          heartbeat, retries);
+        if (heartbeat->stalled.load()) {
+            stats.writerRecoveries++;
+            std::cerr << "Watchdog: el escritor #" << id << " se desbloqueó y terminó" << std::endl;
+        }
+        heartbeat->finished.store(true);
+    });
+    active.push_back(std::move(worker));
+}
+
+/**
+ * @brief Hilos escritores que siguen vivos, incluidos los retirados.
+ */
+int WriterPool::liveThreadsLocked() const {
+    int live = static_cast<int>(active.size());
+    for (const auto& worker : retired) {
+        if (!worker.heartbeat->finished.load()) live++;
+    }
+    return live;
+}
+
+/**
+ * @brief Inicia el hilo que vigila los latidos de los escritores.
+ */
+void WriterPool::startWatchdog(double seconds, int threads) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (watchdog.joinable() || seconds <= 0.0) return;
+    stallSeconds = seconds;
+    maxThreads = threads;
+    watchdog = std::thread(&WriterPool::watchdogLoop, this);
+}
+
+/**
+ * @brief Revisa periódicamente los latidos y retira a los escritores bloqueados.
+ *
+ * La espera en el limitador no cuenta como bloqueo: es un retraso deliberado.
+ */
+void WriterPool::watchdogLoop() {
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(std::clamp(stallSeconds / 4.0, 0.05, 1.0)));
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!wake.wait_for(lock, period, [this] { return stopping; })) {
+        for (size_t i = 0; i < active.size();) {
+            WriterHeartbeat& heartbeat = *active[i].heartbeat;
+            const auto stage = heartbeat.stage();
+            const double stuck = heartbeat.stageSeconds();
+            if (stage == WriterHeartbeat::Stage::Idle || stage == WriterHeartbeat::Stage::Throttle ||
+                stuck < stallSeconds) {
+                i++;
+                continue;
+            }
+
+            Worker worker = std::move(active[i]);
+            active.erase(active.begin() + static_cast<std::ptrdiff_t>(i));
+            worker.heartbeat->stalled.store(true);
+            worker.retire->store(true);
+            stats.writerStalls++;
+
+            std::ostringstream message;
+            message << std::fixed << std::setprecision(1) << "Watchdog: escritor #" << worker.id
+                    << " bloqueado " << stuck << " s en " << WriterHeartbeat::stageName(stage)
+                    << " del fotograma " << heartbeat.sequence() << " (" << heartbeat.file() << ")";
+            retired.push_back(std::move(worker));
+            if (liveThreadsLocked() < maxThreads) {
+                spawnLocked();
+                stats.writerReplacements++;
+                message << "; reemplazado por #" << active.back().id;
+            } else {
+                message << "; sin presupuesto para reemplazarlo (" << maxThreads << " hilos)";
+            }
+            std::cerr << message.str() << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Escritores retirados por el watchdog que siguen bloqueados.
+ */
+int WriterPool::stalledCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    int count = 0;
+    for (const auto& worker : retired) {
+        if (worker.heartbeat->stalled.load() && !worker.heartbeat->finished.load()) count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Número de escritores activos.
+ */
+int WriterPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(active.size());
+}
+
+/**
+ * @brief Espera a que terminen todos los escritores, activos y retirados.
+ */
+void WriterPool::joinAll() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (watchdog.joinable()) {
+        watchdog.join();
+    }
+
+    // Un escritor bloqueado solo puede esperarse: su operación no se puede cancelar
+    const int stalled = stalledCount();
+    if (stalled > 0) {
+        std::cerr << "Esperando a " << stalled << " escritores bloqueados..." << std::endl;
+    }
+
+    std::vector<Worker> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& worker : active) pending.push_back(std::move(worker));
+        for (auto& worker : retired) pending.push_back(std::move(worker));
+        active.clear();
+        retired.clear();
+    }
+    for (auto& worker : pending) {
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+    }
+}
@@ -2,7 +2,8 @@
  * @file main.cpp
  * @brief Programa principal para generar y guardar imágenes en múltiples hilos.
  * 
- * Este programa genera imágenes aleatorias con OpenCV a una tasa de FPS objetivo,
+ * Este programa genera imágenes aleatorias a una tasa de FPS objetivo (constante
+ * o definida por un perfil de carga),
  * las encola en una cola segura y varios hilos escritores las guardan como archivos JPEG.
  * 
  * Se pueden configurar parámetros como FPS, duración, cantidad de hilos escritores, dimensiones,
@@ -12,6 +13,30 @@
 #include "ThreadSafeQueue.h"
 #include "ImageGenerator.h"
 #include "ImageWriter.h"
+#include "LoadProfile.h"
+#include "Clock.h"
+#include "FrameSource.h"
+#include "Encoder.h"
+#include "LibjpegEncoder.h"
+#include "TurboJPEGWriter.h"
+#include "Storage.h"
+#include "TieredStorage.h"
+#include "MirrorStorage.h"
+#include "ErasureStorage.h"
+#include "SegmentStorage.h"
+#include "PipelineStats.h"
+#include "WriterPool.h"
+#include "TaskScheduler.h"
+#include "TaskPipeline.h"
+#include "PerCoreRuntime.h"
+#include "ControlServer.h"
+#include "ThreadTuning.h"
+#include "RateLimiter.h"
+#include "RetryQueue.h"
+#include "FrameCipher.h"
+#include "Startup.h"
+#include "TimeSeries.h"
+#include "Dashboard.h"
 #include "Utils.h"
 
 #include <iostream>
@@ -21,6 +46,26 @@
 #include <chrono>
 #include <iomanip>
 #include <string>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include <sstream>
+#include <random>
+
+/// Número máximo de hilos escritores.
+constexpr int kMaxWriterThreads = 7;
+
+/// Hilos adicionales que el watchdog puede lanzar para reemplazar escritores bloqueados.
+constexpr int kWatchdogSpareThreads = 2;
+
+/// Giro máximo de los escritores con -busypoll (ns).
+constexpr int64_t kBusyPollWritersSpinNs = 2000000;
+
+/// Giro máximo del generador con -busypoll (ns).
+constexpr int64_t kBusyPollGeneratorSpinNs = 200000;
+
+/// Bloques del pool de ruido pre-cargados además de uno por escritor o núcleo.
+constexpr size_t kPrefaultSpareBlocks = 2;
 
 /**
  * @brief Función principal
@@ -33,6 +78,9 @@
  * @return int Código de salida
  */
 int main(int argc, char** argv) {
+    // Origen de los tiempos de arranque (primer fotograma, régimen estable)
+    const auto processStart = std::chrono::steady_clock::now();
+
     // Parámetros por defecto
     int targetFPS = 50;
     int runTime = 300; // 5 minutos en segundos
@@ -40,6 +88,46 @@ int main(int argc, char** argv) {
     std::string outputDir = "output";
     int imageWidth = 1920;
     int imageHeight = 1280;
+    std::string profileSpec;
+    uint64_t profileSeed = 42;
+    bool runTimeSpecified = false;
+    EncoderSettings encoderSettings;
+    size_t bankSize = 0;
+    std::string storageType = "disk";
+    size_t memoryCapacity = 0;
+    std::string landingDir;
+    size_t landingWatermark = size_t(1) << 30;
+    std::string mirrorTarget;
+    std::string erasureSpec;
+    std::vector<std::string> erasureVolumes;
+    size_t stripeSize = size_t(64) << 20;
+    size_t mirrorBacklog = 64;
+    size_t segmentSize = size_t(1) << 30;
+    double checkpointInterval = 5.0;
+    double timeIndexInterval = 1.0;
+    double watchdogSeconds = 10.0;
+    RetryPolicy retryPolicy;
+    std::string spillDir;
+    bool simulate = false;
+    bool formatSpecified = false;
+    bool bankSpecified = false;
+    bool storageSpecified = false;
+    QueuePolicy queuePolicy = QueuePolicy::DropOldest;
+    bool busyPoll = false;
+    std::string runtimeMode = "threads";
+    int coreCount = 0;
+    std::string spinSpec;
+    std::string controlPath;
+    std::string timeSeriesPath;
+    bool dashboardEnabled = false;
+    double timeSeriesInterval = 1.0;
+    ThreadTuning threadTuning;
+    size_t bandwidthLimit = 0;
+    double iopsLimit = 0.0;
+    double burstSeconds = 1.0;
+    std::string keyPath;
+    std::string cipherIndexPath;
+    CipherSettings cipherSettings;
     
     // Procesar argumentos de línea de comandos
     for (int i = 1; i < argc; i++) {
@@ -56,14 +144,15 @@ int main(int argc, char** argv) {
             }
         } else if (arg == "-time" && i + 1 < argc) {
             runTime = std::stoi(argv[++i]);
+            runTimeSpecified = true;
             if (runTime <= 0) {
                 std::cerr << "Error: Tiempo de ejecución debe ser mayor que 0" << std::endl;
                 return 1;
             }
         } else if (arg == "-writers" && i + 1 < argc) {
             numWriterThreads = std::stoi(argv[++i]);
-            if (numWriterThreads <= 0 || numWriterThreads > 7) {
-                std::cerr << "Error: Número de hilos escritores debe estar entre 1 y 7" << std::endl;
+            if (numWriterThreads <= 0 || numWriterThreads > kMaxWriterThreads) {
+                std::cerr << "Error: Número de hilos escritores debe estar entre 1 y " << kMaxWriterThreads << std::endl;
                 return 1;
             }
         } else if (arg == "-dir" && i + 1 < argc) {
@@ -80,6 +169,206 @@ int main(int argc, char** argv) {
                 std::cerr << "Error: Alto debe ser mayor que 0" << std::endl;
                 return 1;
             }
+        } else if (arg == "-format" && i + 1 < argc) {
+            encoderSettings.format = argv[++i];
+            formatSpecified = true;
+            if (!isValidEncoderFormat(encoderSettings.format)) {
+                std::cerr << "Error: Formato no soportado: " << encoderSettings.format << std::endl;
+                return 1;
+            }
+        } else if (arg == "-pixel" && i + 1 < argc) {
+            if (!parsePixelFormat(argv[++i], encoderSettings.pixelFormat)) {
+                std::cerr << "Error: Formato de píxel debe ser 'bgr', 'bgra', 'gray' o 'gray16'" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-quality" && i + 1 < argc) {
+            encoderSettings.quality = std::stoi(argv[++i]);
+            if (encoderSettings.quality <= 0 || encoderSettings.quality > 100) {
+                std::cerr << "Error: Calidad debe estar entre 1 y 100" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-jpegopts" && i + 1 < argc) {
+            if (!parseJpegOptions(argv[++i], encoderSettings.jpeg)) {
+                std::cerr << "Error: Opciones JPEG inválidas: " << argv[i]
+                          << " (444|422|420|gray, fast|accurate, baseline|progressive, optimize|cached[:N], 12bit|16bit, lossless)"
+                          << std::endl;
+                return 1;
+            }
+            if (encoderSettings.jpeg.huffman != JpegHuffman::Standard && !LibjpegEncoder::available()) {
+                std::cerr << "Error: Compilado sin libjpeg; 'optimize' y 'cached' no están disponibles" << std::endl;
+                return 1;
+            }
+            if ((encoderSettings.jpeg.precision != 8 || encoderSettings.jpeg.lossless) && !TurboJPEG3Encoder::available()) {
+                std::cerr << "Error: Compilado sin TurboJPEG 3; '12bit', '16bit' y 'lossless' no están disponibles" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-bank" && i + 1 < argc) {
+            bankSize = std::stoul(argv[++i]);
+            bankSpecified = true;
+        } else if (arg == "-storage" && i + 1 < argc) {
+            storageType = argv[++i];
+            storageSpecified = true;
+            if (storageType != "disk" && storageType != "memory" && storageType != "segment") {
+                std::cerr << "Error: Almacenamiento debe ser 'disk', 'memory' o 'segment'" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-capacity" && i + 1 < argc) {
+            if (!parseByteSize(argv[++i], memoryCapacity)) {
+                std::cerr << "Error: Capacidad inválida: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-segsize" && i + 1 < argc) {
+            if (!parseByteSize(argv[++i], segmentSize) || segmentSize == 0) {
+                std::cerr << "Error: Tamaño de segmento inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-checkpoint" && i + 1 < argc) {
+            checkpointInterval = std::stod(argv[++i]);
+            if (checkpointInterval <= 0.0) {
+                std::cerr << "Error: El intervalo de checkpoint debe ser mayor que 0" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-timeindex" && i + 1 < argc) {
+            timeIndexInterval = std::stod(argv[++i]);
+            if (timeIndexInterval < 0.0) {
+                std::cerr << "Error: El intervalo del índice temporal no puede ser negativo" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-watchdog" && i + 1 < argc) {
+            watchdogSeconds = std::stod(argv[++i]);
+            if (watchdogSeconds < 0.0) {
+                std::cerr << "Error: El umbral del watchdog no puede ser negativo" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-retries" && i + 1 < argc) {
+            retryPolicy.maxAttempts = std::stoi(argv[++i]);
+            if (retryPolicy.maxAttempts < 0) {
+                std::cerr << "Error: El número de reintentos no puede ser negativo" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-retrydelay" && i + 1 < argc) {
+            retryPolicy.baseDelay = std::stod(argv[++i]);
+            if (retryPolicy.baseDelay <= 0.0) {
+                std::cerr << "Error: La espera de reintento debe ser mayor que 0" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-spill" && i + 1 < argc) {
+            spillDir = argv[++i];
+        } else if (arg == "-tier" && i + 1 < argc) {
+            landingDir = argv[++i];
+        } else if (arg == "-tierlimit" && i + 1 < argc) {
+            if (!parseByteSize(argv[++i], landingWatermark)) {
+                std::cerr << "Error: Marca de agua inválida: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-ec" && i + 1 < argc) {
+            erasureSpec = argv[++i];
+        } else if (arg == "-volumes" && i + 1 < argc) {
+            erasureVolumes = splitVolumeList(argv[++i]);
+        } else if (arg == "-stripe" && i + 1 < argc) {
+            if (!parseByteSize(argv[++i], stripeSize) || stripeSize == 0) {
+                std::cerr << "Error: Tamaño de franja inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-mirror" && i + 1 < argc) {
+            mirrorTarget = argv[++i];
+        } else if (arg == "-mirrorlag" && i + 1 < argc) {
+            mirrorBacklog = std::stoul(argv[++i]);
+            if (mirrorBacklog == 0) {
+                std::cerr << "Error: El retraso del espejo debe ser mayor que 0" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-nullsize" && i + 1 < argc) {
+            if (!parseByteSize(argv[++i], encoderSettings.nullSize)) {
+                std::cerr << "Error: Tamaño inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-policy" && i + 1 < argc) {
+            if (!parseQueuePolicy(argv[++i], queuePolicy)) {
+                std::cerr << "Error: Política de cola desconocida: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-runtime" && i + 1 < argc) {
+            runtimeMode = argv[++i];
+            if (runtimeMode != "threads" && runtimeMode != "tasks" && runtimeMode != "percore") {
+                std::cerr << "Error: Runtime desconocido: " << runtimeMode << " (use threads, tasks o percore)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-cores" && i + 1 < argc) {
+            coreCount = std::stoi(argv[++i]);
+            if (coreCount <= 0) {
+                std::cerr << "Error: El número de núcleos debe ser mayor que 0" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-busypoll") {
+            busyPoll = true;
+        } else if (arg == "-spin" && i + 1 < argc) {
+            spinSpec = argv[++i];
+        } else if (arg == "-control" && i + 1 < argc) {
+            controlPath = argv[++i];
+        } else if (arg == "-dashboard") {
+            dashboardEnabled = true;
+        } else if (arg == "-timeseries" && i + 1 < argc) {
+            timeSeriesPath = argv[++i];
+        } else if (arg == "-tsinterval" && i + 1 < argc) {
+            timeSeriesInterval = std::stod(argv[++i]);
+            if (timeSeriesInterval <= 0.0) {
+                std::cerr << "Error: El intervalo de la serie temporal debe ser mayor que 0" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-bwlimit" && i + 1 < argc) {
+            if (!parseByteSize(argv[++i], bandwidthLimit)) {
+                std::cerr << "Error: Límite de ancho de banda inválido: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "-iopslimit" && i + 1 < argc) {
+            iopsLimit = std::stod(argv[++i]);
+            if (iopsLimit < 0) {
+                std::cerr << "Error: El límite de IOPS no puede ser negativo" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-burst" && i + 1 < argc) {
+            burstSeconds = std::stod(argv[++i]);
+            if (burstSeconds <= 0) {
+                std::cerr << "Error: La ráfaga debe ser mayor que 0" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-encrypt" && i + 1 < argc) {
+            keyPath = argv[++i];
+        } else if (arg == "-cipher" && i + 1 < argc) {
+            cipherSettings.algorithm = argv[++i];
+            if (!FrameCipher::isValidAlgorithm(cipherSettings.algorithm)) {
+                std::cerr << "Error: Cifrado no soportado: " << cipherSettings.algorithm << std::endl;
+                return 1;
+            }
+        } else if (arg == "-cipherindex" && i + 1 < argc) {
+            cipherIndexPath = argv[++i];
+        } else if (arg == "-rt" && i + 1 < argc) {
+            if (!parseRealtimeSpec(argv[++i], threadTuning)) {
+                std::cerr << "Error: Política de tiempo real inválida (use fifo:N o rr:N, N entre 1 y 99)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-nice" && i + 1 < argc) {
+            threadTuning.writerNice = std::stoi(argv[++i]);
+            if (threadTuning.writerNice < -20 || threadTuning.writerNice > 19) {
+                std::cerr << "Error: nice debe estar entre -20 y 19" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-batch") {
+            threadTuning.writerBatch = true;
+        } else if (arg == "-ioprio" && i + 1 < argc) {
+            if (!parseIoPrioritySpec(argv[++i], threadTuning)) {
+                std::cerr << "Error: Prioridad de E/S inválida (use rt:N, be:N o idle, N entre 0 y 7)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-mlock") {
+            threadTuning.lockMemory = true;
+        } else if (arg == "-sim") {
+            simulate = true;
+        } else if (arg == "-profile" && i + 1 < argc) {
+            profileSpec = argv[++i];
+        } else if (arg == "-seed" && i + 1 < argc) {
+            profileSeed = std::stoull(argv[++i]);
         } else {
             std::cerr << "Argumento desconocido: " << arg << std::endl;
             showUsage(argv[0]);
@@ -87,87 +376,650 @@ int main(int argc, char** argv) {
         }
     }
     
-    // Crear directorio de salida
-    if (!createDirectoryIfNotExists(outputDir)) {
+    // Con -dashboard, std::cout y std::cerr pasan por la consola del panel desde antes
+    // de arrancar ningún hilo: activarlo después solo cambia su modo, no los streams
+    ConsoleCapture console;
+    if (dashboardEnabled) {
+        console.install();
+    }
+
+    // Los JPEG de 12 y 16 bits salen de los 16 bits de los fotogramas gray16
+    if (encoderSettings.jpeg.precision != 8 && encoderSettings.pixelFormat != PixelFormat::Gray16) {
+        std::cerr << "Error: '12bit' y '16bit' requieren -pixel gray16" << std::endl;
+        return 1;
+    }
+
+    // Giro antes de dormir en la cola: corto por defecto; con -busypoll, largo y adaptativo
+    QueueSpin queueSpin;
+    if (busyPoll) {
+        queueSpin.writers = {kBusyPollWritersSpinNs, true};
+        queueSpin.generator = {kBusyPollGeneratorSpinNs, true};
+    }
+    if (!spinSpec.empty() && !parseQueueSpin(spinSpec, queueSpin)) {
+        std::cerr << "Error: Giro inválido (use writers=US,generator=US)" << std::endl;
+        return 1;
+    }
+    
+    // Perfil de carga: tasa constante por defecto o guion con -profile
+    LoadProfile loadProfile(targetFPS);
+    if (!profileSpec.empty()) {
+        if (!LoadProfile::load(profileSpec, loadProfile)) {
+            return 1;
+        }
+        // Sin -time explícito, la ejecución dura lo que dure el guion
+        const double profileDuration = loadProfile.duration();
+        if (!runTimeSpecified && std::isfinite(profileDuration)) {
+            runTime = static_cast<int>(std::ceil(profileDuration));
+        }
+    }
+    loadProfile.setSeed(profileSeed);
+    
+    // Núcleos de los runtimes tasks y percore: los permitidos al proceso salvo -cores
+    if (coreCount == 0) coreCount = availableCores();
+    const bool perCoreRuntime = runtimeMode == "percore";
+    if (perCoreRuntime && simulate) {
+        std::cerr << "Error: -runtime percore necesita el reloj real (varios generadores no pueden compartir el reloj virtual)" << std::endl;
         return 1;
     }
     
+    // Con un generador por núcleo, cada uno tiene su perfil (la semilla de Poisson varía por núcleo)
+    std::vector<std::unique_ptr<LoadProfile>> coreProfiles;
+    if (perCoreRuntime) {
+        for (int core = 1; core < coreCount; core++) {
+            auto profile = std::make_unique<LoadProfile>(targetFPS);
+            if (!profileSpec.empty()) LoadProfile::load(profileSpec, *profile);
+            profile->setSeed(profileSeed + core);
+            coreProfiles.push_back(std::move(profile));
+        }
+    }
+    
+    // En simulación, sustitutos baratos salvo que se pidan otros explícitamente
+    if (simulate) {
+        if (!bankSpecified) bankSize = 8;
+        if (!formatSpecified) encoderSettings.format = "null";
+        if (!storageSpecified) storageType = "memory";
+    }
+    
+    // Reloj: real o virtual
+    SteadyClock steadyClock;
+    VirtualClock virtualClock;
+    Clock& clock = simulate ? static_cast<Clock&>(virtualClock) : static_cast<Clock&>(steadyClock);
+    
+    // Destino de almacenamiento
+    std::unique_ptr<Storage> storage;
+    TieredStorage* tieredStorage = nullptr;
+    ErasureStorage* erasureStorage = nullptr;
+    SegmentStorage* segmentStorage = nullptr;
+    if (storageType == "memory") {
+        if (!landingDir.empty() || !erasureSpec.empty()) {
+            std::cerr << "Error: -tier y -ec requieren almacenamiento en disco" << std::endl;
+            return 1;
+        }
+        storage = std::make_unique<MemoryStorage>(memoryCapacity);
+    } else if (storageType == "segment") {
+        // Segmentos con CRC por registro y checkpoints periódicos
+        if (!landingDir.empty() || !erasureSpec.empty()) {
+            std::cerr << "Error: -tier y -ec no se pueden combinar con -storage segment" << std::endl;
+            return 1;
+        }
+        if (!createDirectoryIfNotExists(outputDir)) {
+            return 1;
+        }
+        auto segmented = std::make_unique<SegmentStorage>(outputDir, segmentSize, checkpointInterval, timeIndexInterval);
+        segmentStorage = segmented.get();
+        storage = std::move(segmented);
+    } else if (!erasureSpec.empty()) {
+        // Franjas con código de borrado repartidas en K+M volúmenes
+        int dataShards = 0, parityShards = 0;
+        if (!ErasureCode::parseSpec(erasureSpec, dataShards, parityShards)) {
+            std::cerr << "Error: Código de borrado inválido (use K+M, p. ej. 4+2): " << erasureSpec << std::endl;
+            return 1;
+        }
+        if (static_cast<int>(erasureVolumes.size()) != dataShards + parityShards) {
+            std::cerr << "Error: -ec " << erasureSpec << " necesita " << (dataShards + parityShards)
+                      << " directorios en -volumes" << std::endl;
+            return 1;
+        }
+        if (!landingDir.empty()) {
+            std::cerr << "Error: -tier no se puede combinar con -ec" << std::endl;
+            return 1;
+        }
+        for (const auto& volume : erasureVolumes) {
+            if (!createDirectoryIfNotExists(volume)) {
+                return 1;
+            }
+        }
+        auto erasure = std::make_unique<ErasureStorage>(erasureVolumes, dataShards, parityShards, stripeSize);
+        erasure->setTargetRate(loadProfile.peakRate());
+        erasureStorage = erasure.get();
+        storage = std::move(erasure);
+    } else {
+        // Crear directorio de salida
+        if (!createDirectoryIfNotExists(outputDir)) {
+            return 1;
+        }
+        if (!landingDir.empty()) {
+            if (!createDirectoryIfNotExists(landingDir)) {
+                return 1;
+            }
+            auto tiered = std::make_unique<TieredStorage>(landingDir, outputDir, landingWatermark);
+            tieredStorage = tiered.get();
+            storage = std::move(tiered);
+        } else {
+            storage = std::make_unique<FileStorage>(outputDir);
+        }
+    }
+    
+    // Copia espejo: el mismo buffer codificado va a un segundo destino
+    MirrorStorage* mirrorStorage = nullptr;
+    if (!mirrorTarget.empty()) {
+        std::unique_ptr<Storage> secondary;
+        if (mirrorTarget == "memory") {
+            secondary = std::make_unique<MemoryStorage>(memoryCapacity);
+        } else {
+            if (!createDirectoryIfNotExists(mirrorTarget)) {
+                return 1;
+            }
+            secondary = std::make_unique<FileStorage>(mirrorTarget);
+        }
+        auto mirror = std::make_unique<MirrorStorage>(std::move(storage), std::move(secondary), mirrorBacklog);
+        mirrorStorage = mirror.get();
+        storage = std::move(mirror);
+    }
+    
+    // Reintentos de escritura fuera del camino de los escritores, con desvío opcional
+    std::unique_ptr<Storage> spillStorage;
+    if (!spillDir.empty()) {
+        if (!createDirectoryIfNotExists(spillDir)) {
+            return 1;
+        }
+        spillStorage = std::make_unique<FileStorage>(spillDir);
+    }
+    
+    // Cifrado en reposo: clave de archivo, sal aleatoria por ejecución e índice de nonces
+    CipherIndex cipherIndex;
+    if (!keyPath.empty()) {
+        if (!FrameCipher::available()) {
+            std::cerr << "Error: Compilado sin OpenSSL; -encrypt no está disponible" << std::endl;
+            return 1;
+        }
+        // fastcap_decrypt verifica archivos sueltos; los segmentos y las franjas no los puede leer
+        if (storageType == "segment" || !erasureSpec.empty()) {
+            std::cerr << "Error: -encrypt no se puede combinar con -storage segment ni con -ec" << std::endl;
+            return 1;
+        }
+        if (!loadCipherKey(keyPath, cipherSettings.key)) {
+            std::cerr << "Error: La clave debe tener 32 bytes (binario) o 64 dígitos hexadecimales: " << keyPath << std::endl;
+            return 1;
+        }
+        cipherSettings.enabled = true;
+        cipherSettings.salt = std::random_device{}();
+        if (cipherIndexPath.empty()) {
+            cipherIndexPath = outputDir + "/cipher.idx";
+        }
+        cipherSettings.index = &cipherIndex;
+    }
+    
+    // Limitador compartido de ancho de banda e IOPS de los escritores
+    BandwidthLimiter bandwidthLimiter(clock, static_cast<double>(bandwidthLimit), iopsLimit, burstSeconds);
+    
+    // Los núcleos de píxel se eligen una vez por codificador según el formato y la resolución
+    encoderSettings.width = imageWidth;
+    encoderSettings.height = imageHeight;
+    
+    // Bloquear memoria antes de reservar el banco de fotogramas y los buffers
+    applyMemoryLock(threadTuning);
+    
+    // Contadores para estadísticas
+    PipelineStats stats;
+    
+    // Inicialización en paralelo: recuperación del destino, comprobación del codificador,
+    // índice de nonces y primer fotograma del origen. El resto del banco y la pre-carga
+    // del pool siguen en segundo plano, sin retrasar el arranque del generador.
+    uint64_t firstSequence = 0;
+    bool resumed = false;
+    std::unique_ptr<FrameSource> frameSource;
+    StartupMonitor startup(stats, processStart);
+    ParallelInit init;
+    init.add("recuperación", [&] {
+        // Continuar la numeración de una grabación anterior (o interrumpida) en el mismo destino
+        resumed = storage->recover(firstSequence);
+        return true;
+    });
+    init.add("codificador", [&] {
+        if (!createEncoder(encoderSettings)) {
+            std::cerr << "Error: No se pudo inicializar el codificador " << encoderSettings.format << std::endl;
+            return false;
+        }
+        return true;
+    });
+    if (cipherSettings.enabled) {
+        init.add("índice de nonces", [&] {
+            if (!cipherIndex.open(cipherIndexPath, cipherSettings)) {
+                std::cerr << "Error: No se pudo abrir el índice de nonces " << cipherIndexPath << std::endl;
+                return false;
+            }
+            return true;
+        });
+    }
+    init.add("origen", [&] {
+        const int consumers = runtimeMode == "threads" ? numWriterThreads : perCoreRuntime ? 0 : coreCount;
+        frameSource = createFrameSource(imageWidth, imageHeight, bankSize, encoderSettings.pixelFormat,
+                                        static_cast<size_t>(consumers) + kPrefaultSpareBlocks);
+        return frameSource != nullptr;
+    });
+    if (!init.run()) {
+        return 1;
+    }
+    startup.initialized(init);
+    if (resumed && firstSequence > 0) {
+        std::cout << "Grabación existente: se continúa desde la secuencia " << firstSequence << std::endl;
+    }
+    
     // Mostrar configuración
     std::cout << "=== Configuración ===" << std::endl;
-    std::cout << "Dimensiones: " << imageWidth << "x" << imageHeight << " píxeles" << std::endl;
-    std::cout << "FPS objetivo: " << targetFPS << std::endl;
+    std::cout << "Dimensiones: " << imageWidth << "x" << imageHeight << " píxeles ("
+              << describePixelKernels(*selectPixelKernels(encoderSettings.pixelFormat, imageWidth, imageHeight))
+              << ")" << std::endl;
+    std::cout << "Perfil de carga: " << loadProfile.describe() << std::endl;
     std::cout << "Tiempo de ejecución: " << runTime << " segundos" << std::endl;
-    std::cout << "Hilos escritores: " << numWriterThreads << std::endl;
-    std::cout << "Directorio de salida: " << outputDir << std::endl;
+    const bool taskRuntime = runtimeMode == "tasks";
+    if (taskRuntime) {
+        std::cout << "Runtime: tareas con robo de trabajo, " << coreCount << " trabajadores" << std::endl;
+    } else if (perCoreRuntime) {
+        std::cout << "Runtime: por núcleo, " << coreCount << " hilos fijados que generan, codifican y escriben" << std::endl;
+    } else {
+        std::cout << "Hilos escritores: " << numWriterThreads << std::endl;
+    }
+    std::cout << "Origen de fotogramas: " << frameSource->describe() << std::endl;
+    std::cout << "Formato: " << encoderSettings.format;
+    if (encoderSettings.format == "jpg") {
+        const std::string options = describeJpegOptions(encoderSettings.jpeg);
+        std::cout << " (calidad " << encoderSettings.quality;
+        if (!options.empty()) std::cout << ", " << options;
+        std::cout << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "Destino: " << storage->describe() << std::endl;
+    if (cipherSettings.enabled) {
+        std::cout << "Cifrado: " << cipherSettings.algorithm << " (" << FrameCipher::acceleration(cipherSettings.algorithm)
+                  << "), índice " << cipherIndex.path() << std::endl;
+    }
+    std::cout << "Límite de escritura: " << bandwidthLimiter.describe() << std::endl;
+    std::cout << "Política de cola: " << queuePolicyName(queuePolicy) << std::endl;
+    std::cout << "Giro antes de dormir: " << describeQueueSpin(queueSpin) << std::endl;
+    std::cout << "Planificación: " << describeThreadTuning(threadTuning) << std::endl;
+    std::cout << "Reintentos de escritura: " << retryPolicy.maxAttempts << " desde "
+              << retryPolicy.baseDelay * 1000.0 << " ms";
+    if (!spillDir.empty()) std::cout << ", desvío a " << spillDir;
+    std::cout << std::endl;
+    if (watchdogSeconds > 0.0 && runtimeMode == "threads") {
+        std::cout << "Watchdog de escritores: bloqueo a los " << watchdogSeconds << " s" << std::endl;
+    }
+    if (simulate) std::cout << "Reloj: virtual (simulación)" << std::endl;
     std::cout << "===================" << std::endl;
     
     // Cola de imágenes compartida
     ThreadSafeQueue imageQueue;
+    imageQueue.setPolicy(queuePolicy);
+    imageQueue.setSpin(queueSpin);
     
-    // Contadores para estadísticas
-    std::atomic<size_t> statsImageCount{0};
-    std::atomic<size_t> statsBytesWritten{0};
-    std::atomic<size_t> imagesEnqueued{0};
-    std::atomic<size_t> imagesSaved{0};
-
+    std::unique_ptr<RetryQueue> retryQueue;
+    if (retryPolicy.maxAttempts > 0 || spillStorage) {
+        retryQueue = std::make_unique<RetryQueue>(*storage, retryPolicy, spillStorage.get(), stats,
+                                                  cipherSettings.index,
+                                                  bandwidthLimiter.enabled() ? &bandwidthLimiter : nullptr);
+    }
     
-    // Vector de hilos
-    std::vector<std::thread> threads;
+    // Calidad vigente, modificable en ejecución desde el canal de control
+    std::atomic<int> encoderQuality{encoderSettings.quality};
+
+    // Runtime de tareas: los fotogramas del generador se codifican y escriben como tareas
+    std::unique_ptr<TaskScheduler> scheduler;
+    std::unique_ptr<TaskPipeline> taskPipeline;
+    if (taskRuntime) {
+        scheduler = std::make_unique<TaskScheduler>(coreCount, threadTuning);
+        scheduler->setSpin(queueSpin.writers);
+        taskPipeline = std::make_unique<TaskPipeline>(*scheduler, *storage, encoderSettings, encoderQuality,
+                                                      cipherSettings, stats,
+                                                      bandwidthLimiter.enabled() ? &bandwidthLimiter : nullptr,
+                                                      retryQueue.get());
+        taskPipeline->setPolicy(queuePolicy);
+        if (!taskPipeline->isValid()) {
+            return 1;
+        }
+    }
+    FrameSink& frameSink = taskPipeline ? static_cast<FrameSink&>(*taskPipeline) : imageQueue;
+
+    // Runtime por núcleo: cada núcleo codifica y escribe en su propio hilo
+    std::unique_ptr<PerCoreRuntime> perCore;
+    if (perCoreRuntime) {
+        perCore = std::make_unique<PerCoreRuntime>(coreCount, threadTuning);
+        if (!perCore->prepare(*storage, encoderSettings, encoderQuality, cipherSettings, stats,
+                              bandwidthLimiter.enabled() ? &bandwidthLimiter : nullptr, retryQueue.get())) {
+            return 1;
+        }
+    }
+
+    // Con reloj virtual, el tiempo solo avanza cuando los escritores terminaron todo lo
+    // aceptado (no basta con la cola vacía: un fotograma sacado puede seguir escribiéndose)
+    virtualClock.setIdleWait([&frameSink](std::chrono::milliseconds timeout) { return frameSink.waitIdle(timeout); });
     
     // Tiempo de ejecución
     auto runDuration = std::chrono::seconds(runTime);
+    const auto runStart = clock.now();
+    
+    // Serie temporal: un hilo aparte muestrea los contadores en cada intervalo
+    TimeSeriesRecorder timeSeries(timeSeriesPath, timeSeriesInterval, stats, frameSink, clock);
+    if (!timeSeriesPath.empty()) {
+        if (!timeSeries.start()) {
+            return 1;
+        }
+        std::cout << "Serie temporal: " << timeSeries.describe() << std::endl;
+    }
+    
+    // Panel en la terminal: desde aquí la consola queda para él hasta el final
+    Dashboard dashboard(console, stats, frameSink, *storage, clock, runTime);
+    if (dashboardEnabled) {
+        dashboard.start();
+    }
+    
+    // Iniciar hilos escritores (sin ellos con el runtime de tareas)
+    WriterPool writers(imageQueue, *storage, encoderSettings, encoderQuality, cipherSettings, stats, threadTuning,
+                       bandwidthLimiter.enabled() ? &bandwidthLimiter : nullptr, retryQueue.get());
+    if (runtimeMode == "threads") {
+        writers.resize(numWriterThreads);
+        writers.startWatchdog(watchdogSeconds, kMaxWriterThreads + kWatchdogSpareThreads);
+    }
     
     // Iniciar hilo generador
-    threads.emplace_back(
-        imageGeneratorThread, 
-        std::ref(imageQueue), 
-        imageWidth, 
-        imageHeight, 
-        targetFPS, 
-        runDuration, 
-        std::ref(statsImageCount),
-        std::ref(imagesEnqueued)
-    );
-    
-    // Iniciar hilos escritores
-    for (int i = 0; i < numWriterThreads; i++) {
-        threads.emplace_back(
-            imageWriterThread, 
-            std::ref(imageQueue), 
-            outputDir, 
-            std::ref(statsBytesWritten),
-            std::ref(imagesSaved),
-            i + 1
-        );
-    }
-    
-    // Esperar que termine el tiempo
-    std::this_thread::sleep_for(runDuration);
+    std::thread generator([&] {
+        if (perCore) {
+            // El núcleo 0 usa el origen y el perfil principales; el resto, los suyos
+            perCore->run([&](int core, FrameSink& sink) {
+                std::unique_ptr<FrameSource> ownSource;
+                if (core > 0) {
+                    ownSource = createFrameSource(imageWidth, imageHeight, bankSize, encoderSettings.pixelFormat,
+                                                  kPrefaultSpareBlocks);
+                }
+                FrameSource& source = core > 0 ? *ownSource : *frameSource;
+                LoadProfile& profile = core > 0 ? *coreProfiles[core - 1] : loadProfile;
+                imageGeneratorThread(sink, source, profile, clock, runDuration, stats, firstSequence, core, coreCount);
+            });
+            return;
+        }
+        applyGeneratorTuning(threadTuning);
+        imageGeneratorThread(frameSink, *frameSource, loadProfile, clock, runDuration, stats, firstSequence);
+    });
+    startup.generatorStarted(*frameSource);
+    
+    // Canal de control: cambios en ejecución sin detener el pipeline
+    ControlServer control(controlPath);
+    if (!controlPath.empty()) {
+        control.addCommand("fps", "fps N|profile", [&](const std::string& args, std::string& reply) {
+            if (args == "profile") {
+                loadProfile.overrideRate(0.0);
+                for (auto& profile : coreProfiles) profile->overrideRate(0.0);
+                reply = "perfil: " + loadProfile.describe();
+                return true;
+            }
+            double fps = 0.0;
+            try { fps = std::stod(args); } catch (const std::exception&) {}
+            if (fps <= 0.0) {
+                reply = "FPS debe ser mayor que 0";
+                return false;
+            }
+            loadProfile.overrideRate(fps);
+            for (auto& profile : coreProfiles) profile->overrideRate(fps);
+            reply = "fps " + args;
+            return true;
+        });
+        control.addCommand("quality", "quality N", [&](const std::string& args, std::string& reply) {
+            int quality = 0;
+            try { quality = std::stoi(args); } catch (const std::exception&) {}
+            if (quality <= 0 || quality > 100) {
+                reply = "calidad debe estar entre 1 y 100";
+                return false;
+            }
+            encoderQuality = quality;
+            reply = "quality " + std::to_string(quality);
+            return true;
+        });
+        control.addCommand("writers", "writers N", [&](const std::string& args, std::string& reply) {
+            int count = 0;
+            try { count = std::stoi(args); } catch (const std::exception&) {}
+            if (runtimeMode != "threads") {
+                reply = "el runtime " + runtimeMode + " usa un hilo por núcleo (-cores)";
+                return false;
+            }
+            if (count <= 0 || count > kMaxWriterThreads) {
+                reply = "escritores debe estar entre 1 y " + std::to_string(kMaxWriterThreads);
+                return false;
+            }
+            writers.resize(count);
+            reply = "writers " + std::to_string(writers.size());
+            return true;
+        });
+        control.addCommand("policy", "policy drop-oldest|drop-newest|block", [&](const std::string& args, std::string& reply) {
+            QueuePolicy policy;
+            if (!parseQueuePolicy(args, policy)) {
+                reply = "política desconocida '" + args + "'";
+                return false;
+            }
+            imageQueue.setPolicy(policy);
+            if (taskPipeline) taskPipeline->setPolicy(policy);
+            reply = std::string("policy ") + queuePolicyName(policy);
+            return true;
+        });
+        control.addCommand("dir", "dir RUTA", [&](const std::string& args, std::string& reply) {
+            if (args.empty() || !createDirectoryIfNotExists(args)) {
+                reply = "no se pudo usar el directorio '" + args + "'";
+                return false;
+            }
+            if (!storage->setDirectory(args)) {
+                reply = "el destino actual no admite cambiar de directorio";
+                return false;
+            }
+            reply = "dir " + args;
+            return true;
+        });
+        control.addCommand("stats", "stats", [&](const std::string&, std::string& reply) {
+            const double elapsed = std::chrono::duration<double>(clock.now() - runStart).count();
+            const EventCountStats queueWait = imageQueue.waitStats();
+            std::ostringstream snapshot;
+            snapshot << std::fixed << std::setprecision(2)
+                     << "t=" << elapsed
+                     << " generadas=" << stats.imagesGenerated.load()
+                     << " encoladas=" << stats.imagesEnqueued.load()
+                     << " descartadas=" << frameSink.dropped()
+                     << " guardadas=" << stats.imagesSaved.load()
+                     << " bytes=" << stats.bytesWritten.load()
+                     << " cola=" << frameSink.size()
+                     << " escritores=" << (scheduler ? scheduler->size() : perCore ? perCore->size() : writers.size())
+                     << " fps_medios=" << (elapsed > 0 ? stats.imagesGenerated.load() / elapsed : 0.0)
+                     << " calidad=" << encoderQuality.load()
+                     << " espera_limitador_s=" << stats.throttleWaitNs.load() / 1e9
+                     << " bloqueados=" << writers.stalledCount()
+                     << " reintentos_pendientes=" << (retryQueue ? retryQueue->pending() : 0)
+                     << " perdidas=" << stats.writeFailures.load()
+                     << " futex_syscalls=" << (queueWait.wakeSyscalls + queueWait.waitSyscalls)
+                     << " politica=" << queuePolicyName(imageQueue.policy());
+            if (tieredStorage) snapshot << " aterrizaje=" << tieredStorage->landingBytes();
+            if (mirrorStorage) snapshot << " espejo_pendientes=" << mirrorStorage->backlog();
+            reply = snapshot.str();
+            // Con el panel activo, al registro del panel (std::cout se descarta)
+            console.log("[control] " + reply);
+            return true;
+        });
+        control.addCommand("rollover", "rollover", [&](const std::string&, std::string& reply) {
+            if (!storage->rollover()) {
+                reply = "sin efecto: el destino escribe un archivo por fotograma";
+                return true;
+            }
+            reply = "rollover";
+            return true;
+        });
+        if (!control.start()) {
+            std::cerr << "Aviso: se continúa sin canal de control" << std::endl;
+        } else {
+            std::cout << "Canal de control en " << controlPath << std::endl;
+        }
+    }
+    
+    // Esperar a que el generador complete la duración (medida con el reloj configurado)
+    const auto wallStart = std::chrono::steady_clock::now();
+    const double cpuStart = processCpuSeconds();
+    generator.join();
+    startup.stop();
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    const double cpuSeconds = processCpuSeconds() - cpuStart;
     
     // Finalizar cola y esperar a que terminen los hilos
     std::cout << "Tiempo completado. Finalizando..." << std::endl;
+    control.stop();
     imageQueue.finish();
-    
-    for (auto& thread : threads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+    writers.joinAll();
+    if (taskPipeline) {
+        taskPipeline->finish();
+        scheduler->shutdown();
+    }
+    if (retryQueue && retryQueue->pending() > 0) {
+        std::cout << "Reintentando " << retryQueue->pending() << " escrituras pendientes..." << std::endl;
+    }
+    if (retryQueue) {
+        retryQueue->drain();
+    }
+    if (mirrorStorage) {
+        mirrorStorage->drain();
+    }
+    if (erasureStorage) {
+        erasureStorage->drain();
     }
+    if (tieredStorage) {
+        // Los resultados incluyen lo que quedaba por migrar al terminar la generación
+        std::cout << "Migrando " << formatByteSize(tieredStorage->landingBytes()) << " pendientes del aterrizaje..." << std::endl;
+        tieredStorage->drain();
+    }
+    if (segmentStorage) {
+        segmentStorage->close();
+    }
+    timeSeries.stop();
+    dashboard.stop();
     
     // Mostrar estadísticas finales
     const double elapsedSeconds = runTime;
-    const size_t totalImages = statsImageCount.load();
-    const size_t totalBytes = statsBytesWritten.load();
+    const size_t totalImages = stats.imagesGenerated.load();
+    const size_t totalBytes = stats.bytesWritten.load();
     
     std::cout << "\n=== Resultados Finales ===" << std::endl;
     std::cout << "Tiempo total: " << elapsedSeconds << " segundos" << std::endl;
+    if (simulate) {
+        std::cout << "Tiempo real de simulación: " << std::fixed << std::setprecision(2) 
+                  << wallSeconds << " segundos (x" << (elapsedSeconds / std::max(wallSeconds, 1e-9)) << ")" << std::endl;
+    }
     std::cout << "Imágenes generadas: " << totalImages << std::endl;
-    std::cout << "Imágenes encoladas: " << imagesEnqueued.load() << std::endl;
-    std::cout << "Imágenes guardadas (total): " << imagesSaved.load() << std::endl;
+    std::cout << "Imágenes encoladas: " << stats.imagesEnqueued.load() << std::endl;
+    std::cout << "Imágenes descartadas por la cola: " << frameSink.dropped() << std::endl;
+    std::cout << "Imágenes guardadas (total): " << stats.imagesSaved.load() << std::endl;
+    std::cout << startup.report() << std::endl;
+    {
+        // Fracción de los núcleos ocupada por el proceso durante la generación (ambos runtimes)
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        std::cout << "Utilización de CPU: " << std::fixed << std::setprecision(1)
+                  << 100.0 * cpuSeconds / std::max(wallSeconds, 1e-9) / cores << "% de " << cores
+                  << " núcleos (" << cpuSeconds << " s de CPU)" << std::endl;
+    }
+    if (scheduler) {
+        std::cout << scheduler->report() << std::endl;
+    } else if (perCore) {
+        std::cout << perCore->report(wallSeconds) << std::endl;
+    } else {
+        // Coste de sincronización de la cola: syscalls de futex por fotograma encolado y,
+        // por etapa, tiempo girando y dormido y latencia desde la notificación hasta que
+        // el hilo en espera vuelve a ejecutarse
+        const EventCountStats wait = imageQueue.waitStats();
+        const size_t enqueued = std::max<size_t>(stats.imagesEnqueued.load(), 1);
+        std::cout << "Sincronización de la cola: " << std::fixed << std::setprecision(3)
+                  << static_cast<double>(wait.wakeSyscalls + wait.waitSyscalls) / enqueued
+                  << " syscalls futex por fotograma (" << wait.waitSyscalls << " esperas, "
+                  << wait.wakeSyscalls << " despertares, " << wait.skippedNotifies << " avisos sin esperas)" << std::endl;
+        auto stageWait = [](const char* name, const EventCountStats& stage) {
+            if (stage.spinWakeups + stage.parkedWakeups == 0) return;
+            std::cout << "  " << name << ": " << std::setprecision(2) << stage.spinNs / 1e9 << " s girando, "
+                      << stage.parkedNs / 1e9 << " s dormidos; " << stage.spinWakeups << " resueltas girando";
+            if (stage.spinWakeups > 0) {
+                std::cout << " (latencia media " << std::setprecision(1)
+                          << stage.spinLatencyNs / 1000.0 / stage.spinWakeups << " µs)";
+            }
+            std::cout << ", " << stage.parkedWakeups << " dormidas";
+            if (stage.parkedWakeups > 0) {
+                std::cout << " (latencia media " << std::setprecision(1)
+                          << stage.wakeLatencyNs / 1000.0 / stage.parkedWakeups << " µs, máxima "
+                          << stage.maxWakeLatencyNs / 1000.0 << " µs)";
+            }
+            std::cout << std::endl;
+        };
+        stageWait("Escritores", imageQueue.consumerWaitStats());
+        stageWait("Generador", imageQueue.producerWaitStats());
+    }
     std::cout << "Velocidad promedio: " << std::fixed << std::setprecision(2) 
               << (totalImages / elapsedSeconds) << " FPS" << std::endl;
+    std::cout << "Plazos incumplidos por el generador: " << stats.deadlineMisses.load() << " ("
+              << (totalImages > 0 ? 100.0 * stats.deadlineMisses.load() / totalImages : 0.0) << "%)" << std::endl;
+    std::cout << "Retraso máximo de activación del generador: " 
+              << stats.maxWakeupLatencyUs.load() / 1000.0 << " ms" << std::endl;
     std::cout << "Datos grabados: " << formatByteSize(totalBytes) << std::endl;
     std::cout << "Velocidad de escritura: " << formatByteSize(static_cast<size_t>(totalBytes / elapsedSeconds)) << "/s" << std::endl;
+    {
+        const LatencyHistogram::Counts encode = stats.encodeLatency.counts();
+        const LatencyHistogram::Counts write = stats.writeLatency.counts();
+        std::cout << "Latencia de codificación: p50 " << std::setprecision(0)
+                  << LatencyHistogram::percentileUs(encode, 0.50) << " µs, p99 "
+                  << LatencyHistogram::percentileUs(encode, 0.99) << " µs; de escritura: p50 "
+                  << LatencyHistogram::percentileUs(write, 0.50) << " µs, p99 "
+                  << LatencyHistogram::percentileUs(write, 0.99) << " µs" << std::setprecision(2) << std::endl;
+    }
+    if (!timeSeriesPath.empty()) {
+        std::cout << "Serie temporal: " << timeSeries.rows() << " filas en " << timeSeriesPath << std::endl;
+    }
+    if (cipherSettings.enabled) {
+        // Throughput por núcleo: bytes cifrados entre el tiempo de CPU sumado de todos los escritores
+        const double cipherSeconds = stats.cipherNs.load() / 1e9;
+        const double perCore = cipherSeconds > 0 ? stats.cipherBytes.load() / cipherSeconds : 0.0;
+        const double required = stats.cipherBytes.load() / elapsedSeconds;
+        std::cout << "Cifrado (" << cipherSettings.algorithm << "): " << formatByteSize(static_cast<size_t>(perCore))
+                  << "/s por núcleo, necesario " << formatByteSize(static_cast<size_t>(required)) << "/s ("
+                  << (required > 0 ? 100.0 * required / perCore : 0.0) << "% de un núcleo)" << std::endl;
+    }
+    if (bandwidthLimiter.enabled()) {
+        std::cout << "Escrituras retenidas por el limitador: " << stats.throttledWrites.load() << std::endl;
+        std::cout << "Espera en el limitador (suma de escritores): " 
+                  << stats.throttleWaitNs.load() / 1e9 << " s" << std::endl;
+    }
+    if (stats.writeRetries.load() > 0 || stats.writeFailures.load() > 0) {
+        std::cout << "Escrituras fallidas: " << stats.writeRetries.load() << " reintentos, "
+                  << stats.writeRecoveries.load() << " recuperadas, " << stats.writeSpills.load()
+                  << " desviadas, " << stats.writeFailures.load() << " perdidas" << std::endl;
+    }
+    if (stats.writerStalls.load() > 0) {
+        std::cout << "Escritores bloqueados (watchdog): " << stats.writerStalls.load() << ", reemplazados "
+                  << stats.writerReplacements.load() << ", desbloqueados después " << stats.writerRecoveries.load() << std::endl;
+    }
+    if (mirrorStorage) {
+        std::cout << mirrorStorage->report() << std::endl;
+    }
+    if (tieredStorage) {
+        std::cout << tieredStorage->report() << std::endl;
+    }
+    if (erasureStorage) {
+        std::cout << erasureStorage->report() << std::endl;
+    }
+    if (segmentStorage) {
+        std::cout << segmentStorage->report() << std::endl;
+    }
+    if (storageType == "memory" && !mirrorStorage) {
+        std::cout << "Destino: " << storage->describe() << std::endl;
+    }
     std::cout << "=========================" << std::endl;
     
     return 0;
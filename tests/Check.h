@@ -0,0 +1,96 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @file Check.h
+ * @brief Comprobaciones mínimas para las pruebas unitarias (un ejecutable por módulo, ver ctest).
+ *
+ * Cada comprobación fallida se informa con su archivo y línea y la prueba sigue; al
+ * final checkResult() devuelve el código de salida del ejecutable.
+ */
+
+/**
+ * @brief Comprobaciones fallidas en el ejecutable.
+ */
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+/**
+ * @brief Comprueba una condición; si falla, la informa y continúa.
+ */
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": falló " << #condition << std::endl; \
+            checkFailures()++;                                                               \
+        }                                                                                    \
+    } while (0)
+
+/**
+ * @brief Comprueba que dos valores reales difieran como mucho en `tolerance`.
+ */
+#define CHECK_NEAR(actual, expected, tolerance)                                              \
+    do {                                                                                     \
+        const double checkActual = (actual);                                                 \
+        const double checkExpected = (expected);                                             \
+        if (!(std::fabs(checkActual - checkExpected) <= (tolerance))) {                      \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << #actual << " = " << checkActual \
+                      << ", se esperaba " << checkExpected << std::endl;                     \
+            checkFailures()++;                                                               \
+        }                                                                                    \
+    } while (0)
+
+/**
+ * @brief Resultado del ejecutable de prueba.
+ * @param name Nombre de la prueba para el mensaje final.
+ * @return 0 si todas las comprobaciones pasaron, 1 en caso contrario.
+ */
+inline int checkResult(const char* name) {
+    if (checkFailures() == 0) {
+        std::cout << name << ": OK" << std::endl;
+        return 0;
+    }
+    std::cerr << name << ": " << checkFailures() << " comprobaciones fallidas" << std::endl;
+    return 1;
+}
+
+/**
+ * @class TempDirectory
+ * @brief Directorio temporal vacío que se borra al destruirse.
+ */
+class TempDirectory {
+public:
+    explicit TempDirectory(const std::string& name)
+        : path(std::filesystem::temp_directory_path() / (name + "_" + std::to_string(::getpid()))) {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    /**
+     * @brief Ruta de `file` dentro del directorio (o del directorio si está vacío).
+     */
+    std::string str(const std::string& file = "") const {
+        return file.empty() ? path.string() : (path / file).string();
+    }
+
+private:
+    std::filesystem::path path;
+};
+
+#endif // TESTS_CHECK_H
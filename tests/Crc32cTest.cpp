@@ -0,0 +1,67 @@
+/**
+ * @file Crc32cTest.cpp
+ * @brief Pruebas del CRC32C frente al valor de referencia y a una implementación bit a bit.
+ */
+
+#include "Check.h"
+#include "Crc32c.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief CRC32C bit a bit, sin tablas ni instrucciones específicas.
+ */
+uint32_t referenceCrc(const unsigned char* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+void testKnownValues() {
+    const char* check = "123456789";
+    CHECK(crc32c(check, std::strlen(check)) == 0xE3069283u);
+    CHECK(crc32c(nullptr, 0) == 0u);
+    // RFC 3720 (iSCSI), B.4: 32 bytes a cero y 32 bytes a 0xFF
+    std::vector<unsigned char> zeros(32, 0x00), ones(32, 0xFF);
+    CHECK(crc32c(zeros.data(), zeros.size()) == 0x8A9136AAu);
+    CHECK(crc32c(ones.data(), ones.size()) == 0x62A8AB43u);
+}
+
+void testMatchesReference() {
+    std::mt19937 rng(1234);
+    std::vector<unsigned char> data(4099);
+    for (auto& byte : data) byte = static_cast<unsigned char>(rng());
+    // Longitudes y alineaciones que recorren el bucle de 8 bytes y la cola
+    for (size_t offset = 0; offset < 9; offset++) {
+        for (size_t size : {size_t(0), size_t(1), size_t(7), size_t(8), size_t(9), size_t(63), size_t(4090)}) {
+            CHECK(crc32c(data.data() + offset, size) == referenceCrc(data.data() + offset, size));
+        }
+    }
+}
+
+void testChaining() {
+    std::vector<unsigned char> data(1000);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<unsigned char>(i * 31);
+    const uint32_t whole = crc32c(data.data(), data.size());
+    for (size_t split : {size_t(0), size_t(1), size_t(13), size_t(500), size_t(999), size_t(1000)}) {
+        const uint32_t first = crc32c(data.data(), split);
+        CHECK(crc32c(data.data() + split, data.size() - split, first) == whole);
+    }
+}
+
+} // namespace
+
+int main() {
+    testKnownValues();
+    testMatchesReference();
+    testChaining();
+    return checkResult("Crc32cTest");
+}
@@ -0,0 +1,98 @@
+/**
+ * @file ErasureCodeTest.cpp
+ * @brief Pruebas del código Reed-Solomon: codificar, borrar y reconstruir con cada núcleo.
+ */
+
+#include "Check.h"
+#include "ErasureCode.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Codifica K fragmentos aleatorios y reconstruye tras borrar cada combinación de
+ *        hasta M fragmentos, comparando con los originales.
+ * @param size Bytes por fragmento; los que no son múltiplo de 64 pasan por la cola escalar.
+ */
+void roundTrip(const std::string& kernel, int k, int m, size_t size) {
+    const ErasureCode code(k, m);
+    const int total = k + m;
+    std::mt19937 rng(static_cast<unsigned>(k * 1000 + m * 10 + size));
+    std::vector<std::vector<unsigned char>> original(total, std::vector<unsigned char>(size));
+    for (int i = 0; i < k; i++) {
+        for (auto& byte : original[i]) byte = static_cast<unsigned char>(rng());
+    }
+    std::vector<unsigned char*> pointers(total);
+    for (int i = 0; i < total; i++) pointers[i] = original[i].data();
+    code.encode(pointers.data(), pointers.data() + k, size);
+
+    // Todos los núcleos deben dar la misma paridad que el escalar
+    if (kernel != "escalar") {
+        ErasureCode::selectKernel("escalar");
+        std::vector<std::vector<unsigned char>> reference(m, std::vector<unsigned char>(size));
+        std::vector<unsigned char*> parity(m);
+        for (int i = 0; i < m; i++) parity[i] = reference[i].data();
+        code.encode(pointers.data(), parity.data(), size);
+        for (int i = 0; i < m; i++) CHECK(reference[i] == original[k + i]);
+        ErasureCode::selectKernel(kernel);
+    }
+
+    // Cada subconjunto de hasta M fragmentos perdidos (máscara de bits sobre K+M)
+    for (unsigned mask = 1; mask < (1u << total); mask++) {
+        int lost = 0;
+        for (int i = 0; i < total; i++) lost += (mask >> i) & 1;
+        if (lost > m) continue;
+
+        std::vector<std::vector<unsigned char>> shards = original;
+        std::vector<bool> present(total, true);
+        for (int i = 0; i < total; i++) {
+            if (mask & (1u << i)) {
+                present[i] = false;
+                std::fill(shards[i].begin(), shards[i].end(), 0xAA);
+            }
+        }
+        for (int i = 0; i < total; i++) pointers[i] = shards[i].data();
+        CHECK(code.reconstruct(pointers.data(), present, size));
+        for (int i = 0; i < total; i++) CHECK(shards[i] == original[i]);
+    }
+
+    // Con más de M pérdidas no se puede reconstruir
+    std::vector<bool> present(total, true);
+    for (int i = 0; i <= m; i++) present[i] = false;
+    for (int i = 0; i < total; i++) pointers[i] = original[i].data();
+    CHECK(!code.reconstruct(pointers.data(), present, size));
+}
+
+void testParseSpec() {
+    int k = 0, m = 0;
+    CHECK(ErasureCode::parseSpec("4+2", k, m) && k == 4 && m == 2);
+    CHECK(ErasureCode::parseSpec("10+4", k, m) && k == 10 && m == 4);
+    CHECK(!ErasureCode::parseSpec("4", k, m));
+    CHECK(!ErasureCode::parseSpec("0+2", k, m));
+    CHECK(!ErasureCode::parseSpec("4+0", k, m));
+    CHECK(!ErasureCode::parseSpec("200+100", k, m));
+}
+
+void testKernels() {
+    const std::vector<std::string> kernels = ErasureCode::availableKernels();
+    CHECK(!kernels.empty());
+    CHECK(!ErasureCode::selectKernel("inexistente"));
+    for (const auto& kernel : kernels) {
+        CHECK(ErasureCode::selectKernel(kernel));
+        CHECK(kernel == ErasureCode::kernelName());
+        roundTrip(kernel, 4, 2, 4096);
+        roundTrip(kernel, 3, 3, 1000);
+        roundTrip(kernel, 1, 1, 64);
+        roundTrip(kernel, 6, 3, 37);
+    }
+}
+
+} // namespace
+
+int main() {
+    testParseSpec();
+    testKernels();
+    return checkResult("ErasureCodeTest");
+}
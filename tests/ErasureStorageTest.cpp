@@ -0,0 +1,139 @@
+/**
+ * @file ErasureStorageTest.cpp
+ * @brief Pruebas del índice de franja del almacenamiento con código de borrado.
+ */
+
+#include "Check.h"
+#include "ErasureStorage.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+StripeIndex sampleIndex() {
+    StripeIndex index;
+    index.dataShards = 4;
+    index.parityShards = 2;
+    index.shardSize = 1024;
+    index.totalBytes = 3000;
+    index.entries.push_back({"image_t1_000000000001.jpg", 0, 1000});
+    index.entries.push_back({"image_t2_000000000002.jpg", 1000, 1500});
+    index.entries.push_back({"image_t1_000000000003.jpg", 2500, 500});
+    return index;
+}
+
+void testStripePath() {
+    CHECK(stripePath("/mnt/a", 7, -1) == "/mnt/a/stripe_00000007.idx");
+    CHECK(stripePath("/mnt/a", 7, 0) == "/mnt/a/stripe_00000007.s00");
+    CHECK(stripePath("/mnt/b", 12345678, 11) == "/mnt/b/stripe_12345678.s11");
+}
+
+void testIndexRoundTrip() {
+    TempDirectory directory("fastcap_stripeindex");
+    const std::string path = directory.str("stripe_00000000.idx");
+    const StripeIndex saved = sampleIndex();
+    CHECK(saved.save(path));
+
+    StripeIndex loaded;
+    CHECK(loaded.load(path));
+    CHECK(loaded.dataShards == saved.dataShards);
+    CHECK(loaded.parityShards == saved.parityShards);
+    CHECK(loaded.shardSize == saved.shardSize);
+    CHECK(loaded.totalBytes == saved.totalBytes);
+    CHECK(loaded.entries.size() == saved.entries.size());
+    for (size_t i = 0; i < loaded.entries.size() && i < saved.entries.size(); i++) {
+        CHECK(loaded.entries[i].name == saved.entries[i].name);
+        CHECK(loaded.entries[i].offset == saved.entries[i].offset);
+        CHECK(loaded.entries[i].size == saved.entries[i].size);
+    }
+
+    // Volver a cargar sustituye las entradas en lugar de acumularlas
+    CHECK(loaded.load(path));
+    CHECK(loaded.entries.size() == saved.entries.size());
+}
+
+void testRejectsIncomplete() {
+    TempDirectory directory("fastcap_stripeindex_bad");
+    StripeIndex index;
+    CHECK(!index.load(directory.str("missing.idx")));
+
+    // Índice cortado antes de la marca final
+    const std::string truncated = directory.str("truncated.idx");
+    CHECK(sampleIndex().save(truncated));
+    std::string content;
+    {
+        std::ifstream in(truncated);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(truncated, std::ios::trunc);
+        out << content.substr(0, content.rfind("end"));
+    }
+    CHECK(!index.load(truncated));
+
+    const std::string wrongMagic = directory.str("magic.idx");
+    {
+        std::ofstream out(wrongMagic);
+        out << "fastcap-ec 2\ngeometry 4 2 1024 0\nend\n";
+    }
+    CHECK(!index.load(wrongMagic));
+
+    const std::string unknownTag = directory.str("tag.idx");
+    {
+        std::ofstream out(unknownTag);
+        out << "fastcap-ec 1\ngeometry 4 2 1024 0\nextra 1\nend\n";
+    }
+    CHECK(!index.load(unknownTag));
+}
+
+void testWriteStripes() {
+    TempDirectory directory("fastcap_erasure_write");
+    std::vector<std::string> volumes;
+    for (int i = 0; i < 3; i++) {
+        volumes.push_back(directory.str("v" + std::to_string(i)));
+        std::filesystem::create_directories(volumes.back());
+    }
+    {
+        ErasureStorage storage(volumes, 2, 1, 1000);
+        // Una tasa inalcanzable hace que el informe avise
+        storage.setTargetRate(1e12);
+        const std::vector<unsigned char> frame(400, 7);
+        for (int i = 0; i < 10; i++) {
+            CHECK(storage.write("img_" + std::to_string(i) + ".jpg", frame));
+        }
+        storage.drain();
+        CHECK(!storage.write("tarde.jpg", frame));
+
+        // 2 fotogramas por franja: 5 franjas de 800 bytes, fragmentos de 448 (alineados a 64)
+        for (const auto& usage : storage.volumeUsage()) CHECK(usage.bytes == 5 * 448);
+        const std::string report = storage.report();
+        CHECK(report.find("Franjas escritas: 5,") != std::string::npos);
+        CHECK(report.find("Aviso: la paridad no alcanza") != std::string::npos);
+    }
+
+    for (const auto& volume : volumes) {
+        for (uint64_t stripe = 0; stripe < 5; stripe++) {
+            StripeIndex index;
+            CHECK(index.load(stripePath(volume, stripe, -1)));
+            CHECK(index.entries.size() == 2);
+            CHECK(!std::filesystem::exists(stripePath(volume, stripe, -1) + ".tmp"));
+        }
+    }
+    CHECK(std::filesystem::file_size(stripePath(volumes[2], 4, 2)) == 448);
+
+    // Una nueva ejecución continúa la numeración y la secuencia
+    ErasureStorage storage(volumes, 2, 1, 1000);
+    uint64_t next = 0;
+    CHECK(storage.recover(next));
+    CHECK(next == 10);
+}
+
+} // namespace
+
+int main() {
+    testStripePath();
+    testIndexRoundTrip();
+    testRejectsIncomplete();
+    testWriteStripes();
+    return checkResult("ErasureStorageTest");
+}
@@ -0,0 +1,111 @@
+/**
+ * @file EventCountTest.cpp
+ * @brief Pruebas de la primitiva de espera sobre futex.
+ */
+
+#include "Check.h"
+#include "EventCount.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Espera a que `flag` se active con el protocolo de EventCount.
+ */
+void waitFor(EventCount& ec, const std::atomic<bool>& flag) {
+    while (!flag.load()) {
+        const EventCount::Key key = ec.prepareWait();
+        if (flag.load()) {
+            ec.cancelWait();
+            break;
+        }
+        ec.wait(key);
+    }
+}
+
+void testNotifyWithoutWaiters() {
+    EventCount ec;
+    ec.notifyOne();
+    ec.notifyAll();
+    EventCountStats stats = ec.stats();
+    CHECK(stats.skippedNotifies == 2);
+    CHECK(stats.notifies == 0);
+    CHECK(stats.wakeSyscalls == 0);
+
+    // Una espera anulada no deja al hilo registrado
+    const EventCount::Key key = ec.prepareWait();
+    (void)key;
+    ec.cancelWait();
+    ec.notifyOne();
+    stats = ec.stats();
+    CHECK(stats.skippedNotifies == 3);
+    CHECK(stats.waitSyscalls == 0);
+}
+
+void testParkedWakeup() {
+    EventCount ec;
+    ec.setSpin(SpinPolicy{0, false});
+    CHECK(ec.spinBudgetNs() == 0);
+
+    std::atomic<bool> ready{false};
+    std::atomic<bool> woke{false};
+    std::thread waiter([&] {
+        waitFor(ec, ready);
+        woke = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(!woke.load());
+    ready = true;
+    ec.notifyOne();
+    waiter.join();
+    CHECK(woke.load());
+
+    const EventCountStats stats = ec.stats();
+    CHECK(stats.spinWakeups + stats.parkedWakeups == 1);
+    CHECK(stats.spinWakeups == 0);
+    CHECK(stats.waitSyscalls >= 1);
+    CHECK(stats.wakeSyscalls >= 1);
+}
+
+void testNotifyAll() {
+    EventCount ec;
+    ec.setSpin(SpinPolicy{1000, false});
+    std::atomic<bool> ready{false};
+    std::atomic<int> woke{0};
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; i++) {
+        waiters.emplace_back([&] {
+            waitFor(ec, ready);
+            woke++;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ready = true;
+    ec.notifyAll();
+    for (auto& waiter : waiters) waiter.join();
+    CHECK(woke.load() == 4);
+}
+
+void testStatsSum() {
+    EventCountStats a, b;
+    a.notifies = 2;
+    a.maxWakeLatencyNs = 10;
+    b.notifies = 3;
+    b.maxWakeLatencyNs = 30;
+    a += b;
+    CHECK(a.notifies == 5);
+    CHECK(a.maxWakeLatencyNs == 30);
+}
+
+} // namespace
+
+int main() {
+    testNotifyWithoutWaiters();
+    testParkedWakeup();
+    testNotifyAll();
+    testStatsSum();
+    return checkResult("EventCountTest");
+}
@@ -0,0 +1,141 @@
+/**
+ * @file FrameCipherTest.cpp
+ * @brief Pruebas del cifrado autenticado de fotogramas y del índice de nonces.
+ */
+
+#include "Check.h"
+#include "FrameCipher.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+CipherSettings sampleSettings(const std::string& algorithm) {
+    CipherSettings settings;
+    settings.enabled = true;
+    settings.algorithm = algorithm;
+    for (size_t i = 0; i < settings.key.size(); i++) settings.key[i] = static_cast<unsigned char>(i * 7 + 1);
+    settings.salt = 0x1234abcd;
+    return settings;
+}
+
+std::vector<unsigned char> sampleFrame() {
+    std::vector<unsigned char> frame(1000);
+    for (size_t i = 0; i < frame.size(); i++) frame[i] = static_cast<unsigned char>(i * 31);
+    return frame;
+}
+
+void testNonce() {
+    const CipherNonce nonce = makeCipherNonce(0x1234abcd, 0x0102030405060708ull);
+    CHECK(nonceToHex(nonce) == "1234abcd0102030405060708");
+    CipherNonce parsed{};
+    CHECK(nonceFromHex("1234ABCD0102030405060708", parsed) && parsed == nonce);
+    CHECK(!nonceFromHex("1234abcd01020304050607", parsed));
+    CHECK(!nonceFromHex("1234abcd01020304050607zz", parsed));
+}
+
+void testRoundTrip(const std::string& algorithm) {
+    const CipherSettings settings = sampleSettings(algorithm);
+    FrameCipher cipher(settings);
+    CHECK(cipher.isValid());
+    const std::string name = "img_00000042.jpg.enc";
+    const CipherNonce nonce = makeCipherNonce(settings.salt, 42);
+    const std::vector<unsigned char> original = sampleFrame();
+
+    std::vector<unsigned char> sealed = original;
+    CHECK(cipher.encrypt(sealed, nonce, name));
+    CHECK(sealed.size() == original.size() + kCipherTagSize);
+    CHECK(!std::equal(original.begin(), original.end(), sealed.begin()));
+
+    std::vector<unsigned char> buffer = sealed;
+    CHECK(cipher.decrypt(buffer, nonce, name));
+    CHECK(buffer == original);
+
+    // Otro contexto (como fastcap_decrypt) también verifica
+    FrameCipher reader(settings);
+    buffer = sealed;
+    CHECK(reader.decrypt(buffer, nonce, name));
+    CHECK(buffer == original);
+
+    // Etiqueta alterada
+    buffer = sealed;
+    buffer.back() ^= 0x01;
+    CHECK(!reader.decrypt(buffer, nonce, name));
+
+    // Cifrado alterado
+    buffer = sealed;
+    buffer[10] ^= 0x80;
+    CHECK(!reader.decrypt(buffer, nonce, name));
+
+    // Archivo renombrado: el nombre es dato asociado
+    buffer = sealed;
+    CHECK(!reader.decrypt(buffer, nonce, "img_00000043.jpg.enc"));
+
+    // Nonce de otro fotograma o clave distinta
+    buffer = sealed;
+    CHECK(!reader.decrypt(buffer, makeCipherNonce(settings.salt, 43), name));
+    CipherSettings otherKey = settings;
+    otherKey.key[0] ^= 0xff;
+    FrameCipher wrong(otherKey);
+    buffer = sealed;
+    CHECK(!wrong.decrypt(buffer, nonce, name));
+
+    // Más corto que la etiqueta
+    buffer.assign(kCipherTagSize - 1, 0);
+    CHECK(!reader.decrypt(buffer, nonce, name));
+}
+
+void testKeyId() {
+    const CipherSettings settings = sampleSettings("aes-256-gcm");
+    const std::string id = cipherKeyId(settings.key);
+    CHECK(id.size() == 16);
+    CHECK(id == cipherKeyId(settings.key));
+    CipherSettings other = settings;
+    other.key[31] ^= 0x01;
+    CHECK(cipherKeyId(other.key) != id);
+}
+
+void testIndex() {
+    TempDirectory directory("fastcap_cipherindex");
+    const std::string path = directory.str("cipher.idx");
+    const CipherSettings settings = sampleSettings("chacha20-poly1305");
+
+    CipherIndex index;
+    CHECK(index.open(path, settings));
+    index.record("img_00000001.raw.enc", makeCipherNonce(settings.salt, 1), 116);
+
+    // Cabecera y línea están en el archivo sin esperar a close()
+    std::ifstream in(path);
+    std::string header, line, extra;
+    CHECK(std::getline(in, header));
+    CHECK(header == "run 1234abcd " + cipherKeyId(settings.key) + " chacha20-poly1305");
+    CHECK(std::getline(in, line));
+    CHECK(line == "img_00000001.raw.enc 1234abcd0000000000000001 116");
+    CHECK(!std::getline(in, extra));
+    index.close();
+
+    // Una segunda ejecución añade su propia cabecera
+    CipherSettings second = settings;
+    second.salt = 0x00000007;
+    CipherIndex next;
+    CHECK(next.open(path, second));
+    next.close();
+    std::ifstream again(path);
+    std::ostringstream content;
+    content << again.rdbuf();
+    CHECK(content.str().find("\nrun 00000007 ") != std::string::npos);
+
+    CipherIndex missing;
+    CHECK(!missing.open(directory.str("no/existe/cipher.idx"), settings));
+}
+
+} // namespace
+
+int main() {
+    testNonce();
+    testRoundTrip("aes-256-gcm");
+    testRoundTrip("chacha20-poly1305");
+    testKeyId();
+    testIndex();
+    return checkResult("FrameCipherTest");
+}
@@ -0,0 +1,129 @@
+/**
+ * @file LoadProfileTest.cpp
+ * @brief Pruebas del intérprete de perfiles de carga y de la curva de tasa.
+ */
+
+#include "Check.h"
+#include "LoadProfile.h"
+
+namespace {
+
+double seconds(std::chrono::microseconds interval) {
+    return std::chrono::duration<double>(interval).count();
+}
+
+void testParse() {
+    LoadProfile profile;
+    CHECK(LoadProfile::parse("step 10 30; ramp 20 30 120\n# comentario\nburst 10 5 50 1 4 # ráfagas", profile));
+    CHECK_NEAR(profile.duration(), 40.0, 1e-9);
+    CHECK(!profile.isConstant());
+
+    // Guiones inválidos: el perfil anterior se conserva
+    CHECK(!LoadProfile::parse("", profile));
+    CHECK(!LoadProfile::parse("# solo comentarios", profile));
+    CHECK(!LoadProfile::parse("walk 10 30", profile));
+    CHECK(!LoadProfile::parse("step 10", profile));
+    CHECK(!LoadProfile::parse("step 0 30", profile));
+    CHECK(!LoadProfile::parse("step 10 -1", profile));
+    CHECK(!LoadProfile::parse("burst 10 5 50 5 4", profile));
+    CHECK(!LoadProfile::parse("burst 10 5 50 1 0", profile));
+    CHECK_NEAR(profile.duration(), 40.0, 1e-9);
+}
+
+void testRateCurve() {
+    LoadProfile profile;
+    CHECK(LoadProfile::parse("step 10 30; ramp 20 30 120; burst 10 5 50 1 4", profile));
+    CHECK_NEAR(profile.rateAt(0.0), 30.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(9.9), 30.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(10.0), 30.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(20.0), 75.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(29.999), 120.0, 0.1);
+    // Ráfaga: pico durante el primer segundo de cada periodo de 4 s
+    CHECK_NEAR(profile.rateAt(30.5), 50.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(32.0), 5.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(34.5), 50.0, 1e-9);
+    // Sin repeat el último tramo se mantiene
+    CHECK_NEAR(profile.rateAt(1002.5), 50.0, 1e-9);
+
+    CHECK(LoadProfile::parse("step 1 10; step 1 20; repeat", profile));
+    CHECK_NEAR(profile.rateAt(0.5), 10.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(1.5), 20.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(2.5), 10.0, 1e-9);
+    CHECK_NEAR(profile.rateAt(101.5), 20.0, 1e-9);
+    CHECK_NEAR(profile.peakRate(), 20.0, 1e-9);
+
+    CHECK(LoadProfile::parse("ramp 10 120 30; burst 10 5 150 1 4; poisson 5 60", profile));
+    CHECK_NEAR(profile.peakRate(), 150.0, 1e-9);
+}
+
+void testIntervals() {
+    LoadProfile constant(50.0);
+    CHECK(constant.isConstant());
+    CHECK(constant.nextInterval(0.0) == std::chrono::microseconds(20000));
+
+    // Una rampa desde reposo no tiene llegadas en t=0
+    LoadProfile ramp;
+    CHECK(LoadProfile::parse("ramp 10 0 100", ramp));
+    const auto first = ramp.nextInterval(0.0);
+    // Primera llegada cuando la tasa integrada (5·t²) llega a 1
+    CHECK_NEAR(seconds(first), std::sqrt(0.2), 1e-3);
+    double t = 0.0;
+    int arrivals = 0;
+    while (t < 10.0) {
+        t += seconds(ramp.nextInterval(t));
+        arrivals++;
+    }
+    // Integral de la rampa: 500 llegadas
+    CHECK(arrivals >= 499 && arrivals <= 502);
+
+    // Un tramo a tasa 0 se salta hasta el siguiente cambio de tasa
+    LoadProfile idle;
+    CHECK(LoadProfile::parse("step 2 0; step 10 10", idle));
+    CHECK_NEAR(seconds(idle.nextInterval(0.0)), 2.1, 1e-3);
+
+    // Sin llegadas en todo el guion
+    LoadProfile silent;
+    CHECK(LoadProfile::parse("step 5 0", silent));
+    CHECK(silent.nextInterval(0.0) == std::chrono::microseconds::max());
+
+    // Las llegadas de Poisson son reproducibles con la misma semilla
+    LoadProfile a, b;
+    CHECK(LoadProfile::parse("poisson 60 100", a));
+    CHECK(LoadProfile::parse("poisson 60 100", b));
+    a.setSeed(7);
+    b.setSeed(7);
+    double total = 0.0;
+    bool same = true;
+    for (int i = 0; i < 1000; i++) {
+        const auto interval = a.nextInterval(total);
+        same = same && interval == b.nextInterval(total);
+        total += seconds(interval);
+    }
+    CHECK(same);
+    // 1000 llegadas a 100 FPS de media: unos 10 s
+    CHECK(total > 8.0 && total < 12.0);
+}
+
+void testOverride() {
+    LoadProfile profile;
+    CHECK(LoadProfile::parse("ramp 10 0 100", profile));
+    profile.overrideRate(25.0);
+    CHECK(profile.isConstant());
+    CHECK_NEAR(profile.rateAt(5.0), 25.0, 1e-9);
+    CHECK_NEAR(profile.peakRate(), 25.0, 1e-9);
+    CHECK(profile.nextInterval(5.0) == std::chrono::microseconds(40000));
+    profile.overrideRate(0.0);
+    CHECK(!profile.isConstant());
+    CHECK_NEAR(profile.rateAt(5.0), 50.0, 1e-9);
+    CHECK_NEAR(profile.peakRate(), 100.0, 1e-9);
+}
+
+} // namespace
+
+int main() {
+    testParse();
+    testRateCurve();
+    testIntervals();
+    testOverride();
+    return checkResult("LoadProfileTest");
+}
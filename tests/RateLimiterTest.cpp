@@ -0,0 +1,60 @@
+/**
+ * @file RateLimiterTest.cpp
+ * @brief Pruebas de la cubeta de fichas del limitador de ancho de banda.
+ */
+
+#include "Check.h"
+#include "RateLimiter.h"
+
+namespace {
+
+Clock::time_point at(double seconds) {
+    return Clock::time_point() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+void testDisabled() {
+    TokenBucket bucket;
+    CHECK(!bucket.enabled());
+    CHECK_NEAR(bucket.reserve(1e9, at(0.0)), 0.0, 0.0);
+}
+
+void testReserve() {
+    TokenBucket bucket(100.0, 50.0);
+    CHECK(bucket.enabled());
+
+    // La cubeta empieza llena: la ráfaga no espera
+    CHECK_NEAR(bucket.reserve(50.0, at(1.0)), 0.0, 1e-12);
+    // Sin saldo, la reserva queda en deuda y devuelve la espera para saldarla
+    CHECK_NEAR(bucket.reserve(10.0, at(1.0)), 0.1, 1e-9);
+    // Las deudas se acumulan en orden de llegada
+    CHECK_NEAR(bucket.reserve(10.0, at(1.0)), 0.2, 1e-9);
+    // 0.3 s después se saldó la deuda y sobran 10 fichas
+    CHECK_NEAR(bucket.reserve(10.0, at(1.3)), 0.0, 1e-9);
+    CHECK_NEAR(bucket.reserve(1.0, at(1.3)), 0.01, 1e-9);
+}
+
+void testBurstCap() {
+    TokenBucket bucket(100.0, 50.0);
+    CHECK_NEAR(bucket.reserve(50.0, at(0.0)), 0.0, 1e-12);
+    // Tras mucho tiempo ocioso el saldo no pasa de la ráfaga
+    CHECK_NEAR(bucket.reserve(60.0, at(100.0)), 0.1, 1e-9);
+    // Una petición mayor que la ráfaga también avanza
+    CHECK_NEAR(bucket.reserve(500.0, at(200.0)), 4.5, 1e-9);
+}
+
+void testClockNeverRewinds() {
+    TokenBucket bucket(10.0, 10.0);
+    CHECK_NEAR(bucket.reserve(10.0, at(5.0)), 0.0, 1e-12);
+    // Un instante anterior no repone fichas
+    CHECK_NEAR(bucket.reserve(1.0, at(4.0)), 0.1, 1e-9);
+}
+
+} // namespace
+
+int main() {
+    testDisabled();
+    testReserve();
+    testBurstCap();
+    testClockNeverRewinds();
+    return checkResult("RateLimiterTest");
+}
@@ -0,0 +1,196 @@
+/**
+ * @file SegmentStorageTest.cpp
+ * @brief Pruebas de la recuperación de segmentos y del checkpoint.
+ */
+
+#include "Check.h"
+#include "SegmentStorage.h"
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Fila de `segments.ckpt`.
+ */
+struct CheckpointRow {
+    uint64_t length = 0;
+    uint64_t records = 0;
+    uint64_t maxSequence = 0;
+};
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+/**
+ * @brief Tabla del checkpoint y su secuencia siguiente (sin comprobar el CRC).
+ */
+std::map<uint64_t, CheckpointRow> readCheckpoint(const std::string& directory, uint64_t& next) {
+    std::map<uint64_t, CheckpointRow> table;
+    std::istringstream lines(readFile(directory + "/segments.ckpt"));
+    std::string tag;
+    next = 0;
+    while (lines >> tag) {
+        if (tag == "segment") {
+            uint64_t number = 0;
+            CheckpointRow row;
+            lines >> number >> row.length >> row.records >> row.maxSequence;
+            table[number] = row;
+        } else if (tag == "next") {
+            lines >> next;
+        }
+    }
+    return table;
+}
+
+/// Bytes de un registro de la prueba: cabecera, nombre de 12 bytes y contenido.
+size_t recordSize(size_t payload) {
+    return sizeof(SegmentRecordHeader) + 12 + payload;
+}
+
+/**
+ * @brief Escribe `count` registros de `payload` bytes desde la secuencia `first`.
+ */
+void writeRecords(SegmentStorage& storage, uint64_t first, int count, size_t payload) {
+    for (int i = 0; i < count; i++) {
+        const uint64_t sequence = first + static_cast<uint64_t>(i);
+        auto data = std::make_shared<std::vector<unsigned char>>(payload, static_cast<unsigned char>(sequence));
+        char name[16];
+        std::snprintf(name, sizeof(name), "img_%08llu", static_cast<unsigned long long>(sequence));
+        FrameMeta meta;
+        meta.sequence = sequence;
+        meta.timestampNs = static_cast<int64_t>(sequence) * 1000000;
+        CHECK(storage.writeFrame(name, data, meta));
+    }
+}
+
+std::string segmentFile(const TempDirectory& directory, int number) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "seg_%08d.dat", number);
+    return directory.str(name);
+}
+
+void testTruncatedRecord() {
+    TempDirectory directory("fastcap_segments_trunc");
+    constexpr size_t kPayload = 1000;
+    {
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+        uint64_t next = 0;
+        CHECK(!storage.recover(next));
+        writeRecords(storage, 0, 10, kPayload);
+    }
+    uint64_t next = 0;
+    auto table = readCheckpoint(directory.str(), next);
+    CHECK(table.size() == 1);
+    CHECK(table[0].length == 10 * recordSize(kPayload));
+    CHECK(table[0].records == 10);
+    CHECK(next == 10);
+
+    // Segunda ejecución cortada: sus registros están en disco pero el checkpoint
+    // es el de la primera, y el último registro quedó a medias
+    const std::string firstCheckpoint = readFile(directory.str("segments.ckpt"));
+    {
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+        CHECK(storage.recover(next));
+        writeRecords(storage, 10, 5, kPayload);
+    }
+    writeFile(directory.str("segments.ckpt"), firstCheckpoint);
+    const uint64_t cut = 4 * recordSize(kPayload) + recordSize(kPayload) / 2;
+    std::filesystem::resize_file(segmentFile(directory, 1), cut);
+
+    {
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+        uint64_t sequence = 0;
+        CHECK(storage.recover(sequence));
+        CHECK(sequence == 14);
+        // El segmento se trunca al último registro completo
+        CHECK(std::filesystem::file_size(segmentFile(directory, 1)) == 4 * recordSize(kPayload));
+        CHECK(std::filesystem::file_size(segmentFile(directory, 0)) == 10 * recordSize(kPayload));
+
+        // recover() deja guardado el checkpoint con la tabla recuperada
+        table = readCheckpoint(directory.str(), next);
+        CHECK(table.size() == 2);
+        CHECK(table[0].length == 10 * recordSize(kPayload));
+        CHECK(table[0].records == 10);
+        CHECK(table[0].maxSequence == 9);
+        CHECK(table[1].length == 4 * recordSize(kPayload));
+        CHECK(table[1].records == 4);
+        CHECK(table[1].maxSequence == 13);
+        CHECK(next == 14);
+    }
+
+    // Un segmento confirmado por el checkpoint que luego se corta se vuelve a verificar
+    std::filesystem::resize_file(segmentFile(directory, 0), 3 * recordSize(kPayload) + 7);
+    {
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+        uint64_t sequence = 0;
+        CHECK(storage.recover(sequence));
+        CHECK(sequence == 14);
+        table = readCheckpoint(directory.str(), next);
+        CHECK(table[0].length == 3 * recordSize(kPayload));
+        CHECK(table[0].records == 3);
+        CHECK(table[0].maxSequence == 2);
+    }
+}
+
+void testCheckpointWaitsForRecovery() {
+    TempDirectory directory("fastcap_segments_race");
+    {
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+        writeRecords(storage, 0, 20, 100);
+    }
+    const std::string good = readFile(directory.str("segments.ckpt"));
+
+    {
+        // Con checkpoints cada milisegundo, nada debe escribirse antes de recover()
+        SegmentStorage storage(directory.str(), 1 << 20, 0.001, 0.0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK(readFile(directory.str("segments.ckpt")) == good);
+
+        uint64_t sequence = 0;
+        CHECK(storage.recover(sequence));
+        CHECK(sequence == 20);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    // Tras cerrar no queda ningún checkpoint a medio escribir
+    uint64_t next = 0;
+    const auto table = readCheckpoint(directory.str(), next);
+    CHECK(table.size() == 1);
+    CHECK(table.count(0) == 1 && table.at(0).records == 20);
+    CHECK(next == 20);
+    CHECK(!std::filesystem::exists(directory.str("segments.ckpt.tmp")));
+}
+
+void testCloseWithoutRecoveryKeepsCheckpoint() {
+    TempDirectory directory("fastcap_segments_close");
+    {
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+        writeRecords(storage, 0, 3, 100);
+    }
+    const std::string good = readFile(directory.str("segments.ckpt"));
+    {
+        // Un arranque que falla antes de recuperar no sustituye el checkpoint
+        SegmentStorage storage(directory.str(), 1 << 20, 3600.0, 0.0);
+    }
+    CHECK(readFile(directory.str("segments.ckpt")) == good);
+}
+
+} // namespace
+
+int main() {
+    testTruncatedRecord();
+    testCheckpointWaitsForRecovery();
+    testCloseWithoutRecoveryKeepsCheckpoint();
+    return checkResult("SegmentStorageTest");
+}
@@ -0,0 +1,144 @@
+/**
+ * @file TimeIndexTest.cpp
+ * @brief Pruebas del índice temporal: bloques, búsqueda, desorden admitido y recorte.
+ */
+
+#include "Check.h"
+#include "TimeIndex.h"
+#include <vector>
+
+namespace {
+
+constexpr int64_t kSecond = 1000000000;
+
+/**
+ * @brief Entradas que pueden contener marcas en [from, to], como en fastcap_timequery.
+ */
+std::vector<size_t> query(const TimeIndexReader& index, int64_t from, int64_t to) {
+    std::vector<size_t> found;
+    for (size_t i = index.lowerBound(from); i < index.size(); i++) {
+        const TimeIndexEntry& entry = index[i];
+        if (entry.minTs > to + index.slackNs()) break;
+        if (entry.maxTs >= from && entry.minTs <= to) found.push_back(i);
+    }
+    return found;
+}
+
+void testBlocksAndLookup() {
+    TempDirectory directory("fastcap_timeindex");
+    const std::string path = directory.str("time.idx");
+    {
+        TimeIndexWriter writer;
+        CHECK(writer.open(path, kSecond, kSecond / 2));
+        // Registros de 100 bytes cada 0.5 s: dos por entrada de 1 s
+        for (int i = 0; i < 20; i++) {
+            CHECK(writer.add(0, static_cast<uint64_t>(i) * 100, 100, i * kSecond / 2));
+        }
+        // Cambio de segmento: nueva entrada aunque no haya pasado el intervalo
+        CHECK(writer.add(1, 0, 100, 10 * kSecond));
+        writer.close();
+        CHECK(writer.entries() == 11);
+    }
+
+    TimeIndexReader index;
+    CHECK(index.open(path));
+    CHECK(index.size() == 11);
+    if (index.size() != 11) return;
+    CHECK(index.slackNs() == kSecond / 2);
+    for (size_t i = 0; i < 10; i++) {
+        CHECK(index[i].segment == 0);
+        CHECK(index[i].offset == i * 200);
+        CHECK(index[i].length == 200);
+        CHECK(index[i].minTs == static_cast<int64_t>(i) * kSecond);
+        CHECK(index[i].maxTs == static_cast<int64_t>(i) * kSecond + kSecond / 2);
+    }
+    CHECK(index[10].segment == 1);
+    CHECK(index[10].offset == 0);
+
+    CHECK(index.lowerBound(-kSecond) == 0);
+    CHECK(index.lowerBound(3 * kSecond + kSecond / 5) == 3);
+    CHECK(index.lowerBound(3 * kSecond + kSecond / 2) == 3);
+    CHECK(index.lowerBound(3 * kSecond + kSecond * 6 / 10) == 4);
+    CHECK(index.lowerBound(11 * kSecond) == index.size());
+
+    const std::vector<size_t> found = query(index, 4 * kSecond, 5 * kSecond);
+    CHECK(found == std::vector<size_t>({4, 5}));
+}
+
+void testOutOfOrder() {
+    TempDirectory directory("fastcap_timeindex_order");
+    const std::string path = directory.str("time.idx");
+    {
+        TimeIndexWriter writer;
+        CHECK(writer.open(path, kSecond, kSecond));
+        // Un escritor lento termina el fotograma de 2.2 s después del de 3.1 s
+        CHECK(writer.add(0, 0, 10, 0));
+        CHECK(writer.add(0, 10, 10, kSecond + kSecond / 10));
+        CHECK(writer.add(0, 20, 10, 3 * kSecond + kSecond / 10));
+        CHECK(writer.add(0, 30, 10, 2 * kSecond + kSecond / 5));
+        CHECK(writer.add(0, 40, 10, 4 * kSecond));
+        writer.close();
+    }
+
+    TimeIndexReader index;
+    CHECK(index.open(path));
+    CHECK(index.size() == 4);
+    if (index.size() != 4) return;
+    // upToTs crece aunque las marcas no lo hagan
+    for (size_t i = 1; i < index.size(); i++) {
+        CHECK(index[i].upToTs >= index[i - 1].upToTs);
+    }
+    // El registro de 2.2 s está en un bloque posterior al de 3.1 s y la búsqueda lo encuentra
+    const std::vector<size_t> found = query(index, 2 * kSecond, 2 * kSecond + kSecond / 2);
+    bool late = false;
+    for (size_t i : found) {
+        late = late || (index[i].minTs <= 2 * kSecond + kSecond / 5 && index[i].maxTs >= 2 * kSecond + kSecond / 5);
+    }
+    CHECK(late);
+}
+
+void testTrimAndReopen() {
+    TempDirectory directory("fastcap_timeindex_trim");
+    const std::string path = directory.str("time.idx");
+    {
+        TimeIndexWriter writer;
+        CHECK(writer.open(path, kSecond, 0));
+        for (int i = 0; i < 10; i++) {
+            CHECK(writer.add(0, static_cast<uint64_t>(i) * 100, 100, i * kSecond));
+        }
+        writer.close();
+    }
+
+    TimeIndexWriter writer;
+    CHECK(writer.open(path, kSecond, 0));
+    CHECK(writer.entries() == 10);
+    // El segmento se truncó al recuperar: solo quedan 550 bytes válidos
+    uint64_t segment = 99, offset = 0;
+    CHECK(writer.trim([](uint64_t) { return uint64_t(550); }, segment, offset));
+    CHECK(writer.entries() == 5);
+    CHECK(segment == 0);
+    CHECK(offset == 500);
+    // Se sigue indexando tras la última entrada conservada
+    CHECK(writer.add(0, 500, 50, 5 * kSecond));
+    writer.close();
+
+    TimeIndexReader index;
+    CHECK(index.open(path));
+    CHECK(index.size() == 6);
+    if (index.size() == 6) CHECK(index[5].length == 50);
+
+    // Sin datos válidos no queda ninguna entrada
+    TimeIndexWriter empty;
+    CHECK(empty.open(path, kSecond, 0));
+    CHECK(!empty.trim([](uint64_t) { return uint64_t(0); }, segment, offset));
+    CHECK(empty.entries() == 0);
+}
+
+} // namespace
+
+int main() {
+    testBlocksAndLookup();
+    testOutOfOrder();
+    testTrimAndReopen();
+    return checkResult("TimeIndexTest");
+}
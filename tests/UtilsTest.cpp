@@ -0,0 +1,62 @@
+/**
+ * @file UtilsTest.cpp
+ * @brief Pruebas de la interpretación y el formato de tamaños y de los nombres de archivo.
+ */
+
+#include "Check.h"
+#include "Utils.h"
+
+namespace {
+
+void testParseByteSize() {
+    size_t bytes = 0;
+    CHECK(parseByteSize("4096", bytes) && bytes == 4096);
+    CHECK(parseByteSize("0", bytes) && bytes == 0);
+    CHECK(parseByteSize("200M", bytes) && bytes == 200ull << 20);
+    CHECK(parseByteSize("1.5K", bytes) && bytes == 1536);
+    CHECK(parseByteSize("2k", bytes) && bytes == 2048);
+    CHECK(parseByteSize("1.5GB", bytes) && bytes == 3ull << 29);
+    CHECK(parseByteSize("4GiB", bytes) && bytes == 4ull << 30);
+    CHECK(parseByteSize("1T", bytes) && bytes == 1ull << 40);
+    CHECK(parseByteSize("512B", bytes) && bytes == 512);
+    CHECK(parseByteSize("10mib", bytes) && bytes == 10ull << 20);
+
+    bytes = 77;
+    CHECK(!parseByteSize("", bytes));
+    CHECK(!parseByteSize("abc", bytes));
+    CHECK(!parseByteSize("-1", bytes));
+    CHECK(!parseByteSize("5X", bytes));
+    CHECK(!parseByteSize("5 M", bytes));
+    CHECK(!parseByteSize("5MM", bytes));
+    // Un texto inválido no modifica el resultado
+    CHECK(bytes == 77);
+}
+
+void testFormatByteSize() {
+    CHECK(formatByteSize(0) == "0.00 B");
+    CHECK(formatByteSize(1023) == "1023.00 B");
+    CHECK(formatByteSize(1024) == "1.00 KB");
+    CHECK(formatByteSize(1536ull << 20) == "1.50 GB");
+    CHECK(formatByteSize(5ull << 50) == "5120.00 TB");
+}
+
+void testIsPlainFileName() {
+    CHECK(isPlainFileName("img_00000001_t1.jpg"));
+    CHECK(isPlainFileName("..jpg"));
+    CHECK(!isPlainFileName(""));
+    CHECK(!isPlainFileName("."));
+    CHECK(!isPlainFileName(".."));
+    CHECK(!isPlainFileName("../victima"));
+    CHECK(!isPlainFileName("/etc/passwd"));
+    CHECK(!isPlainFileName("sub/img.jpg"));
+    CHECK(!isPlainFileName(std::string("img\0.jpg", 8)));
+}
+
+} // namespace
+
+int main() {
+    testParseByteSize();
+    testFormatByteSize();
+    testIsPlainFileName();
+    return checkResult("UtilsTest");
+}
@@ -0,0 +1,193 @@
+/**
+ * @file decrypt.cpp
+ * @brief Herramienta para verificar y descifrar fotogramas grabados con -encrypt.
+ *
+ * Recorre el índice de nonces, comprueba la etiqueta de autenticación de cada archivo
+ * y, opcionalmente, guarda el fotograma descifrado. La cabecera de cada ejecución del
+ * índice indica su sal, el identificador de la clave y el algoritmo.
+ */
+
+#include "FrameCipher.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Muestra el uso de la herramienta.
+ */
+void showDecryptUsage(const std::string& programName) {
+    std::cout << "Uso: " << programName << " -key K -dir DIR [-index P] [-cipher A] [-out DIR]" << std::endl;
+    std::cout << "Opciones:" << std::endl;
+    std::cout << "  -key K     Archivo de clave usado en la grabación" << std::endl;
+    std::cout << "  -dir DIR   Directorio con los fotogramas cifrados; se repite para buscar también en" << std::endl;
+    std::cout << "             -spill o en el aterrizaje de -tier, en el orden indicado" << std::endl;
+    std::cout << "  -index P   Índice de nonces (por defecto: cipher.idx del primer -dir)" << std::endl;
+    std::cout << "  -cipher A  aes-256-gcm o chacha20-poly1305 para índices sin cabecera (por defecto: aes-256-gcm)" << std::endl;
+    std::cout << "  -out DIR   Guarda los fotogramas descifrados en DIR (sin la extensión .enc)" << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief Función principal de la herramienta de descifrado.
+ */
+int main(int argc, char** argv) {
+    CipherSettings settings;
+    std::string keyPath, indexPath, outputDir;
+    std::vector<std::string> directories;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            showDecryptUsage(argv[0]);
+            return 0;
+        } else if (arg == "-key" && i + 1 < argc) {
+            keyPath = argv[++i];
+        } else if (arg == "-dir" && i + 1 < argc) {
+            directories.push_back(argv[++i]);
+        } else if (arg == "-index" && i + 1 < argc) {
+            indexPath = argv[++i];
+        } else if (arg == "-cipher" && i + 1 < argc) {
+            settings.algorithm = argv[++i];
+        } else if (arg == "-out" && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else {
+            std::cerr << "Argumento desconocido: " << arg << std::endl;
+            showDecryptUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (keyPath.empty() || directories.empty()) {
+        showDecryptUsage(argv[0]);
+        return 1;
+    }
+    if (!FrameCipher::isValidAlgorithm(settings.algorithm)) {
+        std::cerr << "Error: Cifrado no soportado: " << settings.algorithm << std::endl;
+        return 1;
+    }
+    if (!loadCipherKey(keyPath, settings.key)) {
+        std::cerr << "Error: Clave inválida: " << keyPath << std::endl;
+        return 1;
+    }
+    if (indexPath.empty()) indexPath = directories.front() + "/cipher.idx";
+    if (!outputDir.empty() && !createDirectoryIfNotExists(outputDir)) {
+        return 1;
+    }
+
+    std::ifstream index(indexPath);
+    if (!index) {
+        std::cerr << "Error: No se pudo abrir el índice " << indexPath << std::endl;
+        return 1;
+    }
+
+    auto cipher = std::make_unique<FrameCipher>(settings);
+    const std::string keyId = cipherKeyId(settings.key);
+    size_t verified = 0, failed = 0, missing = 0, bytes = 0;
+    double cipherSeconds = 0.0;
+    std::vector<unsigned char> buffer;
+    std::string line;
+    bool hasRun = false;
+    uint32_t runSalt = 0;
+
+    while (std::getline(index, line)) {
+        std::istringstream fields(line);
+        std::string name, nonceHex;
+        size_t size = 0;
+        CipherNonce nonce{};
+
+        // Cabecera de una ejecución: sal, clave y algoritmo de los fotogramas que siguen
+        if (line.compare(0, 4, "run ") == 0) {
+            std::string tag, saltHex, runKeyId, algorithm;
+            fields >> tag >> saltHex >> runKeyId >> algorithm;
+            const bool hex = std::all_of(saltHex.begin(), saltHex.end(),
+                                         [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; });
+            if (saltHex.size() != 8 || !hex || !FrameCipher::isValidAlgorithm(algorithm)) {
+                std::cerr << "Cabecera de índice inválida: " << line << std::endl;
+                failed++;
+                continue;
+            }
+            hasRun = true;
+            runSalt = static_cast<uint32_t>(std::stoul(saltHex, nullptr, 16));
+            if (runKeyId != keyId) {
+                std::cerr << "Aviso: la ejecución con sal " << saltHex << " se grabó con otra clave ("
+                          << runKeyId << ", la indicada es " << keyId << ")" << std::endl;
+            }
+            if (algorithm != settings.algorithm) {
+                settings.algorithm = algorithm;
+                cipher = std::make_unique<FrameCipher>(settings);
+            }
+            continue;
+        }
+
+        if (!(fields >> name >> nonceHex >> size) || !nonceFromHex(nonceHex, nonce)) {
+            std::cerr << "Línea de índice inválida: " << line << std::endl;
+            failed++;
+            continue;
+        }
+        // El nonce debe empezar por la sal de su ejecución
+        if (hasRun && !std::equal(nonce.begin(), nonce.begin() + 4, makeCipherNonce(runSalt, 0).begin())) {
+            std::cerr << "Nonce fuera de la sal de su ejecución: " << name << std::endl;
+            failed++;
+            continue;
+        }
+
+        // El nombre viene del índice: no se admite nada que salga de los directorios indicados
+        if (!isPlainFileName(name)) {
+            std::cerr << "Nombre no válido en el índice: " << name << std::endl;
+            failed++;
+            continue;
+        }
+        std::ifstream in;
+        for (const auto& directory : directories) {
+            in.open(directory + "/" + name, std::ios::binary);
+            if (in) break;
+            in.clear();
+        }
+        if (!in.is_open()) {
+            std::cerr << "Ausente: " << name << std::endl;
+            missing++;
+            continue;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = buffer.size() == size && cipher->decrypt(buffer, nonce, name);
+        cipherSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!ok) {
+            std::cerr << "Verificación fallida: " << name << std::endl;
+            failed++;
+            continue;
+        }
+        verified++;
+        bytes += buffer.size();
+
+        if (!outputDir.empty()) {
+            std::string plainName = name;
+            if (plainName.size() > 4 && plainName.compare(plainName.size() - 4, 4, ".enc") == 0) {
+                plainName.resize(plainName.size() - 4);
+            }
+            std::ofstream out(outputDir + "/" + plainName, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        }
+    }
+
+    std::cout << "Verificados: " << verified << ", fallidos: " << failed << ", ausentes: " << missing << std::endl;
+    std::cout << "Descifrado: " << formatByteSize(bytes) << " a "
+              << formatByteSize(static_cast<size_t>(cipherSeconds > 0 ? bytes / cipherSeconds : 0.0)) << "/s ("
+              << FrameCipher::acceleration(settings.algorithm) << ")" << std::endl;
+    // Un fotograma del índice que no está en el directorio tampoco se ha verificado
+    return failed > 0 || missing > 0 ? 2 : 0;
+}
@@ -0,0 +1,559 @@
+/**
+ * @file jpegtune.cpp
+ * @brief Herramienta que barre las opciones del codificador JPEG y muestra el frente de Pareto.
+ *
+ * Toma una muestra de fotogramas de un origen (ruido o banco, en el formato de píxel
+ * elegido) y la comprime con cada combinación de calidad, submuestreo, DCT,
+ * codificación secuencial o progresiva y, en la secuencial, tablas Huffman estándar,
+ * optimizadas por fotograma o en caché (estas dos si se compiló con libjpeg). De cada una mide los milisegundos y los bytes
+ * por fotograma y, descomprimiendo, el PSNR y el SSIM frente a la entrada del
+ * codificador. Muestra las combinaciones que ninguna otra mejora en las cuatro medidas
+ * a la vez (el frente de Pareto), con las opciones de fastcap que las reproducen. Con
+ * TurboJPEG 3 compara además la velocidad de los JPEG de 12 bits y sin pérdida con la
+ * del camino de 8 bits.
+ * Compilar en Release para que los tiempos sean representativos.
+ */
+
+#include "Encoder.h"
+#include "FrameSource.h"
+#include "LibjpegEncoder.h"
+#include "PixelKernels.h"
+#include "TurboJPEGWriter.h"
+
+#include <turbojpeg.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Muestra el uso de la herramienta.
+ */
+void showJpegTuneUsage(const std::string& programName) {
+    std::cout << "Uso: " << programName << " [-width N -height N] [-pixel P] [-bank N] [-frames N] [-rounds N]"
+              << " [-quality L] [-all] [-csv F]" << std::endl;
+    std::cout << "Opciones:" << std::endl;
+    std::cout << "  -width N    Ancho de los fotogramas (por defecto: 1920)" << std::endl;
+    std::cout << "  -height N   Alto de los fotogramas (por defecto: 1080)" << std::endl;
+    std::cout << "  -pixel P    Formato de píxel: bgr, bgra, gray o gray16 (por defecto: bgr)" << std::endl;
+    std::cout << "  -bank N     Toma la muestra de un banco de N fotogramas en lugar de ruido nuevo" << std::endl;
+    std::cout << "  -frames N   Fotogramas de la muestra (por defecto: 4)" << std::endl;
+    std::cout << "  -rounds N   Pasadas cronometradas por la muestra; se toma la más rápida (por defecto: 2)" << std::endl;
+    std::cout << "  -quality L  Calidades a probar, separadas por comas (por defecto: 50,60,70,75,80,85,90,95)" << std::endl;
+    std::cout << "  -all        Muestra todas las combinaciones, no solo el frente de Pareto" << std::endl;
+    std::cout << "  -csv F      Escribe todas las combinaciones en un CSV" << std::endl;
+}
+
+/// Una combinación de opciones y sus medidas sobre la muestra.
+struct Candidate {
+    int quality = 90;
+    JpegOptions options;
+    double msPerFrame = 0.0;
+    double bytesPerFrame = 0.0;
+    double psnr = 0.0;       ///< dB sobre los canales de color (infinito si no hay pérdida).
+    double ssim = 0.0;       ///< SSIM medio de la luminancia.
+    bool pareto = false;
+};
+
+/// Fotograma de la muestra y su entrada de 8 bits al codificador (referencia de calidad).
+struct SampleFrame {
+    Frame frame;
+    Frame scratch;
+    const Frame* reference = nullptr;
+};
+
+const char* subsamplingName(int subsampling) {
+    switch (subsampling) {
+        case TJSAMP_444: return "4:4:4";
+        case TJSAMP_422: return "4:2:2";
+        case TJSAMP_420: return "4:2:0";
+        case TJSAMP_GRAY:
+        default: return "gris";
+    }
+}
+
+/**
+ * @brief Tablas Huffman de una combinación (las del JPEG progresivo siempre se optimizan).
+ */
+const char* huffmanName(const JpegOptions& options) {
+    if (options.progressive || options.huffman == JpegHuffman::PerFrame) return "por fotograma";
+    return options.huffman == JpegHuffman::Cached ? "en caché" : "estándar";
+}
+
+/**
+ * @brief Rellena con espacios hasta `width` caracteres (no bytes: los textos llevan tildes).
+ */
+std::string padRight(const std::string& text, size_t width) {
+    size_t characters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) characters++;
+    }
+    return characters < width ? text + std::string(width - characters, ' ') : text;
+}
+
+/**
+ * @brief Opciones de fastcap que reproducen una combinación.
+ */
+std::string presetArguments(const Candidate& candidate) {
+    std::string text = "-quality " + std::to_string(candidate.quality);
+    const std::string options = describeJpegOptions(candidate.options);
+    if (!options.empty()) text += " -jpegopts " + options;
+    return text;
+}
+
+bool parseQualityList(const std::string& text, std::vector<int>& qualities) {
+    qualities.clear();
+    std::istringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        int quality = 0;
+        try { quality = std::stoi(item); } catch (const std::exception&) {}
+        if (quality <= 0 || quality > 100) return false;
+        qualities.push_back(quality);
+    }
+    return !qualities.empty();
+}
+
+/**
+ * @brief Luminancia de 8 bits de una imagen BGR, BGRX o gris (BT.601 en punto fijo).
+ */
+void extractLuma(const Frame& image, std::vector<uint8_t>& luma) {
+    const int channels = pixelChannels(image.format());
+    luma.resize(static_cast<size_t>(image.width()) * image.height());
+    for (int y = 0; y < image.height(); y++) {
+        const uint8_t* row = image.row(y);
+        uint8_t* out = luma.data() + static_cast<size_t>(y) * image.width();
+        for (int x = 0; x < image.width(); x++) {
+            const uint8_t* pixel = row + x * channels;
+            out[x] = channels == 1 ? pixel[0]
+                : static_cast<uint8_t>((29 * pixel[0] + 150 * pixel[1] + 77 * pixel[2] + 128) >> 8);
+        }
+    }
+}
+
+/**
+ * @brief SSIM medio de dos planos de luminancia en ventanas de 8x8 sin solapar.
+ */
+double meanSsim(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int width, int height) {
+    constexpr double c1 = (0.01 * 255) * (0.01 * 255);
+    constexpr double c2 = (0.03 * 255) * (0.03 * 255);
+    constexpr int window = 8;
+    double total = 0.0;
+    size_t windows = 0;
+    for (int y0 = 0; y0 + window <= height; y0 += window) {
+        for (int x0 = 0; x0 + window <= width; x0 += window) {
+            double sumA = 0, sumB = 0, sumAA = 0, sumBB = 0, sumAB = 0;
+            for (int y = y0; y < y0 + window; y++) {
+                const size_t offset = static_cast<size_t>(y) * width;
+                for (int x = x0; x < x0 + window; x++) {
+                    const double va = a[offset + x], vb = b[offset + x];
+                    sumA += va; sumB += vb;
+                    sumAA += va * va; sumBB += vb * vb; sumAB += va * vb;
+                }
+            }
+            const double n = window * window;
+            const double meanA = sumA / n, meanB = sumB / n;
+            const double varA = sumAA / n - meanA * meanA;
+            const double varB = sumBB / n - meanB * meanB;
+            const double cov = sumAB / n - meanA * meanB;
+            total += ((2 * meanA * meanB + c1) * (2 * cov + c2))
+                   / ((meanA * meanA + meanB * meanB + c1) * (varA + varB + c2));
+            windows++;
+        }
+    }
+    return windows > 0 ? total / windows : 1.0;
+}
+
+/**
+ * @brief Suma del error cuadrático de los canales de color (sin el cuarto canal de BGRX).
+ * @param samples Muestras comparadas (salida).
+ */
+double squaredError(const Frame& a, const Frame& b, size_t& samples) {
+    const int channels = pixelChannels(a.format());
+    const int compared = std::min(channels, 3);
+    double total = 0.0;
+    for (int y = 0; y < a.height(); y++) {
+        const uint8_t* rowA = a.row(y);
+        const uint8_t* rowB = b.row(y);
+        for (int x = 0; x < a.width(); x++) {
+            for (int c = 0; c < compared; c++) {
+                const double diff = static_cast<double>(rowA[x * channels + c]) - rowB[x * channels + c];
+                total += diff * diff;
+            }
+        }
+    }
+    samples += static_cast<size_t>(a.width()) * a.height() * compared;
+    return total;
+}
+
+/**
+ * @brief Milisegundos por fotograma de la más rápida de `rounds` pasadas por la muestra.
+ * @param bytes Bytes comprimidos de la última pasada (salida).
+ * @return false si falló la compresión.
+ */
+bool timePasses(Encoder& encoder, std::vector<SampleFrame>& sample, int rounds, double& msPerFrame, size_t& bytes) {
+    std::vector<unsigned char> out;
+    double best = std::numeric_limits<double>::infinity();
+    for (int round = 0; round < rounds; round++) {
+        bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (SampleFrame& item : sample) {
+            if (!encoder.encode(item.frame, out)) return false;
+            bytes += out.size();
+        }
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    msPerFrame = best * 1000.0 / sample.size();
+    return true;
+}
+
+/**
+ * @brief Compara los JPEG de 12 bits y sin pérdida (TurboJPEG 3) con el camino de 8 bits con pérdida.
+ * @param current Medidas de la configuración actual (8 bits, calidad 90).
+ * @return false si falló alguna variante.
+ */
+bool comparePrecisions(std::vector<SampleFrame>& sample, const PixelKernels& kernels, int rounds,
+                       const Candidate& current) {
+    std::vector<std::pair<const char*, JpegOptions>> variants;
+    JpegOptions options;
+    if (kernels.format == PixelFormat::Gray16) {
+        options.precision = 12;
+        variants.emplace_back("12 bits con pérdida", options);
+        options.lossless = true;
+        variants.emplace_back("sin pérdida, 12 bits", options);
+        options.precision = 16;
+        variants.emplace_back("sin pérdida, 16 bits", options);
+    }
+    options = JpegOptions();
+    options.lossless = true;
+    variants.emplace_back("sin pérdida, 8 bits", options);
+
+    const Frame& first = sample.front().frame;
+    const double sourceMB = static_cast<double>(first.rowSize()) * first.height() / (1024.0 * 1024.0);
+    auto printVariant = [&](const char* name, const std::string& arguments, double ms, double bytes) {
+        std::cout << "  " << padRight(name, 24) << std::right << std::fixed
+                  << std::setw(9) << std::setprecision(2) << ms
+                  << std::setw(10) << std::setprecision(1) << sourceMB * 1000.0 / ms
+                  << std::setw(11) << std::setprecision(1) << bytes / 1024.0
+                  << std::setw(9) << std::setprecision(2) << current.msPerFrame / ms << "x"
+                  << "  " << arguments << std::endl;
+    };
+    std::cout << "TurboJPEG 3 frente al camino de 8 bits con pérdida (calidad 90):" << std::endl;
+    std::cout << "  " << padRight("variante", 24) << std::right << std::setw(9) << "ms/fot" << std::setw(10) << "MB/s"
+              << std::setw(11) << "KB/fot" << std::setw(11) << "velocidad" << "  opciones" << std::endl;
+    printVariant("8 bits con pérdida", presetArguments(current), current.msPerFrame, current.bytesPerFrame);
+    for (const auto& variant : variants) {
+        EncoderSettings settings;
+        settings.format = "jpg";
+        settings.jpeg = variant.second;
+        settings.pixelFormat = kernels.format;
+        settings.width = first.width();
+        settings.height = first.height();
+        std::unique_ptr<Encoder> encoder = createEncoder(settings);
+        double ms = 0.0;
+        size_t bytes = 0;
+        if (!encoder || !timePasses(*encoder, sample, rounds + 1, ms, bytes)) return false;
+        printVariant(variant.first, "-jpegopts " + describeJpegOptions(variant.second), ms,
+                     static_cast<double>(bytes) / sample.size());
+    }
+    return true;
+}
+
+/**
+ * @brief Mide una combinación: una pasada de calidad y `rounds` pasadas cronometradas.
+ * @return false si falló la compresión o la descompresión.
+ */
+bool evaluate(Candidate& candidate, std::vector<SampleFrame>& sample, const PixelKernels& kernels,
+              int rounds, tjhandle decompressor) {
+    // Mismo codificador que elegiría fastcap con -quality y -jpegopts
+    EncoderSettings settings;
+    settings.format = "jpg";
+    settings.quality = candidate.quality;
+    settings.jpeg = candidate.options;
+    settings.pixelFormat = kernels.format;
+    settings.width = sample.front().frame.width();
+    settings.height = sample.front().frame.height();
+    std::unique_ptr<Encoder> encoder = createEncoder(settings);
+    if (!encoder) return false;
+    std::vector<unsigned char> out;
+    std::vector<uint8_t> lumaReference, lumaDecoded;
+    Frame decoded;
+    double errorSum = 0.0, ssimSum = 0.0;
+    size_t errorSamples = 0, bytes = 0;
+
+    // Pasada de calidad (también calienta el codificador): tamaño, PSNR y SSIM
+    for (SampleFrame& item : sample) {
+        if (!encoder->encode(item.frame, out)) return false;
+        bytes += out.size();
+        const Frame& reference = *item.reference;
+        decoded.create(reference.width(), reference.height(), reference.format());
+        if (tjDecompress2(decompressor, out.data(), out.size(), decoded.data(), decoded.width(),
+                          static_cast<int>(decoded.stride()), decoded.height(), kernels.tjPixelFormat, 0) != 0) {
+            std::cerr << "Error al descomprimir: " << tjGetErrorStr() << std::endl;
+            return false;
+        }
+        errorSum += squaredError(reference, decoded, errorSamples);
+        extractLuma(reference, lumaReference);
+        extractLuma(decoded, lumaDecoded);
+        ssimSum += meanSsim(lumaReference, lumaDecoded, reference.width(), reference.height());
+    }
+    const double mse = errorSum / std::max<size_t>(errorSamples, 1);
+    candidate.psnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : std::numeric_limits<double>::infinity();
+    candidate.ssim = ssimSum / sample.size();
+    candidate.bytesPerFrame = static_cast<double>(bytes) / sample.size();
+
+    return timePasses(*encoder, sample, rounds, candidate.msPerFrame, bytes);
+}
+
+/**
+ * @brief Indica si `a` es al menos igual de buena que `b` en todo y mejor en algo.
+ */
+bool dominates(const Candidate& a, const Candidate& b) {
+    const bool noWorse = a.msPerFrame <= b.msPerFrame && a.bytesPerFrame <= b.bytesPerFrame
+                      && a.psnr >= b.psnr && a.ssim >= b.ssim;
+    const bool better = a.msPerFrame < b.msPerFrame || a.bytesPerFrame < b.bytesPerFrame
+                     || a.psnr > b.psnr || a.ssim > b.ssim;
+    return noWorse && better;
+}
+
+void printRow(const Candidate& candidate, double rawBytes) {
+    std::cout << "  " << (candidate.pareto ? "* " : "  ")
+              << std::right << std::setw(7) << candidate.quality << "  "
+              << padRight(subsamplingName(candidate.options.subsampling), 12)
+              << padRight(candidate.options.accurateDct ? "exacta" : "rápida", 9)
+              << padRight(candidate.options.progressive ? "progresiva" : "secuencial", 13)
+              << padRight(huffmanName(candidate.options), 15)
+              << std::fixed
+              << std::setw(9) << std::setprecision(2) << candidate.msPerFrame
+              << std::setw(11) << std::setprecision(1) << candidate.bytesPerFrame / 1024.0
+              << std::setw(8) << std::setprecision(1) << rawBytes / candidate.bytesPerFrame
+              << std::setw(9) << std::setprecision(2) << candidate.psnr
+              << std::setw(8) << std::setprecision(4) << candidate.ssim
+              << "  " << presetArguments(candidate) << std::endl;
+}
+
+bool writeCsv(const std::string& path, const std::vector<Candidate>& candidates) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: No se pudo crear " << path << std::endl;
+        return false;
+    }
+    out << "calidad,submuestreo,dct,codificacion,huffman,ms_por_fotograma,bytes_por_fotograma,psnr_db,ssim,pareto\n";
+    for (const Candidate& candidate : candidates) {
+        out << candidate.quality << ',' << subsamplingName(candidate.options.subsampling) << ','
+            << (candidate.options.accurateDct ? "accurate" : "fast") << ','
+            << (candidate.options.progressive ? "progressive" : "baseline") << ','
+            << (candidate.options.progressive || candidate.options.huffman == JpegHuffman::PerFrame ? "optimize"
+                : candidate.options.huffman == JpegHuffman::Cached ? "cached" : "standard") << ','
+            << std::fixed << std::setprecision(3) << candidate.msPerFrame << ','
+            << std::setprecision(0) << candidate.bytesPerFrame << ','
+            << std::setprecision(3) << candidate.psnr << ','
+            << std::setprecision(5) << candidate.ssim << ','
+            << (candidate.pareto ? 1 : 0) << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+/**
+ * @brief Función principal del autoajuste JPEG.
+ */
+int main(int argc, char** argv) {
+    int width = 1920, height = 1080;
+    PixelFormat pixelFormat = PixelFormat::Bgr8;
+    size_t bankSize = 0;
+    int frames = 4;
+    int rounds = 2;
+    std::vector<int> qualities = {50, 60, 70, 75, 80, 85, 90, 95};
+    bool showAll = false;
+    std::string csvPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            showJpegTuneUsage(argv[0]);
+            return 0;
+        } else if (arg == "-width" && i + 1 < argc) {
+            width = std::stoi(argv[++i]);
+        } else if (arg == "-height" && i + 1 < argc) {
+            height = std::stoi(argv[++i]);
+        } else if (arg == "-pixel" && i + 1 < argc) {
+            if (!parsePixelFormat(argv[++i], pixelFormat)) {
+                std::cerr << "Error: Formato de píxel debe ser 'bgr', 'bgra', 'gray' o 'gray16'" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-bank" && i + 1 < argc) {
+            bankSize = std::stoul(argv[++i]);
+        } else if (arg == "-frames" && i + 1 < argc) {
+            frames = std::stoi(argv[++i]);
+        } else if (arg == "-rounds" && i + 1 < argc) {
+            rounds = std::stoi(argv[++i]);
+        } else if (arg == "-quality" && i + 1 < argc) {
+            if (!parseQualityList(argv[++i], qualities)) {
+                std::cerr << "Error: Calidades inválidas: " << argv[i] << " (entre 1 y 100, separadas por comas)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-all") {
+            showAll = true;
+        } else if (arg == "-csv" && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else {
+            std::cerr << "Argumento desconocido: " << arg << std::endl;
+            showJpegTuneUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (width <= 0 || height <= 0 || frames <= 0 || rounds <= 0) {
+        std::cerr << "Error: Indique -width y -height positivos, -frames > 0 y -rounds > 0" << std::endl;
+        return 1;
+    }
+
+    const PixelKernels* kernels = selectPixelKernels(pixelFormat, width, height);
+    std::unique_ptr<FrameSource> source = createFrameSource(width, height, bankSize, pixelFormat);
+    tjhandle decompressor = tjInitDecompress();
+    if (!kernels || !source || !decompressor) {
+        std::cerr << "Error: No se pudo preparar el origen o TurboJPEG" << std::endl;
+        return 1;
+    }
+    // Con banco, esperar a que esté completo para que la muestra no repita fotogramas
+    while (!source->ready()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<SampleFrame> sample(frames);
+    for (SampleFrame& item : sample) {
+        item.frame = source->next();
+        item.reference = &kernels->encoderInput(item.frame, item.scratch);
+    }
+
+    // Combinaciones: la configuración actual (calidad 90, 4:2:0, DCT rápida, secuencial) siempre se mide
+    const bool gray = kernels->tjSubsampling == TJSAMP_GRAY;
+    std::vector<int> subsamplings = gray ? std::vector<int>{TJSAMP_GRAY}
+                                         : std::vector<int>{TJSAMP_444, TJSAMP_422, TJSAMP_420, TJSAMP_GRAY};
+    // Codificaciones: progresiva y secuencial con cada modo de tablas Huffman disponible
+    std::vector<JpegOptions> codings(1);
+    codings[0].progressive = true;
+    std::vector<JpegHuffman> huffmanModes = {JpegHuffman::Standard};
+    if (LibjpegEncoder::available()) {
+        huffmanModes.push_back(JpegHuffman::PerFrame);
+        huffmanModes.push_back(JpegHuffman::Cached);
+    }
+    for (JpegHuffman mode : huffmanModes) {
+        JpegOptions coding;
+        coding.huffman = mode;
+        codings.push_back(coding);
+    }
+    std::vector<Candidate> candidates;
+    for (int quality : qualities) {
+        for (int subsampling : subsamplings) {
+            for (bool accurate : {false, true}) {
+                for (const JpegOptions& coding : codings) {
+                    Candidate candidate;
+                    candidate.quality = quality;
+                    candidate.options = coding;
+                    candidate.options.subsampling = subsampling;
+                    candidate.options.accurateDct = accurate;
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+    }
+    auto isCurrent = [&](const Candidate& candidate) {
+        return candidate.quality == 90 && candidate.options.subsampling == kernels->tjSubsampling
+            && !candidate.options.accurateDct && !candidate.options.progressive
+            && candidate.options.huffman == JpegHuffman::Standard;
+    };
+    if (std::none_of(candidates.begin(), candidates.end(), isCurrent)) {
+        Candidate current;
+        current.options.subsampling = kernels->tjSubsampling;
+        candidates.push_back(current);
+    }
+
+    std::cout << "Autoajuste JPEG " << width << "x" << height << " " << pixelFormatName(pixelFormat)
+              << ": " << frames << " fotogramas de " << source->describe() << ", "
+              << candidates.size() << " combinaciones, la más rápida de " << rounds << " pasadas" << std::endl;
+    for (Candidate& candidate : candidates) {
+        if (!evaluate(candidate, sample, *kernels, rounds, decompressor)) {
+            std::cerr << "Error: Falló la combinación " << presetArguments(candidate) << std::endl;
+            tjDestroy(decompressor);
+            return 1;
+        }
+    }
+    tjDestroy(decompressor);
+
+    size_t frontSize = 0;
+    for (Candidate& candidate : candidates) {
+        candidate.pareto = std::none_of(candidates.begin(), candidates.end(),
+                                        [&](const Candidate& other) { return dominates(other, candidate); });
+        if (candidate.pareto) frontSize++;
+    }
+    std::vector<Candidate> sorted = candidates;
+    std::sort(sorted.begin(), sorted.end(), [](const Candidate& a, const Candidate& b) {
+        return a.bytesPerFrame < b.bytesPerFrame;
+    });
+
+    // Ratio frente al fotograma sin comprimir en su formato de origen
+    const double rawBytes = static_cast<double>(sample.front().frame.rowSize()) * height;
+    std::cout << (showAll ? "Todas las combinaciones" : "Frente de Pareto")
+              << " (tiempo, tamaño, PSNR y SSIM; " << frontSize << " de " << candidates.size()
+              << "), de menor a mayor tamaño:" << std::endl;
+    std::cout << "    " << std::right << std::setw(7) << "calidad" << "  " << padRight("submuestreo", 12)
+              << padRight("DCT", 9) << padRight("codificación", 13) << padRight("Huffman", 15)
+              << std::setw(9) << "ms/fot" << std::setw(11) << "KB/fot" << std::setw(8) << "ratio"
+              << std::setw(9) << "PSNR dB" << std::setw(8) << "SSIM" << "  opciones" << std::endl;
+    for (const Candidate& candidate : sorted) {
+        if (showAll || candidate.pareto) printRow(candidate, rawBytes);
+    }
+
+    const Candidate& current = *std::find_if(candidates.begin(), candidates.end(), isCurrent);
+    size_t dominators = 0;
+    for (const Candidate& other : candidates) {
+        if (dominates(other, current)) dominators++;
+    }
+    std::cout << "Configuración actual (" << presetArguments(current) << "): " << std::fixed
+              << std::setprecision(2) << current.msPerFrame << " ms, " << std::setprecision(1)
+              << current.bytesPerFrame / 1024.0 << " KB, " << std::setprecision(2) << current.psnr << " dB, SSIM "
+              << std::setprecision(4) << current.ssim << "; ";
+    if (dominators == 0) {
+        std::cout << "en el frente" << std::endl;
+    } else {
+        std::cout << "la mejoran " << dominators << " combinaciones en todo a la vez" << std::endl;
+    }
+
+    // Tablas Huffman con el resto de la configuración actual
+    if (huffmanModes.size() > 1) {
+        std::cout << "Tablas Huffman (calidad 90, " << subsamplingName(current.options.subsampling)
+                  << ", DCT rápida, secuencial):";
+        const char* separator = " ";
+        for (const Candidate& candidate : candidates) {
+            const JpegOptions& options = candidate.options;
+            if (candidate.quality != 90 || options.subsampling != current.options.subsampling
+                || options.accurateDct || options.progressive) continue;
+            std::cout << separator << huffmanName(options) << " " << std::setprecision(2) << candidate.msPerFrame
+                      << " ms, " << std::setprecision(1) << candidate.bytesPerFrame / 1024.0 << " KB ("
+                      << std::showpos << (candidate.bytesPerFrame / current.bytesPerFrame - 1.0) * 100.0
+                      << std::noshowpos << "%)";
+            separator = "; ";
+        }
+        std::cout << std::endl;
+    }
+
+    if (TurboJPEG3Encoder::available() && !comparePrecisions(sample, *kernels, rounds, current)) {
+        std::cerr << "Error: Falló la comparación de TurboJPEG 3" << std::endl;
+        return 1;
+    }
+
+    if (!csvPath.empty()) {
+        if (!writeCsv(csvPath, candidates)) return 1;
+        std::cout << "CSV: " << candidates.size() << " combinaciones en " << csvPath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file timequery.cpp
+ * @brief Herramienta para localizar o extraer los fotogramas de un intervalo de tiempo.
+ *
+ * Busca en el índice temporal (`time.idx`) de una grabación en segmentos los bloques que
+ * pueden contener el intervalo pedido y recorre solo esos registros. Lista el rango de
+ * bytes de cada fotograma o, con `-extract`, los guarda como archivos.
+ */
+
+#include "Crc32c.h"
+#include "SegmentStorage.h"
+#include "TimeIndex.h"
+#include "Utils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Muestra el uso de la herramienta.
+ */
+void showTimeQueryUsage(const std::string& programName) {
+    std::cout << "Uso: " << programName << " -dir DIR -from T -to T [-extract OUT]" << std::endl;
+    std::cout << "Opciones:" << std::endl;
+    std::cout << "  -dir DIR      Directorio de la grabación (-storage segment)" << std::endl;
+    std::cout << "  -from T       Inicio del intervalo" << std::endl;
+    std::cout << "  -to T         Fin del intervalo (incluido)" << std::endl;
+    std::cout << "  -extract OUT  Guarda los fotogramas en OUT en lugar de listar sus rangos de bytes" << std::endl;
+    std::cout << "Formatos de T: 'AAAA-MM-DD HH:MM:SS[.fff]', 'HH:MM:SS[.fff]' (día del primer" << std::endl;
+    std::cout << "fotograma), o @SEGUNDOS desde la época. Las horas son locales." << std::endl;
+}
+
+/**
+ * @brief Interpreta un instante en hora local.
+ * @param text Texto del instante.
+ * @param referenceNs Instante del que se toma el día si el texto solo tiene la hora.
+ * @param timestampNs Resultado en ns desde la época.
+ */
+bool parseInstant(const std::string& text, int64_t referenceNs, int64_t& timestampNs) {
+    if (!text.empty() && text[0] == '@') {
+        char* end = nullptr;
+        const double seconds = std::strtod(text.c_str() + 1, &end);
+        if (end == text.c_str() + 1 || *end != '\0') return false;
+        timestampNs = static_cast<int64_t>(seconds * 1e9);
+        return true;
+    }
+
+    std::string clock = text;
+    std::tm parts{};
+    const time_t reference = static_cast<time_t>(referenceNs / 1000000000);
+    localtime_r(&reference, &parts);
+    const size_t separator = text.find_first_of(" T");
+    if (separator != std::string::npos) {
+        if (std::sscanf(text.c_str(), "%d-%d-%d", &parts.tm_year, &parts.tm_mon, &parts.tm_mday) != 3) return false;
+        parts.tm_year -= 1900;
+        parts.tm_mon -= 1;
+        clock = text.substr(separator + 1);
+    }
+
+    double seconds = 0.0;
+    if (std::sscanf(clock.c_str(), "%d:%d:%lf", &parts.tm_hour, &parts.tm_min, &seconds) != 3) return false;
+    parts.tm_sec = 0;
+    parts.tm_isdst = -1;
+    const time_t whole = mktime(&parts);
+    if (whole == static_cast<time_t>(-1)) return false;
+    timestampNs = static_cast<int64_t>(whole) * 1000000000 + static_cast<int64_t>(seconds * 1e9);
+    return true;
+}
+
+/**
+ * @brief Instante en hora local con milisegundos.
+ */
+std::string formatInstant(int64_t timestampNs) {
+    const time_t whole = static_cast<time_t>(timestampNs / 1000000000);
+    std::tm parts{};
+    localtime_r(&whole, &parts);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &parts);
+    std::ostringstream oss;
+    oss << text << "." << std::setw(3) << std::setfill('0') << (timestampNs % 1000000000) / 1000000;
+    return oss.str();
+}
+
+std::string segmentFile(const std::string& directory, uint64_t segment) {
+    std::ostringstream oss;
+    oss << directory << "/seg_" << std::setw(8) << std::setfill('0') << segment << ".dat";
+    return oss.str();
+}
+
+/**
+ * @brief Recorre los registros de una región de un segmento y procesa los del intervalo.
+ */
+class RangeScanner {
+public:
+    RangeScanner(const std::string& directory, int64_t from, int64_t to, const std::string& extractDir)
+        : directory(directory), from(from), to(to), extractDir(extractDir) {}
+
+    /**
+     * @brief Procesa los registros de [offset, end) del segmento (end = 0: hasta el final).
+     * @return false si el segmento no existe.
+     */
+    bool scan(uint64_t segment, uint64_t offset, uint64_t end) {
+        const std::string path = segmentFile(directory, segment);
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        if (end == 0) {
+            struct stat status;
+            end = fstat(fd, &status) == 0 ? static_cast<uint64_t>(status.st_size) : 0;
+        }
+
+        SegmentRecordHeader header;
+        std::vector<char> name;
+        while (offset + sizeof(header) <= end) {
+            if (pread(fd, &header, sizeof(header), static_cast<off_t>(offset)) != static_cast<ssize_t>(sizeof(header)) ||
+                header.magic != kSegmentRecordMagic) {
+                break;
+            }
+            const uint64_t recordSize = sizeof(header) + header.nameSize + header.payloadSize;
+            if (offset + recordSize > end) break;
+            scanned++;
+            if (header.timestampNs >= from && header.timestampNs <= to) {
+                name.resize(header.nameSize);
+                if (pread(fd, name.data(), name.size(), static_cast<off_t>(offset + sizeof(header))) !=
+                    static_cast<ssize_t>(name.size())) {
+                    break;
+                }
+                emit(fd, path, header, std::string(name.begin(), name.end()), offset + sizeof(header) + header.nameSize);
+            }
+            offset += recordSize;
+        }
+        close(fd);
+        return true;
+    }
+
+    size_t scanned = 0;   ///< Registros leídos.
+    size_t matched = 0;   ///< Registros dentro del intervalo.
+    size_t failed = 0;    ///< Registros con CRC erróneo o no guardados.
+    uint64_t bytes = 0;   ///< Bytes de contenido de los registros del intervalo.
+
+private:
+    void emit(int fd, const std::string& path, const SegmentRecordHeader& header, const std::string& name,
+              uint64_t payloadOffset) {
+        matched++;
+        bytes += header.payloadSize;
+        if (extractDir.empty()) {
+            std::cout << formatInstant(header.timestampNs) << " " << header.sequence << " " << name << " "
+                      << path << " " << payloadOffset << " " << header.payloadSize << std::endl;
+            return;
+        }
+        std::vector<char> payload(header.payloadSize);
+        if (pread(fd, payload.data(), payload.size(), static_cast<off_t>(payloadOffset)) !=
+                static_cast<ssize_t>(payload.size()) ||
+            crc32c(payload.data(), payload.size()) != header.payloadCrc) {
+            std::cerr << "Registro dañado: " << name << std::endl;
+            failed++;
+            return;
+        }
+        // El nombre viene del segmento: no se admite nada que salga del directorio de destino
+        if (!isPlainFileName(name)) {
+            std::cerr << "Nombre de registro no válido, no se extrae: " << name << std::endl;
+            failed++;
+            return;
+        }
+        std::ofstream out(extractDir + "/" + name, std::ios::binary);
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!out) {
+            std::cerr << "Error al escribir " << extractDir << "/" << name << std::endl;
+            failed++;
+        }
+    }
+
+    std::string directory;
+    int64_t from;
+    int64_t to;
+    std::string extractDir;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory;
+    std::string fromText;
+    std::string toText;
+    std::string extractDir;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            showTimeQueryUsage(argv[0]);
+            return 0;
+        } else if (arg == "-dir" && i + 1 < argc) {
+            directory = argv[++i];
+        } else if (arg == "-from" && i + 1 < argc) {
+            fromText = argv[++i];
+        } else if (arg == "-to" && i + 1 < argc) {
+            toText = argv[++i];
+        } else if (arg == "-extract" && i + 1 < argc) {
+            extractDir = argv[++i];
+        } else {
+            std::cerr << "Argumento desconocido: " << arg << std::endl;
+            showTimeQueryUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (directory.empty() || fromText.empty() || toText.empty()) {
+        showTimeQueryUsage(argv[0]);
+        return 1;
+    }
+
+    TimeIndexReader index;
+    if (!index.open(directory + "/time.idx")) {
+        std::cerr << "Error: No hay un índice temporal válido en " << directory << std::endl;
+        return 1;
+    }
+    const int64_t reference = index.size() > 0 ? index[0].minTs : 0;
+    int64_t from = 0, to = 0;
+    if (!parseInstant(fromText, reference, from) || !parseInstant(toText, reference, to) || to < from) {
+        std::cerr << "Error: Intervalo inválido: " << fromText << " - " << toText << std::endl;
+        return 1;
+    }
+    if (!extractDir.empty() && !createDirectoryIfNotExists(extractDir)) {
+        return 1;
+    }
+
+    // Bloques candidatos: desde la primera entrada que alcanza `from` hasta que los
+    // bloques empiezan después de `to` más el desorden admitido
+    const auto lookupStart = std::chrono::steady_clock::now();
+    const size_t first = index.lowerBound(from);
+    std::vector<TimeIndexEntry> blocks;
+    size_t next = first;
+    for (; next < index.size(); next++) {
+        const TimeIndexEntry& entry = index[next];
+        if (entry.minTs > to + index.slackNs()) break;
+        if (entry.maxTs >= from && entry.minTs <= to) blocks.push_back(entry);
+    }
+    const double lookupUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - lookupStart).count();
+
+    RangeScanner scanner(directory, from, to, extractDir);
+    for (const auto& block : blocks) {
+        scanner.scan(block.segment, block.offset, block.offset + block.length);
+    }
+
+    // Registros posteriores a la última entrada (bloque abierto o grabación en curso)
+    if (next == index.size()) {
+        uint64_t segment = 0, offset = 0;
+        if (index.size() > 0) {
+            segment = index[index.size() - 1].segment;
+            offset = index[index.size() - 1].offset + index[index.size() - 1].length;
+        }
+        while (scanner.scan(segment, offset, 0)) {
+            segment++;
+            offset = 0;
+        }
+    }
+
+    std::cerr << std::fixed << std::setprecision(1)
+              << "Intervalo " << formatInstant(from) << " - " << formatInstant(to) << ": "
+              << scanner.matched << " fotogramas (" << formatByteSize(scanner.bytes) << "), "
+              << blocks.size() << " bloques de " << index.size() << " entradas, "
+              << scanner.scanned << " registros leídos, búsqueda en " << lookupUs << " µs" << std::endl;
+    return scanner.failed > 0 ? 1 : 0;
+}